@@ -30,6 +30,17 @@
 // HTTP Server — single server on port 80 for both REST API and camera control
 WebServerType httpServer(Config::HTTP_PORT);
 
+// Boot phase timing — each call prints the time since the previous one
+static uint32_t bootPhaseStartMs = 0;
+
+static void bootPhase(const __FlashStringHelper* name) {
+    uint32_t now = millis();
+    Utils::printSerial(F("[BOOT] "), "");
+    Utils::printSerial(name, ": ");
+    Utils::printSerial((unsigned long)(now - bootPhaseStartMs), " ms\n");
+    bootPhaseStartMs = now;
+}
+
 /**
  * @brief Initialize all system components
  */
@@ -47,6 +58,8 @@ void setup() {
     Utils::printSerial(F("ESPUtils - Starting System Initialization"));
     Utils::printSerial(F("========================================\n"));
     
+    bootPhaseStartMs = millis();
+
     // Initialize LED indicator
     Utils::printSerial(F("## Set Board Indicator."));
     Utils::initLED();
@@ -55,24 +68,33 @@ void setup() {
     if (!StorageManager::begin()) {
         Utils::printSerial(F("WARNING: Storage (LittleFS) failed to mount. Config will not persist!"));
     }
+    bootPhase(F("storage"));
     
     // Initialize GPIO manager and apply stored settings
     GPIOManager::begin();
+    bootPhase(F("gpio"));
 
     // Load and apply persisted sleep mode setting
 #if FEATURE_SLEEP_ENABLED
     ESPCommandHandler::initSleep();
+    bootPhase(F("sleep"));
 #endif
 
     // Initialize network
     WirelessNetworkManager::initWireless();
     WirelessNetworkManager::begin();
+    bootPhase(F("wireless"));
     
     // Initialize IR receiver and sender
     IRManager::begin();
+    bootPhase(F("ir"));
     
     // Load auth module
     AuthManager::begin();
+    bootPhase(F("auth"));
+
+    // Every manager has its settings now — free the boot copies
+    StorageManager::endBoot();
     
     // Get device ID for mDNS
     String deviceID = Utils::getDeviceIDString();
@@ -87,6 +109,7 @@ void setup() {
     char portBuffer[6];
     snprintf(portBuffer, sizeof(portBuffer), "%u", Config::HTTP_PORT);
     Utils::printSerial(portBuffer);
+    bootPhase(F("http"));
 
     // Camera routes (only on boards with ESP_CAM_HW_EXIST)
     // Camera hardware is NOT initialised at boot — it will be started on
@@ -99,6 +122,7 @@ void setup() {
     
     // Setup OTA updates
     setupOTA();
+    bootPhase(F("ota"));
     
     Utils::printSerial(F("\n========================================"));
     Utils::printSerial(F("System Initialization Complete"));
@@ -117,6 +141,9 @@ void setup() {
 
     // Initialize mDNS with device ID
     WirelessNetworkManager::initMDNS(deviceID.c_str());
+    bootPhase(F("mdns"));
+
+    Utils::printSerial(F("Boot to HTTP ready (ms since reset): "), (long)millis());
 
     Utils::ledPulse(10, 50, 50);
 }
@@ -129,6 +156,7 @@ void setupOTA() {
     
     ArduinoOTA.onStart([]() {
         Utils::printSerial(F("## Begin OTA Update process."));
+        GPIOManager::flush(); // the device reboots when the update completes
     });
     
     ArduinoOTA.onEnd([]() {
@@ -184,8 +212,17 @@ void loop() {
     // Persist bound JWT to flash if a first-login bind is pending (deferred from HTTP handler)
     SessionManager::tick();
     
-    // Update challenge string (auto-refreshes every 5 minutes)
-    SessionManager::updateChallenge();
+    // Advance an in-flight IR capture session (SSE countdown / decode / timeout)
+    IRManager::tick();
+    
+    // Deferred ECDSA check of the bound JWT (only if its integrity tag failed at boot)
+    AuthManager::tick();
+    
+    // Persist GPIO state once relay changes have settled
+    GPIOManager::tick();
+    
+    // Compact the config record log once enough superseded records pile up
+    StorageManager::tick();
     
     // Handle mDNS (both platforms benefit from periodic updates)
     #ifdef ARDUINO_ARCH_ESP8266
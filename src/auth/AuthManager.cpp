@@ -1,7 +1,12 @@
 #include "AuthManager.h"
 #include "../utils/Utils.h"
 #include "../storage/StorageManager.h"
-#include <ArduinoJson.h>
+#include "Hmac.h"
+#include "JwtClaims.h"
+#include "P256.h"
+#include "../utils/Base64.h"
+#include "../utils/TokenGenerator.h"
+#include <new>
 
 // Cryptographic includes
 #if defined(ARDUINO_ARCH_ESP8266)
@@ -12,149 +17,296 @@
     #include <StackThunk.h>
 #elif defined(ARDUINO_ARCH_ESP32)
     #include "mbedtls/ecdsa.h"
+    #include "mbedtls/ecp.h"
+    #include "mbedtls/bignum.h"
     #include "mbedtls/sha256.h"
-    #include "mbedtls/pk.h"
-    #include "mbedtls/error.h"
 #endif
 
-// Base64 lookup table — accepts both standard (+/) and URL-safe (-_). 0xFF = invalid.
-static const uint8_t kB64Lut[128] = {
-/* 00 */ 255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,
-/* 10 */ 255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,255,
-/* 20 */ 255,255,255,255,255,255,255,255,255,255,255, 62,255, 62,255, 63,  // + - /
-/* 30 */  52, 53, 54, 55, 56, 57, 58, 59, 60, 61,255,255,255,255,255,255,  // 0-9
-/* 40 */ 255,  0,  1,  2,  3,  4,  5,  6,  7,  8,  9, 10, 11, 12, 13, 14,  // A-O
-/* 50 */  15, 16, 17, 18, 19, 20, 21, 22, 23, 24, 25,255,255,255,255, 63,  // P-Z _
-/* 60 */ 255, 26, 27, 28, 29, 30, 31, 32, 33, 34, 35, 36, 37, 38, 39, 40,  // a-o
-/* 70 */  41, 42, 43, 44, 45, 46, 47, 48, 49, 50, 51,255,255,255,255,255,  // p-z
+// ── Verification key table (each key parsed and validated once, when loaded) ──
+// Keys are selected by the JWT header "kid".  Slot 0 holds the compiled-in
+// key (kid "", used by tokens that carry no kid); the others are added at
+// runtime through /api/keys.  PEM/DER decoding, point validation and the
+// comb table of multiples of Q (P256.h) are done when a slot is filled, so a
+// login costs one kid lookup and one signature verify whose u2·Q comes from
+// the table, no matter how many keys exist.
+struct KeySlot {
+    bool     used;
+    uint32_t kidHash;                   // FNV-1a of kid, compared before strcmp
+    char     kid[Config::JWT_KID_LEN];
+    uint8_t  q[65];                     // 0x04 || X || Y (uncompressed point)
+    P256::Table* table;                 // 960 B on the heap; nullptr = generic verify
+#if defined(ARDUINO_ARCH_ESP8266)
+    br_ec_public_key pk;
+#endif
 };
+static KeySlot s_keys[Config::JWT_KEY_SLOTS];
 
-// Standard base64 decode — PEM keys only (skips whitespace, accepts + and /)
-static size_t base64Decode(const char* in, size_t inLen, uint8_t* out, size_t outLen) {
-    uint32_t v = 0; int bits = -8; size_t n = 0;
-    for (size_t i = 0; i < inLen; i++) {
-        uint8_t c = (uint8_t)in[i];
-        if (c == '=') break;
-        if (c <= ' ') continue;
-        if (c >= 128 || kB64Lut[c] == 255) return 0;
-        v = (v << 6) | kB64Lut[c]; bits += 6;
-        if (bits >= 0 && n < outLen) { out[n++] = (v >> bits) & 0xFF; bits -= 8; }
+#if defined(ARDUINO_ARCH_ESP8266)
+// ── StackThunk ECDSA trampoline ──
+// BearSSL ECDSA P-256 verification uses ~3 KB of internal stack for
+// big-number math, overflowing the ESP8266 4 KB cont stack.  The ESP8266
+// core provides StackThunk: a heap-allocated 5.6 KB alternate stack.
+// We use a void(void) trampoline with static args so the thunk macro
+// doesn't need to pass registers through.
+//
+// The P-256-only m15 implementation and the i15 verifier are bound directly
+// rather than through br_ec_get_default() / br_ecdsa_vrfy_raw_get_default():
+// the key is always P-256, the LX106 has no 32×32→64 multiplier (m15/i15 are
+// the fast choice there anyway), and the generic all-curves dispatcher — with
+// its P-384/P-521/Curve25519 code — is no longer linked in.
+static const uint8_t*          s_vrfyHash;
+static const br_ec_public_key* s_vrfyKey;
+static const P256::Table*      s_vrfyTable;  // comb table of s_vrfyKey
+static const uint8_t*          s_vrfySig;
+static uint32_t                s_vrfyResult;
+
+/**
+ * muladd() of br_ec_p256_m15 with the key's comb table: the verifier asks
+ * for A = x·Q + y·G, and m15 would run a generic 2-bit window over Q.  Here
+ * x·Q comes from the table and y·G from m15's own precomputed generator
+ * window; any other point goes to m15 unchanged.
+ */
+static uint32_t p256FixedQMuladd(unsigned char* A, const unsigned char* B, size_t len,
+                                 const unsigned char* x, size_t xlen,
+                                 const unsigned char* y, size_t ylen, int curve) {
+    if (B || !s_vrfyTable || curve != BR_EC_secp256r1 || len != P256::POINT_LEN ||
+        xlen > P256::SCALAR_LEN || memcmp(A, s_vrfyKey->q, P256::POINT_LEN) != 0) {
+        return br_ec_p256_m15.muladd(A, B, len, x, xlen, y, ylen, curve);
     }
-    return n;
+
+    P256::Jacobian r;
+    P256::mulTable(r, *s_vrfyTable, x, xlen);
+    uint8_t g[P256::POINT_LEN];
+    P256::Affine yG;
+    br_ec_p256_m15.mulgen(g, y, ylen, curve);
+    if (P256::decode(yG, g, sizeof(g))) P256::addMixed(r, r, yG);  // y·G = 0 adds nothing
+    return P256::encode(A, r) ? 1 : 0;
 }
 
-// Base64URL decode — lenient (JWT header / payload)
-static size_t b64urlDecodeLenient(const char* in, size_t inLen, uint8_t* out, size_t outLen) {
-    uint32_t v = 0; int bits = -8; size_t n = 0;
-    for (size_t i = 0; i < inLen; i++) {
-        uint8_t c = (uint8_t)in[i];
-        if (c == '=') break;
-        if (c >= 128 || kB64Lut[c] == 255) return 0;
-        v = (v << 6) | kB64Lut[c]; bits += 6;
-        if (bits >= 0 && n < outLen) { out[n++] = (v >> bits) & 0xFF; bits -= 8; }
-    }
-    return n;
+static const br_ec_impl s_ecP256FixedQ = {
+    br_ec_p256_m15.supported_curves,
+    br_ec_p256_m15.generator,
+    br_ec_p256_m15.order,
+    br_ec_p256_m15.xoff,
+    br_ec_p256_m15.mul,
+    br_ec_p256_m15.mulgen,
+    &p256FixedQMuladd,
+};
+
+extern "C" void ecdsa_vrfy_on_heap_stack() {
+    s_vrfyResult = br_ecdsa_i15_vrfy_raw(&s_ecP256FixedQ, s_vrfyHash, 32, s_vrfyKey, s_vrfySig, 64);
+}
+make_stack_thunk(ecdsa_vrfy_on_heap_stack)
+extern "C" void thunk_ecdsa_vrfy_on_heap_stack();
+
+#if FEATURE_JWT_KEY_TABLE_ENABLED
+// Building a key's comb table runs on the same alternate stack (~1 KB of
+// field elements for the batched inversion).
+static P256::Table*   s_buildTable;
+static const uint8_t* s_buildPoint;
+static bool           s_buildResult;
+
+extern "C" void ec_table_on_heap_stack() {
+    s_buildResult = P256::buildTable(*s_buildTable, s_buildPoint, P256::POINT_LEN);
 }
+make_stack_thunk(ec_table_on_heap_stack)
+extern "C" void thunk_ec_table_on_heap_stack();
+#endif
 
-// Base64URL decode — strict (JWT signature only): rejects + / = and enforces canonical trailing bits
-static size_t b64urlDecodeStrict(const char* in, size_t inLen, uint8_t* out, size_t outLen) {
-    for (size_t i = 0; i < inLen; i++) {
-        if (in[i] == '+' || in[i] == '/' || in[i] == '=') return 0;
-    }
-    if (inLen % 4 == 1) return 0;
-    if (inLen > 0) {
-        uint8_t c = (uint8_t)in[inLen - 1];
-        if (c >= 128 || kB64Lut[c] == 255) return 0;
-        uint8_t lv = kB64Lut[c];
-        if (inLen % 4 == 2 && (lv & 0x0F) != 0) return 0;
-        if (inLen % 4 == 3 && (lv & 0x03) != 0) return 0;
-    }
-    uint32_t v = 0; int bits = -8; size_t n = 0;
-    for (size_t i = 0; i < inLen; i++) {
-        uint8_t c = (uint8_t)in[i];
-        if (c >= 128 || kB64Lut[c] == 255) return 0;
-        v = (v << 6) | kB64Lut[c]; bits += 6;
-        if (bits >= 0 && n < outLen) { out[n++] = (v >> bits) & 0xFF; bits -= 8; }
+#elif defined(ARDUINO_ARCH_ESP32)
+// Group loaded once; r and s are read straight from the raw JWT signature —
+// no DER re-encoding, no ASN.1 parse and no mbedtls_pk dispatch per request.
+// The generator's comb table comes precomputed with
+// MBEDTLS_ECP_FIXED_POINT_OPTIM (ESP-IDF default); Q's is the key slot's.
+static mbedtls_ecp_group s_ecGroup;
+
+/**
+ * ECDSA verify with R = u1·G + u2·Q, u2·Q taken from the key's comb table
+ * and added by mbedtls_ecp_muladd() with a scalar of one (no second ladder).
+ */
+static bool ecdsaVerifyTable(const KeySlot& key, const uint8_t* hash, const uint8_t* sig) {
+    mbedtls_mpi r, s, e, w, u1, u2, one, x;
+    mbedtls_mpi* mpis[] = { &r, &s, &e, &w, &u1, &u2, &one, &x };
+    for (mbedtls_mpi* m : mpis) mbedtls_mpi_init(m);
+    mbedtls_ecp_point T, R;
+    mbedtls_ecp_point_init(&T);
+    mbedtls_ecp_point_init(&R);
+
+    const mbedtls_mpi* n = &s_ecGroup.N;
+    uint8_t buf[P256::POINT_LEN];
+    size_t  olen = 0;
+    int ret = mbedtls_mpi_read_binary(&r, sig, 32);
+    if (ret == 0) ret = mbedtls_mpi_read_binary(&s, sig + 32, 32);
+    if (ret == 0 && (mbedtls_mpi_cmp_int(&r, 1) < 0 || mbedtls_mpi_cmp_mpi(&r, n) >= 0 ||
+                     mbedtls_mpi_cmp_int(&s, 1) < 0 || mbedtls_mpi_cmp_mpi(&s, n) >= 0)) {
+        ret = MBEDTLS_ERR_ECP_VERIFY_FAILED;
     }
-    return n;
+
+    // u1 = e/s, u2 = r/s (mod n); a 256-bit hash needs no truncation on P-256
+    if (ret == 0) ret = mbedtls_mpi_read_binary(&e, hash, 32);
+    if (ret == 0) ret = mbedtls_mpi_inv_mod(&w, &s, n);
+    if (ret == 0) ret = mbedtls_mpi_mul_mpi(&u1, &e, &w);
+    if (ret == 0) ret = mbedtls_mpi_mod_mpi(&u1, &u1, n);
+    if (ret == 0) ret = mbedtls_mpi_mul_mpi(&u2, &r, &w);
+    if (ret == 0) ret = mbedtls_mpi_mod_mpi(&u2, &u2, n);
+    if (ret == 0) ret = mbedtls_mpi_write_binary(&u2, buf, P256::SCALAR_LEN);
+    if (ret == 0) {
+        P256::Jacobian u2Q;
+        P256::mulTable(u2Q, *key.table, buf, P256::SCALAR_LEN);
+        ret = P256::encode(buf, u2Q) ? mbedtls_ecp_point_read_binary(&s_ecGroup, &T, buf, sizeof(buf))
+                                     : MBEDTLS_ERR_ECP_VERIFY_FAILED;
+    }
+    if (ret == 0) ret = mbedtls_mpi_lset(&one, 1);
+    if (ret == 0) ret = mbedtls_ecp_muladd(&s_ecGroup, &R, &u1, &s_ecGroup.G, &one, &T);
+
+    // R at infinity encodes as a single zero byte and fails here
+    if (ret == 0) ret = mbedtls_ecp_point_write_binary(&s_ecGroup, &R, MBEDTLS_ECP_PF_UNCOMPRESSED,
+                                                       &olen, buf, sizeof(buf));
+    if (ret == 0 && olen != sizeof(buf)) ret = MBEDTLS_ERR_ECP_VERIFY_FAILED;
+    if (ret == 0) ret = mbedtls_mpi_read_binary(&x, buf + 1, 32);
+    if (ret == 0) ret = mbedtls_mpi_mod_mpi(&x, &x, n);
+    bool ok = ret == 0 && mbedtls_mpi_cmp_mpi(&x, &r) == 0;
+
+    for (mbedtls_mpi* m : mpis) mbedtls_mpi_free(m);
+    mbedtls_ecp_point_free(&T);
+    mbedtls_ecp_point_free(&R);
+    return ok;
 }
 
-#ifdef ARDUINO_ARCH_ESP32
-// Convert raw ECDSA signature (r||s) to ASN.1 DER format for mbedTLS
-static size_t rawToAsn1Der(const uint8_t* rawSig, size_t rawLen, uint8_t* derSig, size_t derMaxLen) {
-    if (rawLen != 64) return 0;
-    if (derMaxLen < 80) return 0;
-
-    const uint8_t* r = rawSig;
-    const uint8_t* s = rawSig + 32;
-
-    auto encodeInteger = [](const uint8_t* value, size_t len, uint8_t* output) -> size_t {
-        size_t start = 0;
-        while (start < len - 1 && value[start] == 0) start++;
-        size_t actualLen = len - start;
-        bool needsPadding = (value[start] & 0x80) != 0;
-        size_t totalLen = actualLen + (needsPadding ? 1 : 0);
-        output[0] = 0x02;
-        output[1] = totalLen;
-        size_t pos = 2;
-        if (needsPadding) output[pos++] = 0x00;
-        memcpy(&output[pos], &value[start], actualLen);
-        return pos + actualLen;
-    };
+static bool ecdsaVerify(const KeySlot& key, const uint8_t* hash, const uint8_t* sig) {
+    if (key.table) return ecdsaVerifyTable(key, hash, sig);
+
+    // Generic path: Q read back from the slot, mbedtls does both ladders
+    mbedtls_ecp_point Q;
+    mbedtls_mpi r, s;
+    mbedtls_ecp_point_init(&Q);
+    mbedtls_mpi_init(&r);
+    mbedtls_mpi_init(&s);
+    int ret = mbedtls_ecp_point_read_binary(&s_ecGroup, &Q, key.q, sizeof(key.q));
+    if (ret == 0) ret = mbedtls_mpi_read_binary(&r, sig, 32);
+    if (ret == 0) ret = mbedtls_mpi_read_binary(&s, sig + 32, 32);
+    if (ret == 0) ret = mbedtls_ecdsa_verify(&s_ecGroup, hash, 32, &Q, &r, &s);
+    mbedtls_ecp_point_free(&Q);
+    mbedtls_mpi_free(&r);
+    mbedtls_mpi_free(&s);
+    return ret == 0;
+}
+#endif
 
-    uint8_t rDer[35], sDer[35];
-    size_t rDerLen = encodeInteger(r, 32, rDer);
-    size_t sDerLen = encodeInteger(s, 32, sDer);
-    size_t seqContentLen = rDerLen + sDerLen;
+static uint32_t kidHash(const char* kid) {
+    uint32_t h = 2166136261u;
+    while (*kid) h = (h ^ (uint8_t)*kid++) * 16777619u;
+    return h;
+}
 
-    if (seqContentLen >= 128) {
-        derSig[0] = 0x30; derSig[1] = 0x81; derSig[2] = seqContentLen;
-        memcpy(&derSig[3], rDer, rDerLen);
-        memcpy(&derSig[3 + rDerLen], sDer, sDerLen);
-        return 3 + seqContentLen;
-    } else {
-        derSig[0] = 0x30; derSig[1] = seqContentLen;
-        memcpy(&derSig[2], rDer, rDerLen);
-        memcpy(&derSig[2 + rDerLen], sDer, sDerLen);
-        return 2 + seqContentLen;
+static KeySlot* findKey(const char* kid) {
+    uint32_t h = kidHash(kid);
+    for (KeySlot& k : s_keys) {
+        if (k.used && k.kidHash == h && strcmp(k.kid, kid) == 0) return &k;
     }
+    return nullptr;
+}
+
+/** @return true if @p q is an uncompressed point on P-256. */
+static bool validPoint(const uint8_t* q) {
+    P256::Affine p;
+    return P256::decode(p, q, P256::POINT_LEN);
+}
+
+#if FEATURE_JWT_KEY_TABLE_ENABLED
+static bool buildKeyTable(P256::Table& table, const uint8_t* q) {
+#if defined(ARDUINO_ARCH_ESP8266)
+    s_buildTable = &table;
+    s_buildPoint = q;
+    thunk_ec_table_on_heap_stack();
+    return s_buildResult;
+#else
+    return P256::buildTable(table, q, P256::POINT_LEN);
+#endif
 }
 #endif
 
-// ── Cached public key (parsed once at begin()) ──
+/** Empty @p slot and give back its comb table. */
+static void releaseKeySlot(KeySlot& slot) {
+    slot.used = false;
+    delete slot.table;
+    slot.table = nullptr;
+}
+
+/**
+ * Build the comb table and backend key for @p slot from a point validPoint()
+ * accepted.  The slot is untouched on failure (the table could not be built).
+ */
+static bool fillKeySlot(KeySlot& slot, const char* kid, const uint8_t* q) {
+#if FEATURE_JWT_KEY_TABLE_ENABLED
+    // A replaced key reuses its table: buildTable() only fails before writing.
+    // Without memory for one the key still verifies, on the generic path.
+    P256::Table* table = slot.table ? slot.table : new (std::nothrow) P256::Table;
+    if (table && !buildKeyTable(*table, q)) {
+        if (table != slot.table) delete table;
+        return false;
+    }
+    if (!table) Utils::printSerial(F("Key table: out of memory, generic verify"));
+    slot.table = table;
+#endif
+
+    memcpy(slot.q, q, sizeof(slot.q));
 #if defined(ARDUINO_ARCH_ESP8266)
-static bool             s_pubKeyReady = false;
-static uint8_t          s_pubKeyQ[65];       // 0x04 || X || Y (65 bytes, uncompressed point)
-static br_ec_public_key s_brPubKey;
+    slot.pk.curve = BR_EC_secp256r1;
+    slot.pk.q     = slot.q;
+    slot.pk.qlen  = sizeof(slot.q);
+#endif
 
-// ── StackThunk ECDSA trampoline ──
-// BearSSL ECDSA P-256 verification uses ~3 KB of internal stack for
-// big-number math, overflowing the ESP8266 4 KB cont stack.  The ESP8266
-// core provides StackThunk: a heap-allocated 5.6 KB alternate stack.
-// We use a void(void) trampoline with static args so the thunk macro
-// doesn't need to pass registers through.
-static const br_ec_impl*      s_vrfyEc;
-static const uint8_t*         s_vrfyHash;
-static const br_ec_public_key* s_vrfyKey;
-static const uint8_t*         s_vrfySig;
-static uint32_t               s_vrfyResult;
+    strncpy(slot.kid, kid, sizeof(slot.kid) - 1);
+    slot.kid[sizeof(slot.kid) - 1] = '\0';
+    slot.kidHash = kidHash(slot.kid);
+    slot.used    = true;
+    return true;
+}
 
-extern "C" void ecdsa_vrfy_on_heap_stack() {
-    br_ecdsa_vrfy vrfy = br_ecdsa_vrfy_raw_get_default();
-    s_vrfyResult = vrfy(s_vrfyEc, s_vrfyHash, 32, s_vrfyKey, s_vrfySig, 64);
+/** Validate @p q and build the backend key for @p slot.  The slot is untouched on failure. */
+static bool loadKeySlot(KeySlot& slot, const char* kid, const uint8_t* q) {
+    return validPoint(q) && fillKeySlot(slot, kid, q);
 }
-make_stack_thunk(ecdsa_vrfy_on_heap_stack)
-extern "C" void thunk_ecdsa_vrfy_on_heap_stack();
 
-#elif defined(ARDUINO_ARCH_ESP32)
-static bool               s_pubKeyReady = false;
-static mbedtls_pk_context s_pkCtx;
-#endif
+/**
+ * Write the runtime-added keys (slots 1..N-1) to flash, leaving out
+ * @p without and appending @p kid / @p q if given, so the new table can be
+ * saved before RAM is changed.
+ */
+static bool persistKeys(const KeySlot* without = nullptr,
+                        const char* kid = nullptr, const uint8_t* q = nullptr) {
+    JwtKeyStoreData data;
+    for (uint8_t i = 1; i < Config::JWT_KEY_SLOTS; i++) {
+        if (!s_keys[i].used || &s_keys[i] == without) continue;
+        JwtKeyEntry& e = data.keys[data.count++];
+        memcpy(e.kid, s_keys[i].kid, sizeof(e.kid));
+        memcpy(e.q, s_keys[i].q, sizeof(e.q));
+    }
+    if (kid) {
+        JwtKeyEntry& e = data.keys[data.count++];
+        memset(e.kid, 0, sizeof(e.kid));
+        strncpy(e.kid, kid, sizeof(e.kid) - 1);
+        memcpy(e.q, q, sizeof(e.q));
+    }
+    return StorageManager::saveJwtKeys(data);
+}
 
 // ── Parsed JWT claims (populated by verifyAndParseJWT, cleared each call) ──
 static char s_parsedSub[64]    = {};
 static char s_parsedFamily[64] = {};
 
+// ── Bound-token integrity tag ──
+// The bound JWT was ECDSA-verified before it was written, so re-verifying it
+// on every boot only proves the flash record was not altered since.  A MAC
+// under a per-device key proves the same for the cost of two SHA-256 blocks;
+// the full check runs only when the tag is missing or does not match.
+static uint8_t s_deviceSecret[Config::DEVICE_SECRET_BYTES];
+static bool    s_deviceSecretReady = false;
+static bool    s_boundVerifyPending = false;  // bound sub restored without ECDSA
+static bool    s_boundSealPending   = false;  // s_verifiedBound awaits its tag write
+static BoundTokenData s_verifiedBound;        // 576 bytes — keep off the cont stack
+
 void AuthManager::begin() {
     Utils::printSerial(F("## Load Auth module..."));
 
@@ -163,19 +315,100 @@ void AuthManager::begin() {
     stack_thunk_add_ref();
 #endif
 
-    // Parse and cache the EC public key once at boot
-    initPublicKey();
+    const uint32_t beginMs = millis();
+
+    // Parse and validate the built-in and stored verification keys once at boot
+    initKeys();
+
+    // Key for the bound-token integrity tag
+    initDeviceSecret();
 
     // Initialize session manager (challenge + clear RAM sessions)
     SessionManager::begin();
 
-    // Load and re-verify the bound JWT from flash (signature only, no challenge)
+    // Restore the bound identity (tag check; ECDSA only if the tag fails)
     loadAndVerifyBoundToken();
+
+    Utils::printSerial(F("Auth module ready in ms: "), (long)(millis() - beginMs));
+}
+
+void AuthManager::tick() {
+    if (s_boundVerifyPending && millis() >= Config::BOUND_VERIFY_DEFER_MS) {
+        ensureBoundVerified();
+    }
+
+    // The tag write is flash I/O: done here rather than in the handler that
+    // happened to trigger the verification.
+    if (s_boundSealPending) {
+        s_boundSealPending = false;
+        if (strcmp(s_verifiedBound.sub, SessionManager::getBoundSub()) == 0) {
+            sealBoundToken(s_verifiedBound);
+            Utils::printSerial(F("\nBound JWT sealed."));
+        }
+    }
+}
+
+void AuthManager::initDeviceSecret() {
+    if (StorageManager::loadDeviceSecret(s_deviceSecret)) {
+        s_deviceSecretReady = true;
+        return;
+    }
+
+    TokenGenerator::fillRandom(s_deviceSecret, sizeof(s_deviceSecret));
+    s_deviceSecretReady = StorageManager::saveDeviceSecret(s_deviceSecret);
+    if (s_deviceSecretReady) {
+        Utils::printSerial(F("Device secret generated."));
+    }
+}
+
+void AuthManager::computeBoundTag(const BoundTokenData& data, uint8_t* out) {
+    // The NUL after sub separates the fields so ("ab","c") != ("a","bc")
+    Hmac::sha256(s_deviceSecret, sizeof(s_deviceSecret),
+                 (const uint8_t*)data.sub, strlen(data.sub) + 1,
+                 (const uint8_t*)data.jwt, strlen(data.jwt),
+                 out);
+}
+
+void AuthManager::sealBoundToken(const BoundTokenData& data) {
+    // A factory reset wipes the config log under a running key — put it back
+    // so the tag written below is still checkable after the next boot.
+    if (!s_deviceSecretReady || !StorageManager::hasDeviceSecret()) {
+        s_deviceSecretReady = StorageManager::saveDeviceSecret(s_deviceSecret);
+        if (!s_deviceSecretReady) return;
+    }
+
+    uint8_t tag[Hmac::SHA256_LEN];
+    computeBoundTag(data, tag);
+    StorageManager::saveBoundTokenTag(tag);
+}
+
+void AuthManager::ensureBoundVerified() {
+    if (!s_boundVerifyPending) return;
+    s_boundVerifyPending = false;
+
+    Utils::printSerial(F("\nRunning deferred bound JWT verification..."));
+
+    BoundTokenData& data = s_verifiedBound;
+    if (!StorageManager::loadBoundToken(data) ||
+        strcmp(data.sub, SessionManager::getBoundSub()) != 0 ||
+        !verifyAndParseJWT(data.jwt, strlen(data.jwt), false)) {
+        Utils::printSerial(F("\nBound JWT signature invalid — dropping persisted identity."));
+        SessionManager::setBoundSub("");
+        return;
+    }
+
+    // May run inside a request handler: leave the flash write to tick()
+    s_boundSealPending = true;
+    Utils::printSerial(F("\nBound JWT verified."));
 }
 
 String AuthManager::authenticateWithJWT(const char* jwt, size_t jwtLen) {
     Utils::printSerial(F("Authenticating with JWT..."));
 
+    // The bound sub decides the outcome below — it must be backed by a
+    // verified JWT before it is compared against.
+    ensureBoundVerified();
+
     // Verify signature + challenge for every login attempt
     if (!verifyAndParseJWT(jwt, jwtLen, true)) {
         Utils::printSerial(F("JWT authentication failed."));
@@ -216,8 +449,8 @@ String AuthManager::authenticateWithJWT(const char* jwt, size_t jwtLen) {
     }
 }
 
-bool AuthManager::validateSession(const String& sessionToken) {
-    return SessionManager::validateSession(sessionToken.c_str());
+bool AuthManager::validateSession(const char* sessionToken, size_t len) {
+    return SessionManager::validateSession(sessionToken, len);
 }
 
 void AuthManager::logout() {
@@ -227,6 +460,8 @@ void AuthManager::logout() {
 bool AuthManager::validateResetJWT(const char* jwt, size_t jwtLen) {
     Utils::printSerial(F("Validating JWT for reset..."));
 
+    ensureBoundVerified();
+
     // First, verify the JWT with challenge check
     if (!verifyAndParseJWT(jwt, jwtLen, true)) {
         Utils::printSerial(F("JWT validation failed for reset."));
@@ -269,64 +504,128 @@ void AuthManager::loadAndVerifyBoundToken() {
         return;
     }
 
-    // Verify signature only (no challenge check — the challenge is not stored)
-    if (!verifyAndParseJWT(data.jwt, strlen(data.jwt), false)) {
-        Utils::printSerial(F("\nBound JWT signature invalid — ignoring persisted identity."));
-        return;
-    }
-
     // Trust the sub that was written at bind time (already validated then)
     SessionManager::setBoundSub(data.sub);
-    Utils::printSerial(F("\nBound identity restored — sub: "), data.sub);
+
+    uint8_t stored[Hmac::SHA256_LEN];
+    uint8_t expected[Hmac::SHA256_LEN];
+    if (s_deviceSecretReady && StorageManager::loadBoundTokenTag(stored)) {
+        computeBoundTag(data, expected);
+        if (Utils::constantTimeEquals(stored, expected, sizeof(expected))) {
+            Utils::printSerial(F("\nBound identity restored (tag OK) — sub: "), data.sub);
+            return;
+        }
+    }
+
+    // No tag yet (first boot after upgrade) or the record changed: keep the
+    // sub provisionally and run the signature check on first use or when idle.
+    s_boundVerifyPending = true;
+    Utils::printSerial(F("\nBound identity restored, signature check deferred — sub: "), data.sub);
 }
 
-void AuthManager::initPublicKey() {
-#if defined(ARDUINO_ARCH_ESP8266)
+void AuthManager::initKeys() {
+#if defined(ARDUINO_ARCH_ESP32)
+    mbedtls_ecp_group_init(&s_ecGroup);
+    if (mbedtls_ecp_group_load(&s_ecGroup, MBEDTLS_ECP_DP_SECP256R1) != 0) {
+        Utils::printSerial(F("PEM: P-256 group load failed"));
+        return;
+    }
+#endif
+
+    // ── Slot 0: compiled-in PEM key ──
     const char* pem      = Config::JWT_PUB_KEY;
     const char* b64Start = strstr(pem, "-----BEGIN PUBLIC KEY-----");
-    if (!b64Start) { Utils::printSerial(F("\nPEM: no begin marker")); return; }
-    b64Start += 26;
-    const char* b64End = strstr(pem, "-----END PUBLIC KEY-----");
-    if (!b64End)  { Utils::printSerial(F("\nPEM: no end marker")); return; }
-
+    const char* b64End   = strstr(pem, "-----END PUBLIC KEY-----");
     uint8_t keyDer[128];
-    size_t  keyLen = base64Decode(b64Start, b64End - b64Start, keyDer, sizeof(keyDer));
-    if (keyLen == 0) { Utils::printSerial(F("\nPEM: decode failed")); return; }
-    Utils::printSerial(F("\nPEM: DER length="), keyLen);
-    Utils::printSerial(F(""));
-
-    for (size_t i = 0; i + 64 < keyLen; i++) {
-        if (keyDer[i] == 0x04 && (keyLen - i - 1) >= 64) {
-            s_pubKeyQ[0] = 0x04;
-            memcpy(s_pubKeyQ + 1, &keyDer[i + 1], 64);
-            s_brPubKey.curve = BR_EC_secp256r1;
-            s_brPubKey.q     = s_pubKeyQ;
-            s_brPubKey.qlen  = 65;
-            s_pubKeyReady    = true;
-            Utils::printSerial(F("PEM: key loaded, qlen="));
-            Utils::printSerial(s_brPubKey.qlen);
-            return;
+    size_t  keyLen = 0;
+    if (!b64Start || !b64End) {
+        Utils::printSerial(F("\nPEM: missing begin/end marker"));
+    } else {
+        b64Start += 26;
+        keyLen = Base64::decode(b64Start, b64End - b64Start, keyDer, sizeof(keyDer));
+        if (keyLen == 0) Utils::printSerial(F("\nPEM: decode failed"));
+    }
+
+    // SubjectPublicKeyInfo for P-256 ends with the 65-byte uncompressed point
+    const uint8_t* point = (keyLen >= 65) ? keyDer + keyLen - 65 : nullptr;
+    if (point && loadKeySlot(s_keys[0], "", point)) {
+        Utils::printSerial(F("Public key loaded."));
+    } else {
+        Utils::printSerial(F("PEM: invalid P-256 public key"));
+    }
+
+    // ── Slots 1..N-1: keys added through /api/keys ──
+    JwtKeyStoreData stored;
+    if (StorageManager::loadJwtKeys(stored)) {
+        for (uint8_t i = 0; i < stored.count; i++) {
+            if (stored.keys[i].kid[0] == '\0' || !loadKeySlot(s_keys[i + 1], stored.keys[i].kid, stored.keys[i].q)) {
+                Utils::printSerial(F("Ignoring invalid stored key: "), stored.keys[i].kid);
+            }
         }
     }
-    Utils::printSerial(F("PEM: EC point not found"));
+}
 
-#elif defined(ARDUINO_ARCH_ESP32)
-    mbedtls_pk_init(&s_pkCtx);
-    int ret = mbedtls_pk_parse_public_key(
-        &s_pkCtx,
-        (const unsigned char*)Config::JWT_PUB_KEY,
-        strlen(Config::JWT_PUB_KEY) + 1
-    );
-    if (ret != 0) {
-        char buf[80];
-        mbedtls_strerror(ret, buf, sizeof(buf));
-        Utils::printSerial(F("PEM parse failed: "));
-        Utils::printSerial(buf);
-        return;
+bool AuthManager::addKey(const char* kid, const uint8_t* point) {
+    size_t kidLen = strnlen(kid, Config::JWT_KID_LEN);
+    if (kidLen == 0 || kidLen >= Config::JWT_KID_LEN) {
+        Utils::printSerial(F("Key add: kid must be 1..15 chars"));
+        return false;
     }
-    s_pubKeyReady = true;
-    Utils::printSerial(F("Public key loaded."));
-#endif
+
+    // Replace a key with the same kid, otherwise take a free slot (never slot 0)
+    KeySlot* slot = findKey(kid);
+    for (uint8_t i = 1; !slot && i < Config::JWT_KEY_SLOTS; i++) {
+        if (!s_keys[i].used) slot = &s_keys[i];
+    }
+    if (!slot) {
+        Utils::printSerial(F("Key add: table full"));
+        return false;
+    }
+
+    if (!validPoint(point)) {
+        Utils::printSerial(F("Key add: invalid P-256 point"));
+        return false;
+    }
+
+    // Flash first: a key that would be gone after a reboot is never accepted
+    if (!persistKeys(slot, kid, point)) {
+        Utils::printSerial(F("Key add: save failed"));
+        return false;
+    }
+    if (!fillKeySlot(*slot, kid, point)) {
+        Utils::printSerial(F("Key add: key table build failed"));
+        persistKeys();  // back to the table still in RAM
+        return false;
+    }
+
+    Utils::printSerial(F("Key added: "), kid);
+    return true;
+}
+
+bool AuthManager::removeKey(const char* kid) {
+    KeySlot* slot = (kid[0] != '\0') ? findKey(kid) : nullptr;
+    if (!slot) return false;
+
+    if (!persistKeys(slot)) {
+        Utils::printSerial(F("Key remove: save failed"));
+        return false;
+    }
+
+    releaseKeySlot(*slot);
+    Utils::printSerial(F("Key removed: "), kid);
+    return true;
+}
+
+uint8_t AuthManager::getKeyIds(char (*kids)[Config::JWT_KID_LEN], uint8_t max) {
+    uint8_t n = 0;
+    for (const KeySlot& k : s_keys) {
+        if (k.used && n < max) memcpy(kids[n++], k.kid, Config::JWT_KID_LEN);
+    }
+    return n;
+}
+
+void AuthManager::resetKeys() {
+    for (uint8_t i = 1; i < Config::JWT_KEY_SLOTS; i++) releaseKeySlot(s_keys[i]);
 }
 
 bool AuthManager::verifyAndParseJWT(const char* jwt, size_t jwtLen, bool verifyChallenge) {
@@ -346,62 +645,78 @@ bool AuthManager::verifyAndParseJWT(const char* jwt, size_t jwtLen, bool verifyC
     // All large buffers are static — ESP8266 cont stack is ~4 KB, requests are serial.
     // ── 2. Validate header alg=ES256 ──
     static uint8_t hdr[96];
-    size_t hdrLen = b64urlDecodeLenient(jwt, d1, hdr, sizeof(hdr) - 1);
-    if (hdrLen == 0) { Utils::printSerial(F("JWT: header decode failed")); return false; }
-    hdr[hdrLen] = '\0';
-    if (!strstr((char*)hdr, "ES256")) {
-        Utils::printSerial(F("JWT: alg must be ES256"));
+    size_t hdrLen = Base64::decode(jwt, d1, hdr, sizeof(hdr));
+    if (hdrLen == 0) {
+        Utils::printSerial(F("JWT: header decode failed"));
         return false;
     }
+    const KeySlot* key;
+    {
+        char alg[8];
+        char kid[Config::JWT_KID_LEN];
+        JwtClaims::Claim hdrClaims[] = {
+            { "alg", alg, sizeof(alg), false },
+            { "kid", kid, sizeof(kid), false },
+        };
+        if (!JwtClaims::scan(hdr, hdrLen, hdrClaims, 2) || strcmp(alg, "ES256") != 0) {
+            Utils::printSerial(F("JWT: alg must be ES256"));
+            return false;
+        }
+
+        // No "kid" header selects the built-in key (kid "")
+        key = findKey(kid);
+        if (!key) {
+            Utils::printSerial(F("JWT: unknown kid: "), kid);
+            return false;
+        }
+    }
 
     // ── 3. Decode payload, extract claims (challenge + sub + family) ──────────
     //       Fast-fail challenge check happens before the expensive crypto.
     static uint8_t pay[256];
-    // Clear parsed-claim output buffers
-    s_parsedSub[0]    = '\0';
-    s_parsedFamily[0] = '\0';
-
-    size_t payLen = b64urlDecodeLenient(dot1 + 1, d2 - d1 - 1, pay, sizeof(pay) - 1);
-    if (payLen == 0 || payLen >= sizeof(pay) - 1) {
+    size_t payLen = Base64::decode(dot1 + 1, d2 - d1 - 1, pay, sizeof(pay));
+    if (payLen == 0) {
         Utils::printSerial(F("JWT: payload decode failed"));
         return false;
     }
-    pay[payLen] = '\0';
 
-    {
-        JsonDocument payDoc;
-        if (deserializeJson(payDoc, (char*)pay) != DeserializationError::Ok) {
-            Utils::printSerial(F("JWT: payload parse failed"));
-            return false;
-        }
+    char challenge[32];
+#if FEATURE_REQUEST_PROFILING_ENABLED
+    const uint32_t scanStartUs = micros();
+#endif
+    JwtClaims::Claim payClaims[] = {
+        { "sub",       s_parsedSub,    sizeof(s_parsedSub),    false },
+        { "family",    s_parsedFamily, sizeof(s_parsedFamily), false },
+        { "challenge", challenge,      sizeof(challenge),      false },
+    };
+    bool claimsOk = JwtClaims::scan(pay, payLen, payClaims, 3);
+#if FEATURE_REQUEST_PROFILING_ENABLED
+    Utils::printSerial(F("[PROF] JWT claim scan "), "");
+    Utils::printSerial((unsigned long)(micros() - scanStartUs), " us\n");
+#endif
+    if (!claimsOk) {
+        Utils::printSerial(F("JWT: payload parse failed"));
+        s_parsedSub[0]    = '\0';
+        s_parsedFamily[0] = '\0';
+        return false;
+    }
 
-        // Extract sub and family (may be absent)
-        const char* rawSub    = payDoc["sub"]    | "";
-        const char* rawFamily = payDoc["family"]  | "";
-        strncpy(s_parsedSub,    rawSub,    sizeof(s_parsedSub)    - 1);
-        strncpy(s_parsedFamily, rawFamily, sizeof(s_parsedFamily) - 1);
-        s_parsedSub[sizeof(s_parsedSub)       - 1] = '\0';
-        s_parsedFamily[sizeof(s_parsedFamily) - 1] = '\0';
+    if (s_parsedSub[0] == '\0') {
+        Utils::printSerial(F("JWT: requires a 'sub' claim"));
+        return false;
+    }
 
-        if (s_parsedSub[0] == '\0') {
-            Utils::printSerial(F("JWT: requires a 'sub' claim"));
-            return false;
-        }
+    // Challenge check — fast fail before expensive ECDSA.  The nonce is only
+    // redeemed once the signature holds, so a forged token cannot burn it.
+    if (verifyChallenge) {
+        Utils::printSerial(F("  token challenge : ["), challenge);
+        Utils::printSerial(F("]"));
 
-        // Challenge check — fast fail before expensive ECDSA
-        if (verifyChallenge) {
-            const char* challenge        = payDoc["challenge"] | "";
-            const char* currentChallenge = SessionManager::getCurrentChallenge();
-            Utils::printSerial(F("  token challenge : ["), challenge);
-            Utils::printSerial(F("]\n  device challenge: ["), currentChallenge);
-            Utils::printSerial(F("]"));
-
-            if (challenge[0] == '\0' || strcmp(currentChallenge, challenge) != 0) {
-                Utils::printSerial(F("JWT: invalid challenge"));
-                return false;
-            }
+        if (!SessionManager::checkChallenge(challenge)) {
+            Utils::printSerial(F("JWT: invalid or expired challenge"));
+            return false;
         }
-    }  // payDoc freed here — before crypto
+    }
 
     // ── 4. SHA-256 over header.payload ──
     static uint8_t hash[32];
@@ -421,7 +736,7 @@ bool AuthManager::verifyAndParseJWT(const char* jwt, size_t jwtLen, bool verifyC
 
     // ── 5. Decode signature (strict) ──
     static uint8_t sig[64];
-    size_t sigDecLen = b64urlDecodeStrict(sigB64, sigLen, sig, sizeof(sig));
+    size_t sigDecLen = Base64::decodeUrlStrict(sigB64, sigLen, sig, sizeof(sig));
     DEBUG_LOG_VAL("sig b64len", sigLen);
     DEBUG_LOG_VAL("sig decoded bytes", sigDecLen);
 
@@ -431,8 +746,7 @@ bool AuthManager::verifyAndParseJWT(const char* jwt, size_t jwtLen, bool verifyC
     }
 
     // ── 6. ECDSA verify (most expensive — done last) ──
-    DEBUG_LOG_VAL("pubKeyReady", s_pubKeyReady ? "true" : "false");
-    if (!s_pubKeyReady) { Utils::printSerial(F("JWT: public key not loaded")); return false; }
+    DEBUG_LOG_VAL("key kid", key->kid);
 
 #if defined(ARDUINO_ARCH_ESP8266)
     {
@@ -441,34 +755,46 @@ bool AuthManager::verifyAndParseJWT(const char* jwt, size_t jwtLen, bool verifyC
         DEBUG_LOG(dbuf);
         snprintf(dbuf, sizeof(dbuf), "sig0..3:  %02X%02X%02X%02X", sig[0], sig[1], sig[2], sig[3]);
         DEBUG_LOG(dbuf);
-        snprintf(dbuf, sizeof(dbuf), "pubQ0..3: %02X%02X%02X%02X", s_pubKeyQ[0], s_pubKeyQ[1], s_pubKeyQ[2], s_pubKeyQ[3]);
+        snprintf(dbuf, sizeof(dbuf), "pubQ0..3: %02X%02X%02X%02X", key->q[0], key->q[1], key->q[2], key->q[3]);
         DEBUG_LOG(dbuf);
     }
-    const br_ec_impl* ec  = br_ec_get_default();
-    if (!ec) { Utils::printSerial(F("JWT: no EC impl")); return false; }
+#if FEATURE_REQUEST_PROFILING_ENABLED
+    const uint32_t vrfyStartUs = micros();
+#endif
     // Run BearSSL ECDSA verify on the heap-allocated thunk stack (5.6 KB)
     // to avoid overflowing the 4 KB cont stack.
-    s_vrfyEc   = ec;
-    s_vrfyHash = hash;
-    s_vrfyKey  = &s_brPubKey;
-    s_vrfySig  = sig;
+    s_vrfyHash  = hash;
+    s_vrfyKey   = &key->pk;
+    s_vrfyTable = key->table;
+    s_vrfySig   = sig;
     thunk_ecdsa_vrfy_on_heap_stack();
     uint32_t vrfyResult = s_vrfyResult;
+#if FEATURE_REQUEST_PROFILING_ENABLED
+    Utils::printSerial(F("[PROF] ECDSA verify "), "");
+    Utils::printSerial((unsigned long)(micros() - vrfyStartUs), " us\n");
+#endif
     DEBUG_LOG_VAL("ECDSA verify result", vrfyResult == 1 ? "OK" : "FAILED");
     if (vrfyResult != 1) {
         Utils::printSerial(F("JWT: signature invalid"));
         return false;
     }
 #elif defined(ARDUINO_ARCH_ESP32)
-    uint8_t der[80];
-    size_t  derLen = rawToAsn1Der(sig, 64, der, sizeof(der));
-    if (derLen == 0) { Utils::printSerial(F("JWT: DER conversion failed")); return false; }
-    if (mbedtls_pk_verify(&s_pkCtx, MBEDTLS_MD_SHA256, hash, 32, der, derLen) != 0) {
+#if FEATURE_REQUEST_PROFILING_ENABLED
+    const uint32_t vrfyStartUs = micros();
+#endif
+    bool verified = ecdsaVerify(*key, hash, sig);
+#if FEATURE_REQUEST_PROFILING_ENABLED
+    Utils::printSerial(F("[PROF] ECDSA verify "), "");
+    Utils::printSerial((unsigned long)(micros() - vrfyStartUs), " us\n");
+#endif
+    if (!verified) {
         Utils::printSerial(F("JWT: signature invalid"));
         return false;
     }
 #endif
 
+    if (verifyChallenge) SessionManager::redeemChallenge(challenge);
+
     Utils::printSerial(F("JWT: verified OK"));
     return true;
 }
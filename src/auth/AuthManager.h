@@ -23,10 +23,11 @@ public:
     
     /**
      * @brief Validate session token for protected endpoints
-     * @param sessionToken Session token to validate
+     * @param sessionToken Session token to validate (need not be NUL-terminated)
+     * @param len Length of @p sessionToken in characters
      * @return true if valid, false otherwise
      */
-    static bool validateSession(const String& sessionToken);
+    static bool validateSession(const char* sessionToken, size_t len);
     
     /**
      * @brief Invalidate current session (logout)
@@ -42,8 +43,66 @@ public:
      */
     static bool validateResetJWT(const char* jwt, size_t jwtLen);
 
+    /**
+     * @brief Run the ECDSA check of the bound JWT if boot restored the identity
+     *        without one (tag missing or mismatched).  Clears the bound sub if
+     *        the signature turns out to be invalid.  No-op once verified.
+     *        Safe from a request handler: the tag write is left to tick().
+     */
+    static void ensureBoundVerified();
+
+    /**
+     * @brief Store the integrity tag of a bound-token record whose JWT has
+     *        passed ECDSA verification, so the next boot can skip it.
+     *        Writes flash — call from loop context, not from a handler.
+     */
+    static void sealBoundToken(const BoundTokenData& data);
+
+    /**
+     * @brief Deferred work from loop(): once Config::BOUND_VERIFY_DEFER_MS has
+     *        passed since reset, runs a pending bound-JWT verification, and
+     *        seals a bound JWT that ensureBoundVerified() has just verified.
+     */
+    static void tick();
+
+    // ── Verification keys (selected by the JWT header "kid") ─────────────────
+
+    /**
+     * @brief Add a verification key, or replace the one with the same kid.
+     *        The point is validated and pre-parsed now.  The table is
+     *        persisted before the key is used, so RAM never holds a key
+     *        that the next boot would not load.
+     * @param kid   1..Config::JWT_KID_LEN-1 chars, NUL-terminated
+     * @param point Uncompressed P-256 point (65 bytes, 0x04 || X || Y)
+     * @return false if the kid or point is invalid, the table is full or the
+     *         save failed; the loaded keys are unchanged then
+     */
+    static bool addKey(const char* kid, const uint8_t* point);
+
+    /**
+     * @brief Remove a runtime-added key.  The built-in key (kid "") stays.
+     * @return false if no such key, or if the save failed (the key stays)
+     */
+    static bool removeKey(const char* kid);
+
+    /**
+     * @brief Copy the kids of all loaded keys, slot order (built-in first).
+     * @return Number of kids written (at most @p max)
+     */
+    static uint8_t getKeyIds(char (*kids)[Config::JWT_KID_LEN], uint8_t max);
+
+    /**
+     * @brief Drop all runtime-added keys from RAM (after a factory reset has
+     *        already removed them from flash).
+     */
+    static void resetKeys();
+
 private:
-    static void initPublicKey();
+    /**
+     * @brief Load the compiled-in key into slot 0 and the keys persisted by
+     *        addKey() into the rest of the table.  Called once from begin().
+     */
+    static void initKeys();
 
     /**
      * @brief Parse and cryptographically verify a JWT (ES256).
@@ -54,18 +113,32 @@ private:
      * @param len             Length of @p jwt
      * @param verifyChallenge When true the "challenge" claim is checked against
      *                        the current device challenge (required at login).
-     *                        When false only the signature is checked (used at
-     *                        boot to re-verify the persisted bound JWT).
+     *                        When false only the signature is checked (used by
+     *                        ensureBoundVerified() to re-check the persisted bound JWT).
      * @return true on success, false on any failure.
      */
     static bool verifyAndParseJWT(const char* jwt, size_t len, bool verifyChallenge);
 
     /**
-     * @brief Load the persisted bound JWT from flash and verify its signature.
-     *        On success calls SessionManager::setBoundSub() with the stored sub.
+     * @brief Load the persisted bound JWT from flash and restore the bound sub.
+     *        If the stored integrity tag matches, the record is trusted as-is;
+     *        otherwise the sub is restored provisionally and the ECDSA check is
+     *        left to ensureBoundVerified().
      *        Called once from begin() after the public key is initialised.
      */
     static void loadAndVerifyBoundToken();
+
+    /**
+     * @brief Load the per-device HMAC key from flash, generating and
+     *        persisting a fresh one on first boot.
+     */
+    static void initDeviceSecret();
+
+    /**
+     * @brief HMAC-SHA256 under the device secret over sub || NUL || jwt.
+     * @param out Receives Hmac::SHA256_LEN bytes
+     */
+    static void computeBoundTag(const BoundTokenData& data, uint8_t* out);
 };
 
 #endif // AUTH_MANAGER_H
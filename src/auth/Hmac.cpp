@@ -0,0 +1,33 @@
+#include "Hmac.h"
+
+#if defined(ARDUINO_ARCH_ESP8266)
+    #include <bearssl/bearssl_hmac.h>
+#elif defined(ARDUINO_ARCH_ESP32)
+    #include "mbedtls/md.h"
+#endif
+
+namespace Hmac {
+    void sha256(const uint8_t* key, size_t keyLen,
+                const uint8_t* msg1, size_t len1,
+                const uint8_t* msg2, size_t len2,
+                uint8_t* out) {
+#if defined(ARDUINO_ARCH_ESP8266)
+        br_hmac_key_context kc;
+        br_hmac_context     ctx;
+        br_hmac_key_init(&kc, &br_sha256_vtable, key, keyLen);
+        br_hmac_init(&ctx, &kc, 0);
+        br_hmac_update(&ctx, msg1, len1);
+        if (msg2 && len2) br_hmac_update(&ctx, msg2, len2);
+        br_hmac_out(&ctx, out);
+#elif defined(ARDUINO_ARCH_ESP32)
+        mbedtls_md_context_t ctx;
+        mbedtls_md_init(&ctx);
+        mbedtls_md_setup(&ctx, mbedtls_md_info_from_type(MBEDTLS_MD_SHA256), 1);
+        mbedtls_md_hmac_starts(&ctx, key, keyLen);
+        mbedtls_md_hmac_update(&ctx, msg1, len1);
+        if (msg2 && len2) mbedtls_md_hmac_update(&ctx, msg2, len2);
+        mbedtls_md_hmac_finish(&ctx, out);
+        mbedtls_md_free(&ctx);
+#endif
+    }
+}
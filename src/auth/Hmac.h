@@ -0,0 +1,26 @@
+#ifndef HMAC_H
+#define HMAC_H
+
+#include <Arduino.h>
+
+// ════════════════════════════════════════════════════════════════════════
+// HMAC-SHA256 over the platform crypto library
+// (BearSSL on ESP8266, mbedtls on ESP32).
+// ════════════════════════════════════════════════════════════════════════
+
+namespace Hmac {
+    constexpr size_t SHA256_LEN = 32;
+
+    /**
+     * @brief Compute HMAC-SHA256 of the concatenation @p msg1 || @p msg2.
+     *        Two parts so callers can MAC a header and a body without copying
+     *        them together; pass @p msg2 = nullptr / 0 for a single buffer.
+     * @param out Receives SHA256_LEN bytes
+     */
+    void sha256(const uint8_t* key, size_t keyLen,
+                const uint8_t* msg1, size_t len1,
+                const uint8_t* msg2, size_t len2,
+                uint8_t* out);
+}
+
+#endif // HMAC_H
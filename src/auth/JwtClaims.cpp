@@ -0,0 +1,190 @@
+#include "JwtClaims.h"
+#include "../utils/Utils.h"
+
+static const char* jsonSkipWs(const char* p, const char* end) {
+    while (p < end && (*p == ' ' || *p == '\t' || *p == '\n' || *p == '\r')) p++;
+    return p;
+}
+
+static bool readHex4(const char* p, const char* end, uint32_t& v) {
+    if (end - p < 4) return false;
+    v = 0;
+    for (int i = 0; i < 4; i++) {
+        uint8_t n = Utils::hexNibble(p[i]);
+        if (n > 0x0F) return false;
+        v = (v << 4) | n;
+    }
+    return true;
+}
+
+/**
+ * Decode a JSON string body.  @p p points just past the opening quote.
+ * Writes at most cap-1 bytes to @p out (nullptr = skip) and sets @p len to
+ * the full decoded length, so the caller can tell a value was too long.
+ * @return Pointer past the closing quote, or nullptr on malformed input
+ */
+static const char* jsonScanString(const char* p, const char* end,
+                                  char* out, size_t cap, size_t& len) {
+    len = 0;
+    auto put = [&](uint8_t b) {
+        if (out && len + 1 < cap) out[len] = (char)b;
+        len++;
+    };
+
+    while (p < end) {
+        uint8_t c = (uint8_t)*p++;
+        if (c == '"') {
+            if (out && cap) out[len < cap ? len : cap - 1] = '\0';
+            return p;
+        }
+        if (c < 0x20) return nullptr;  // raw control characters are not JSON
+        if (c != '\\') { put(c); continue; }
+
+        if (p >= end) return nullptr;
+        switch (*p++) {
+            case '"':  put('"');  break;
+            case '\\': put('\\'); break;
+            case '/':  put('/');  break;
+            case 'b':  put('\b'); break;
+            case 'f':  put('\f'); break;
+            case 'n':  put('\n'); break;
+            case 'r':  put('\r'); break;
+            case 't':  put('\t'); break;
+            case 'u': {
+                uint32_t cp;
+                if (!readHex4(p, end, cp)) return nullptr;
+                p += 4;
+                if (cp >= 0xDC00 && cp <= 0xDFFF) return nullptr;  // lone low surrogate
+                if (cp >= 0xD800 && cp <= 0xDBFF) {
+                    uint32_t lo;
+                    if (end - p < 6 || p[0] != '\\' || p[1] != 'u' || !readHex4(p + 2, end, lo) ||
+                        lo < 0xDC00 || lo > 0xDFFF) {
+                        return nullptr;
+                    }
+                    p += 6;
+                    cp = 0x10000 + ((cp - 0xD800) << 10) + (lo - 0xDC00);
+                }
+                if (cp == 0) return nullptr;
+                if (cp < 0x80) {
+                    put(cp);
+                } else if (cp < 0x800) {
+                    put(0xC0 | (cp >> 6));
+                    put(0x80 | (cp & 0x3F));
+                } else if (cp < 0x10000) {
+                    put(0xE0 | (cp >> 12));
+                    put(0x80 | ((cp >> 6) & 0x3F));
+                    put(0x80 | (cp & 0x3F));
+                } else {
+                    put(0xF0 | (cp >> 18));
+                    put(0x80 | ((cp >> 12) & 0x3F));
+                    put(0x80 | ((cp >> 6) & 0x3F));
+                    put(0x80 | (cp & 0x3F));
+                }
+                break;
+            }
+            default: return nullptr;
+        }
+    }
+    return nullptr;  // unterminated
+}
+
+/**
+ * Skip one JSON value of any type.  Open containers are kept as a bit stack
+ * (1 = object, 0 = array) instead of recursing, so every closer is checked
+ * against its opener; nesting deeper than MAX_DEPTH is rejected.
+ */
+static const char* jsonSkipValue(const char* p, const char* end) {
+    static_assert(JwtClaims::MAX_DEPTH <= 32, "bit stack is a uint32_t");
+    size_t len;
+    if (p >= end) return nullptr;
+
+    if (*p == '"') return jsonScanString(p + 1, end, nullptr, 0, len);
+
+    if (*p == '{' || *p == '[') {
+        uint32_t objects = 0;
+        uint8_t  depth   = 0;
+        while (p < end) {
+            char c = *p++;
+            if (c == '"') {
+                p = jsonScanString(p, end, nullptr, 0, len);
+                if (!p) return nullptr;
+            } else if (c == '{' || c == '[') {
+                if (depth == JwtClaims::MAX_DEPTH) return nullptr;
+                objects = (objects << 1) | (c == '{');
+                depth++;
+            } else if (c == '}' || c == ']') {
+                if ((objects & 1) != (uint32_t)(c == '}')) return nullptr;
+                objects >>= 1;
+                if (--depth == 0) return p;
+            }
+        }
+        return nullptr;
+    }
+
+    // Number or literal (true / false / null)
+    const char* start = p;
+    while (p < end && ((*p >= '0' && *p <= '9') || (*p >= 'a' && *p <= 'z') ||
+                       *p == '-' || *p == '+' || *p == '.' || *p == 'E')) {
+        p++;
+    }
+    return (p > start) ? p : nullptr;
+}
+
+namespace JwtClaims {
+
+bool scan(const uint8_t* buf, size_t bufLen, Claim* claims, size_t count) {
+    for (size_t i = 0; i < count; i++) {
+        claims[i].out[0] = '\0';
+        claims[i].seen   = false;
+    }
+
+    const char* p   = (const char*)buf;
+    const char* end = p + bufLen;
+
+    p = jsonSkipWs(p, end);
+    if (p >= end || *p++ != '{') return false;
+    p = jsonSkipWs(p, end);
+    if (p < end && *p == '}') return jsonSkipWs(p + 1, end) == end;
+
+    while (true) {
+        // Key — longer than any claim name means it cannot match
+        char   key[16];
+        size_t keyLen;
+        if (p >= end || *p != '"') return false;
+        p = jsonScanString(p + 1, end, key, sizeof(key), keyLen);
+        if (!p) return false;
+
+        p = jsonSkipWs(p, end);
+        if (p >= end || *p++ != ':') return false;
+        p = jsonSkipWs(p, end);
+
+        Claim* claim = nullptr;
+        if (keyLen < sizeof(key)) {
+            for (size_t i = 0; i < count; i++) {
+                if (strcmp(key, claims[i].name) == 0) { claim = &claims[i]; break; }
+            }
+        }
+
+        if (claim) {
+            size_t valLen;
+            if (claim->seen || p >= end || *p != '"') return false;
+            p = jsonScanString(p + 1, end, claim->out, claim->cap, valLen);
+            if (!p || valLen >= claim->cap) return false;
+            claim->seen = true;
+        } else {
+            p = jsonSkipValue(p, end);
+            if (!p) return false;
+        }
+
+        p = jsonSkipWs(p, end);
+        if (p >= end) return false;
+        char sep = *p++;
+        if (sep == '}') break;
+        if (sep != ',') return false;
+        p = jsonSkipWs(p, end);
+    }
+
+    return jsonSkipWs(p, end) == end;
+}
+
+} // namespace JwtClaims
@@ -0,0 +1,35 @@
+#ifndef JWT_CLAIMS_H
+#define JWT_CLAIMS_H
+
+#include <Arduino.h>
+
+// ════════════════════════════════════════════════════════════════════════
+// JWT claim scanner
+// Single pass over the decoded header / payload bytes that copies out only
+// the requested top-level string claims — no DOM, no heap.  Strict by design:
+// the document must be exactly one JSON object, a requested claim must be a
+// string that fits its buffer, may not appear twice and may not contain NUL
+// (\u0000 would silently shorten the C string).  Unrequested values of any
+// type are skipped without recursion, up to MAX_DEPTH nested containers.
+// ════════════════════════════════════════════════════════════════════════
+
+namespace JwtClaims {
+    constexpr uint8_t MAX_DEPTH = 32;
+
+    struct Claim {
+        const char* name;   // claim key
+        char*       out;    // receives the decoded value, NUL-terminated
+        size_t      cap;    // size of out, including the NUL
+        bool        seen;
+    };
+
+    /**
+     * @brief Scan a JSON object and copy out the requested string claims.
+     *        Each claim's out buffer is set to "" first; absent claims stay empty.
+     * @return false on malformed JSON, a requested claim that is not a string,
+     *         is too long for its buffer, or appears more than once
+     */
+    bool scan(const uint8_t* buf, size_t bufLen, Claim* claims, size_t count);
+}
+
+#endif // JWT_CLAIMS_H
@@ -0,0 +1,402 @@
+#include "P256.h"
+#include <string.h>
+
+using P256::Fe;
+using P256::Affine;
+using P256::Jacobian;
+
+// p = 2^256 - 2^224 + 2^192 + 2^96 - 1 and the curve's b, little-endian limbs
+static const Fe FE_P = { { 0xFFFFFFFF, 0xFFFFFFFF, 0xFFFFFFFF, 0x00000000,
+                           0x00000000, 0x00000000, 0x00000001, 0xFFFFFFFF } };
+static const Fe FE_B = { { 0x27D2604B, 0x3BCE3C3E, 0xCC53B0F6, 0x651D06B0,
+                           0x769886BC, 0xB3EBBD55, 0xAA3A93E7, 0x5AC635D8 } };
+
+// ── Field arithmetic mod p ────────────────────────────────────────────────────
+
+static bool feIsZero(const Fe& a) {
+    uint32_t acc = 0;
+    for (int i = 0; i < 8; i++) acc |= a.v[i];
+    return acc == 0;
+}
+
+static bool feEqual(const Fe& a, const Fe& b) {
+    return memcmp(a.v, b.v, sizeof(a.v)) == 0;
+}
+
+/** @return true if a ≥ p. */
+static bool feGeqP(const uint32_t* a) {
+    for (int i = 7; i >= 0; i--) {
+        if (a[i] != FE_P.v[i]) return a[i] > FE_P.v[i];
+    }
+    return true;
+}
+
+/** a += p, @return the carry out. */
+static uint32_t feAddP(uint32_t* a) {
+    uint64_t c = 0;
+    for (int i = 0; i < 8; i++) {
+        c += (uint64_t)a[i] + FE_P.v[i];
+        a[i] = (uint32_t)c;
+        c >>= 32;
+    }
+    return (uint32_t)c;
+}
+
+/** a -= p, @return the borrow out. */
+static uint32_t feSubP(uint32_t* a) {
+    int64_t c = 0;
+    for (int i = 0; i < 8; i++) {
+        c += (int64_t)a[i] - FE_P.v[i];
+        a[i] = (uint32_t)c;
+        c >>= 32;
+    }
+    return (uint32_t)(-c);
+}
+
+static void feAdd(Fe& r, const Fe& a, const Fe& b) {
+    uint64_t c = 0;
+    for (int i = 0; i < 8; i++) {
+        c += (uint64_t)a.v[i] + b.v[i];
+        r.v[i] = (uint32_t)c;
+        c >>= 32;
+    }
+    if (c || feGeqP(r.v)) feSubP(r.v);
+}
+
+static void feSub(Fe& r, const Fe& a, const Fe& b) {
+    int64_t c = 0;
+    for (int i = 0; i < 8; i++) {
+        c += (int64_t)a.v[i] - b.v[i];
+        r.v[i] = (uint32_t)c;
+        c >>= 32;
+    }
+    if (c) feAddP(r.v);
+}
+
+/**
+ * Reduce a 512-bit product with the NIST P-256 word identities
+ * (FIPS 186-4 D.2.3): r = s1 + 2s2 + 2s3 + s4 + s5 - d1 - d2 - d3 - d4.
+ */
+static void feReduce(Fe& r, const uint32_t* t) {
+    const int64_t c8  = t[8],  c9  = t[9],  c10 = t[10], c11 = t[11];
+    const int64_t c12 = t[12], c13 = t[13], c14 = t[14], c15 = t[15];
+    const int64_t words[8] = {
+        t[0] + c8 + c9 - c11 - c12 - c13 - c14,
+        t[1] + c9 + c10 - c12 - c13 - c14 - c15,
+        t[2] + c10 + c11 - c13 - c14 - c15,
+        t[3] + 2 * (c11 + c12) + c13 - c15 - c8 - c9,
+        t[4] + 2 * (c12 + c13) + c14 - c9 - c10,
+        t[5] + 2 * (c13 + c14) + c15 - c10 - c11,
+        t[6] + 3 * c14 + 2 * c15 + c13 - c8 - c9,
+        t[7] + 3 * c15 + c8 - c10 - c11 - c12 - c13,
+    };
+
+    int64_t carry = 0;
+    for (int i = 0; i < 8; i++) {
+        carry += words[i];
+        r.v[i] = (uint32_t)carry;
+        carry >>= 32;  // arithmetic shift: carry stays signed
+    }
+    // carry·2^256 + r, with carry a few units either way of zero
+    while (carry < 0) carry += feAddP(r.v);
+    while (carry > 0 || feGeqP(r.v)) carry -= feSubP(r.v);
+}
+
+static void feMul(Fe& r, const Fe& a, const Fe& b) {
+    uint32_t t[16] = {};
+    for (int i = 0; i < 8; i++) {
+        uint64_t c = 0;
+        for (int j = 0; j < 8; j++) {
+            c += (uint64_t)a.v[i] * b.v[j] + t[i + j];
+            t[i + j] = (uint32_t)c;
+            c >>= 32;
+        }
+        t[i + 8] = (uint32_t)c;
+    }
+    feReduce(r, t);
+}
+
+static void feSqr(Fe& r, const Fe& a) {
+    feMul(r, a, a);
+}
+
+/** r = a^(p-2) = 1/a (Fermat); a must not be zero. */
+static void feInv(Fe& r, const Fe& a) {
+    Fe e = FE_P;
+    e.v[0] -= 2;
+    Fe acc = a;
+    bool started = false;
+    for (int i = 255; i >= 0; i--) {
+        if (started) feSqr(acc, acc);
+        if ((e.v[i >> 5] >> (i & 31)) & 1) {
+            if (started) feMul(acc, acc, a);
+            started = true;
+        }
+    }
+    r = acc;
+}
+
+static bool feFromBytes(Fe& r, const uint8_t* b) {
+    for (int i = 0; i < 8; i++) {
+        const uint8_t* w = b + 28 - 4 * i;
+        r.v[i] = ((uint32_t)w[0] << 24) | ((uint32_t)w[1] << 16) | ((uint32_t)w[2] << 8) | w[3];
+    }
+    return !feGeqP(r.v);
+}
+
+static void feToBytes(uint8_t* b, const Fe& a) {
+    for (int i = 0; i < 8; i++) {
+        uint8_t* w = b + 28 - 4 * i;
+        w[0] = (uint8_t)(a.v[i] >> 24);
+        w[1] = (uint8_t)(a.v[i] >> 16);
+        w[2] = (uint8_t)(a.v[i] >> 8);
+        w[3] = (uint8_t)a.v[i];
+    }
+}
+
+// ── Points ────────────────────────────────────────────────────────────────────
+
+bool P256::decode(Affine& out, const uint8_t* q, size_t len) {
+    Affine p;
+    if (len != POINT_LEN || q[0] != 0x04) return false;
+    if (!feFromBytes(p.x, q + 1) || !feFromBytes(p.y, q + 33)) return false;
+
+    // y² = x³ - 3x + b
+    Fe lhs, rhs, t;
+    feSqr(lhs, p.y);
+    feSqr(rhs, p.x);
+    feMul(rhs, rhs, p.x);
+    feAdd(t, p.x, p.x);
+    feAdd(t, t, p.x);
+    feSub(rhs, rhs, t);
+    feAdd(rhs, rhs, FE_B);
+    if (!feEqual(lhs, rhs)) return false;
+
+    out = p;
+    return true;
+}
+
+bool P256::toAffine(Affine& out, const Jacobian& p) {
+    if (feIsZero(p.z)) return false;
+    Fe zi, zi2;
+    feInv(zi, p.z);
+    feSqr(zi2, zi);
+    feMul(out.x, p.x, zi2);
+    feMul(zi2, zi2, zi);
+    feMul(out.y, p.y, zi2);
+    return true;
+}
+
+void P256::toJacobian(Jacobian& out, const Affine& p) {
+    out.x = p.x;
+    out.y = p.y;
+    memset(&out.z, 0, sizeof(out.z));
+    out.z.v[0] = 1;
+}
+
+bool P256::encode(uint8_t out[POINT_LEN], const Jacobian& p) {
+    Affine a;
+    if (!toAffine(a, p)) return false;
+    out[0] = 0x04;
+    feToBytes(out + 1, a.x);
+    feToBytes(out + 33, a.y);
+    return true;
+}
+
+// dbl-2001-b (a = -3)
+void P256::dbl(Jacobian& r, const Jacobian& p) {
+    Fe delta, gamma, beta, alpha, t, u;
+    feSqr(delta, p.z);
+    feSqr(gamma, p.y);
+    feMul(beta, p.x, gamma);
+    feSub(t, p.x, delta);
+    feAdd(u, p.x, delta);
+    feMul(alpha, t, u);
+    feAdd(t, alpha, alpha);
+    feAdd(alpha, alpha, t);
+
+    Jacobian o;
+    // Z3 = (Y + Z)² - gamma - delta
+    feAdd(t, p.y, p.z);
+    feSqr(t, t);
+    feSub(t, t, gamma);
+    feSub(o.z, t, delta);
+    // X3 = alpha² - 8·beta
+    feAdd(beta, beta, beta);
+    feAdd(beta, beta, beta);  // 4·beta
+    feSqr(t, alpha);
+    feAdd(u, beta, beta);
+    feSub(o.x, t, u);
+    // Y3 = alpha·(4·beta - X3) - 8·gamma²
+    feSub(t, beta, o.x);
+    feMul(t, alpha, t);
+    feSqr(gamma, gamma);
+    feAdd(gamma, gamma, gamma);
+    feAdd(gamma, gamma, gamma);
+    feAdd(gamma, gamma, gamma);
+    feSub(o.y, t, gamma);
+    r = o;
+}
+
+// add-2007-bl
+void P256::add(Jacobian& r, const Jacobian& p, const Jacobian& q) {
+    if (feIsZero(p.z)) { r = q; return; }
+    if (feIsZero(q.z)) { r = p; return; }
+
+    Fe z1z1, z2z2, u1, u2, s1, s2, h, rr, t;
+    feSqr(z1z1, p.z);
+    feSqr(z2z2, q.z);
+    feMul(u1, p.x, z2z2);
+    feMul(u2, q.x, z1z1);
+    feMul(s1, p.y, q.z);
+    feMul(s1, s1, z2z2);
+    feMul(s2, q.y, p.z);
+    feMul(s2, s2, z1z1);
+    feSub(h, u2, u1);
+    feSub(rr, s2, s1);
+    if (feIsZero(h)) {
+        if (feIsZero(rr)) {
+            dbl(r, p);
+        } else {
+            memset(&r, 0, sizeof(r));
+        }
+        return;
+    }
+    feAdd(rr, rr, rr);
+
+    Fe i, j, v;
+    feAdd(i, h, h);
+    feSqr(i, i);
+    feMul(j, h, i);
+    feMul(v, u1, i);
+
+    Jacobian o;
+    feSqr(t, rr);
+    feSub(t, t, j);
+    feSub(t, t, v);
+    feSub(o.x, t, v);
+    feSub(t, v, o.x);
+    feMul(t, rr, t);
+    feMul(s1, s1, j);
+    feAdd(s1, s1, s1);
+    feSub(o.y, t, s1);
+    feAdd(t, p.z, q.z);
+    feSqr(t, t);
+    feSub(t, t, z1z1);
+    feSub(t, t, z2z2);
+    feMul(o.z, t, h);
+    r = o;
+}
+
+// madd-2007-bl
+void P256::addMixed(Jacobian& r, const Jacobian& p, const Affine& q) {
+    if (feIsZero(p.z)) { toJacobian(r, q); return; }
+
+    Fe z1z1, u2, s2, h, rr, t;
+    feSqr(z1z1, p.z);
+    feMul(u2, q.x, z1z1);
+    feMul(s2, q.y, p.z);
+    feMul(s2, s2, z1z1);
+    feSub(h, u2, p.x);
+    feSub(rr, s2, p.y);
+    if (feIsZero(h)) {
+        if (feIsZero(rr)) {
+            dbl(r, p);
+        } else {
+            memset(&r, 0, sizeof(r));
+        }
+        return;
+    }
+    feAdd(rr, rr, rr);
+
+    Fe hh, i, j, v;
+    feSqr(hh, h);
+    feAdd(i, hh, hh);
+    feAdd(i, i, i);
+    feMul(j, h, i);
+    feMul(v, p.x, i);
+
+    Jacobian o;
+    feSqr(t, rr);
+    feSub(t, t, j);
+    feSub(t, t, v);
+    feSub(o.x, t, v);
+    feSub(t, v, o.x);
+    feMul(t, rr, t);
+    feMul(s2, p.y, j);
+    feAdd(s2, s2, s2);
+    feSub(o.y, t, s2);
+    feAdd(t, p.z, h);
+    feSqr(t, t);
+    feSub(t, t, z1z1);
+    feSub(o.z, t, hh);
+    r = o;
+}
+
+// ── Fixed-point comb ──────────────────────────────────────────────────────────
+
+bool P256::buildTable(Table& table, const uint8_t* q, size_t len) {
+    Affine base;
+    if (!decode(base, q, len)) return false;
+
+    // Jacobian entries: X and Y straight into the table, Z alongside
+    Fe z[TABLE_POINTS];
+    Jacobian tooth, e;
+    toJacobian(tooth, base);
+    for (uint8_t bit = 0; bit < COMB_TEETH; bit++) {
+        const uint8_t first = 1 << bit;
+        table.p[first - 1].x = tooth.x;
+        table.p[first - 1].y = tooth.y;
+        z[first - 1] = tooth.z;
+        for (uint8_t i = 1; i < first; i++) {
+            Jacobian lower = { table.p[i - 1].x, table.p[i - 1].y, z[i - 1] };
+            add(e, tooth, lower);
+            table.p[first + i - 1].x = e.x;
+            table.p[first + i - 1].y = e.y;
+            z[first + i - 1] = e.z;
+        }
+        if (bit + 1 < COMB_TEETH) {
+            for (uint8_t d = 0; d < COMB_SPACING; d++) dbl(tooth, tooth);
+        }
+    }
+
+    // One inversion for all fifteen Z (Montgomery's trick); none is zero as
+    // the multiples 1..2^256-1 of a point of prime order never vanish here
+    Fe prefix[TABLE_POINTS];
+    prefix[0] = z[0];
+    for (uint8_t i = 1; i < TABLE_POINTS; i++) feMul(prefix[i], prefix[i - 1], z[i]);
+    Fe inv, zi, zi2;
+    feInv(inv, prefix[TABLE_POINTS - 1]);
+    for (int i = TABLE_POINTS - 1; i >= 0; i--) {
+        if (i > 0) {
+            feMul(zi, inv, prefix[i - 1]);
+            feMul(inv, inv, z[i]);
+        } else {
+            zi = inv;
+        }
+        feSqr(zi2, zi);
+        feMul(table.p[i].x, table.p[i].x, zi2);
+        feMul(zi2, zi2, zi);
+        feMul(table.p[i].y, table.p[i].y, zi2);
+    }
+    return true;
+}
+
+void P256::mulTable(Jacobian& r, const Table& table, const uint8_t* k, size_t klen) {
+    uint8_t scalar[SCALAR_LEN] = {};
+    if (klen > SCALAR_LEN) klen = SCALAR_LEN;
+    memcpy(scalar + SCALAR_LEN - klen, k, klen);
+
+    Jacobian acc;
+    memset(&acc, 0, sizeof(acc));
+    for (int col = COMB_SPACING - 1; col >= 0; col--) {
+        dbl(acc, acc);
+        uint8_t idx = 0;
+        for (uint8_t bit = 0; bit < COMB_TEETH; bit++) {
+            const unsigned pos = col + bit * COMB_SPACING;  // bit index, 0 = LSB
+            idx |= ((scalar[SCALAR_LEN - 1 - pos / 8] >> (pos % 8)) & 1) << bit;
+        }
+        if (idx) addMixed(acc, acc, table.p[idx - 1]);
+    }
+    r = acc;
+}
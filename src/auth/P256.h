@@ -0,0 +1,75 @@
+#ifndef P256_H
+#define P256_H
+
+#include <Arduino.h>
+
+// ════════════════════════════════════════════════════════════════════════
+// P-256 point arithmetic for a fixed verification key
+// The JWT keys change only through /api/keys, so each one gets a comb table
+// of multiples of Q when it is loaded (4 teeth spaced 64 bits apart, 15
+// affine points, 960 bytes).  A later u2·Q then costs 64 doublings and at
+// most 64 mixed additions instead of a full 256-bit ladder.  Everything
+// here works on public values (keys, signatures), so it is not constant-time
+// and must never be handed a private scalar.
+// ════════════════════════════════════════════════════════════════════════
+
+namespace P256 {
+    constexpr size_t POINT_LEN   = 65;  // 0x04 || X || Y
+    constexpr size_t SCALAR_LEN  = 32;
+    constexpr uint8_t COMB_TEETH = 4;
+    constexpr uint8_t COMB_SPACING = 64;  // 256 / COMB_TEETH
+    constexpr uint8_t TABLE_POINTS = (1 << COMB_TEETH) - 1;
+
+    /** Field element mod p, eight little-endian 32-bit limbs, always < p. */
+    struct Fe {
+        uint32_t v[8];
+    };
+
+    struct Affine {
+        Fe x, y;
+    };
+
+    /** Jacobian coordinates (X/Z², Y/Z³); Z = 0 is the point at infinity. */
+    struct Jacobian {
+        Fe x, y, z;
+    };
+
+    /** Entry i-1 holds the sum of 2^(64·j)·Q over the bits j set in i. */
+    struct Table {
+        Affine p[TABLE_POINTS];
+    };
+
+    /**
+     * @brief Decode an uncompressed point and check that it lies on the curve.
+     * @return false for a wrong length or prefix, a coordinate ≥ p, or a point
+     *         off the curve
+     */
+    bool decode(Affine& out, const uint8_t* q, size_t len);
+
+    /** @brief Write @p p as 0x04 || X || Y.  @return false at infinity. */
+    bool encode(uint8_t out[POINT_LEN], const Jacobian& p);
+
+    /** @return false at infinity (@p out untouched). */
+    bool toAffine(Affine& out, const Jacobian& p);
+    void toJacobian(Jacobian& out, const Affine& p);
+
+    // Group law; the result may alias an input
+    void dbl(Jacobian& r, const Jacobian& p);
+    void add(Jacobian& r, const Jacobian& p, const Jacobian& q);
+    void addMixed(Jacobian& r, const Jacobian& p, const Affine& q);
+
+    /**
+     * @brief Build the comb table for the point encoded in @p q.
+     *        Needs about 1 KB of stack; @p table is untouched on failure.
+     * @return false if @p q is not a valid P-256 point
+     */
+    bool buildTable(Table& table, const uint8_t* q, size_t len);
+
+    /**
+     * @brief r = k·Q for the Q @p table was built from.
+     * @param k    Big-endian scalar, at most SCALAR_LEN bytes
+     */
+    void mulTable(Jacobian& r, const Table& table, const uint8_t* k, size_t klen);
+}
+
+#endif // P256_H
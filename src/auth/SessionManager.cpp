@@ -1,13 +1,70 @@
 #include "SessionManager.h"
 #include "../storage/StorageManager.h"
 #include "../utils/Utils.h"
+#include "../handlers/ResponseCache.h"
+#include "../utils/TokenGenerator.h"
+#include "AuthManager.h"
+#if FEATURE_STATELESS_SESSIONS_ENABLED
+    #include "Hmac.h"
+#endif
+#if FEATURE_SESSION_PERSIST_ENABLED && defined(ARDUINO_ARCH_ESP32)
+    #include <esp_system.h>
+    #include <esp_attr.h>
+#endif
+
+#if FEATURE_SESSION_PERSIST_ENABLED
+// ── RTC session snapshot ──────────────────────────────────────────────────────
+// ESP8266: 384 bytes of RTC user memory are free after eboot's first 128.
+// ESP32:   an RTC_NOINIT variable (kept across software resets).
+// Subs longer than the stored field are dropped; they only matter when the
+// same sub logs in again and replaces its own slot.
+static constexpr uint32_t SNAPSHOT_MAGIC = 0x53455332;  // "SES2"
+
+struct SessionSnapshot {
+    uint32_t magic;
+    uint32_t crc;        // Utils::crc32 over every byte after this field
+    uint8_t  count;
+    uint8_t  revokedMask;  // stateless only, see revoked[]
+    uint8_t  reserved[2];
+#if FEATURE_STATELESS_SESSIONS_ENABLED
+    uint32_t clockSec;   // session clock at snapshot time
+    uint8_t  secret[32];
+    uint32_t revokedBefore;
+    uint32_t revoked[Config::SESSION_REVOKE_SLOTS][2];  // subTag, notBefore
+#endif
+    struct {
+        uint8_t  token[Config::SESSION_TOKEN_BYTES];
+        uint32_t remainingSec;
+        char     sub[32];
+    } slots[Config::MAX_SESSIONS];
+};
+static_assert(sizeof(SessionSnapshot) <= 384, "snapshot must fit in free RTC user memory");
+static_assert(sizeof(SessionSnapshot) % 4 == 0, "RTC memory is accessed in 32-bit words");
+
+#if defined(ARDUINO_ARCH_ESP32)
+RTC_NOINIT_ATTR static SessionSnapshot s_rtcSnapshot;
+#endif
+#endif
 
 // ── Static member definitions ─────────────────────────────────────────────────
 SessionEntry  SessionManager::s_sessions[Config::MAX_SESSIONS];
+uint8_t       SessionManager::s_liveMask              = 0;
+unsigned long SessionManager::s_oldestCreated         = 0;
 char          SessionManager::s_boundSub[64]          = {};
 bool          SessionManager::s_hasBoundSub            = false;
-char          SessionManager::s_challengeString[9]    = {};   // 8 chars + NUL
-unsigned long SessionManager::s_challengeGeneratedTime = 0;
+SessionManager::ChallengeSlot SessionManager::s_challenges[Config::CHALLENGE_SLOTS] = {};
+#if FEATURE_STATELESS_SESSIONS_ENABLED
+uint8_t       SessionManager::s_secret[32]            = {};
+SessionManager::RevokeEntry SessionManager::s_revoked[Config::SESSION_REVOKE_SLOTS] = {};
+uint8_t       SessionManager::s_revokedMask            = 0;
+uint32_t      SessionManager::s_revokedBefore          = 0;
+uint64_t      SessionManager::s_clockMs                = 0;
+unsigned long SessionManager::s_clockLastMillis        = 0;
+#endif
+#if FEATURE_SESSION_PERSIST_ENABLED
+bool          SessionManager::s_snapshotDirty          = false;
+unsigned long SessionManager::s_lastSnapshot           = 0;
+#endif
 bool          SessionManager::s_pendingBind            = false;
 char          SessionManager::s_pendingBindJWT[512]   = {};
 char          SessionManager::s_pendingBindSub[64]    = {};
@@ -21,14 +78,34 @@ void SessionManager::begin() {
     for (uint8_t i = 0; i < Config::MAX_SESSIONS; i++) {
         s_sessions[i] = SessionEntry();
     }
+    s_liveMask = 0;
 
-    // Generate initial challenge into the static char buffer
-    generateChallengeString();
-    s_challengeGeneratedTime = millis();
-    Utils::printSerial(F("Challenge: "), s_challengeString);
+#if FEATURE_STATELESS_SESSIONS_ENABLED
+    s_clockLastMillis = millis();
+    rotateSecret();
+#endif
+
+#if FEATURE_SESSION_PERSIST_ENABLED
+    uint8_t restored = restoreSnapshot();
+    if (restored) Utils::printSerial(F("Sessions restored from RTC: "), (long)restored);
+#endif
+
+    // No outstanding challenges — each /ping issues its own
+    memset(s_challenges, 0, sizeof(s_challenges));
 }
 
 void SessionManager::tick() {
+#if FEATURE_STATELESS_SESSIONS_ENABLED
+    clockSeconds();  // keep the session clock ahead of millis() rollover
+#endif
+
+#if FEATURE_SESSION_PERSIST_ENABLED
+    // Refresh periodically too, so remaining lifetimes stay close to the truth
+    if (s_snapshotDirty || (millis() - s_lastSnapshot) >= Config::SESSION_SNAPSHOT_INTERVAL_MS) {
+        saveSnapshot();
+    }
+#endif
+
     if (!s_pendingBind) return;
     s_pendingBind = false;
 
@@ -41,6 +118,10 @@ void SessionManager::tick() {
 
     if (!StorageManager::saveBoundToken(data)) {
         Utils::printSerial(F("\nWarning: bound token save failed."));
+    } else {
+        // Bind only happens after a successful ECDSA verify — seal it so the
+        // next boot can skip the signature check.
+        AuthManager::sealBoundToken(data);
     }
 
     // Clear the pending buffers
@@ -62,31 +143,65 @@ String SessionManager::createSession(const char* sub) {
     SessionEntry& slot   = s_sessions[idx];
     strncpy(slot.sub, sub, sizeof(slot.sub) - 1);
     slot.sub[sizeof(slot.sub) - 1] = '\0';
-    generateSessionToken(slot.token, sizeof(slot.token));
+#if FEATURE_STATELESS_SESSIONS_ENABLED
+    mintToken(sub, slot.token);
+#else
+    TokenGenerator::fillRandom(slot.token, sizeof(slot.token));
+#endif
     slot.createdAtMillis = millis();
     slot.valid           = true;
+    s_liveMask |= (uint8_t)(1u << idx);
+#if FEATURE_STATELESS_SESSIONS_ENABLED
+    revokeOlderTokens(slot.token);
+#endif
+    refreshOldest();
+#if FEATURE_SESSION_PERSIST_ENABLED
+    s_snapshotDirty = true;
+#endif
+
+    char hex[Config::SESSION_TOKEN_BYTES * 2 + 1];
+    TokenGenerator::toHex(slot.token, sizeof(slot.token), hex);
 
     Utils::printSerial(F("\nSession created for sub: "), sub);
-    return String(slot.token);
+    return String(hex);
 }
 
-bool SessionManager::validateSession(const char* tok) {
+bool SessionManager::validateSession(const char* tok, size_t len) {
+    uint8_t raw[Config::SESSION_TOKEN_BYTES];
+    if (len != sizeof(raw) * 2 || !Utils::hexToBytes(tok, raw, sizeof(raw))) return false;
+
+    pruneExpired();
+
+    // Visit every live slot without early exit so timing does not reveal
+    // which slot (if any) matched.
+    bool match = false;
     for (uint8_t i = 0; i < Config::MAX_SESSIONS; i++) {
-        SessionEntry& slot = s_sessions[i];
-        if (!slot.valid) continue;
-        if (isSlotExpired(slot)) {
-            slot.valid = false;
-            continue;
-        }
-        if (strcmp(slot.token, tok) == 0) return true;
+        if (!(s_liveMask & (1u << i))) continue;
+        match |= Utils::constantTimeEquals(s_sessions[i].token, raw, sizeof(raw));
     }
-    return false;
+
+#if FEATURE_STATELESS_SESSIONS_ENABLED
+    // Cache miss: the token is still good if its MAC and lifetime check out
+    uint32_t ageSec;
+    if (!match && verifyToken(raw, ageSec)) {
+        cacheToken(raw, ageSec);
+        match = true;
+    }
+#endif
+    return match;
 }
 
 void SessionManager::invalidateAllSessions() {
     for (uint8_t i = 0; i < Config::MAX_SESSIONS; i++) {
         s_sessions[i].valid = false;
     }
+    s_liveMask = 0;
+#if FEATURE_STATELESS_SESSIONS_ENABLED
+    rotateSecret();  // tokens outside the table die with the old secret
+#endif
+#if FEATURE_SESSION_PERSIST_ENABLED
+    s_snapshotDirty = true;
+#endif
     Utils::printSerial(F("All sessions invalidated."));
 }
 
@@ -118,48 +233,305 @@ void SessionManager::setBoundSub(const char* sub) {
     strncpy(s_boundSub, sub, sizeof(s_boundSub) - 1);
     s_boundSub[sizeof(s_boundSub) - 1] = '\0';
     s_hasBoundSub = (s_boundSub[0] != '\0');
+    ResponseCache::invalidate();  // /ping and /api/device report isBound
 }
 
-// ── Challenge management ──────────────────────────────────────────────────────
+// ── Challenge nonces ──────────────────────────────────────────────────────────
 
-const char* SessionManager::getCurrentChallenge() {
-    updateChallenge();
-    return s_challengeString;
-}
+const char* SessionManager::issueChallenge(uint32_t clientIp) {
+    const unsigned long now = millis();
 
-void SessionManager::updateChallenge() {
-    const unsigned long now      = millis();
-    const bool         rollover  = (now < s_challengeGeneratedTime);
-    const bool         stale     = (!rollover) &&
-                                   ((now - s_challengeGeneratedTime) >= CHALLENGE_REFRESH_INTERVAL);
-    if (rollover || stale) {
-        generateChallengeString();
-        s_challengeGeneratedTime = now;
-        Utils::printSerial(F("\nChallenge refreshed: "), s_challengeString);
+    // Same client → reuse its slot; otherwise a free or expired slot; else the oldest
+    uint8_t       pick      = 0;
+    unsigned long pickAge   = 0;
+    bool          pickFree  = false;
+    for (uint8_t i = 0; i < Config::CHALLENGE_SLOTS; i++) {
+        ChallengeSlot& c   = s_challenges[i];
+        unsigned long  age = now - c.issuedAt;
+        bool           free = (c.nonce[0] == '\0') || age >= Config::CHALLENGE_TTL_MS;
+        if (!free && c.clientIp == clientIp) { pick = i; break; }
+        if (pickFree) continue;
+        if (free) { pick = i; pickFree = true; continue; }
+        if (age >= pickAge) { pick = i; pickAge = age; }
     }
+
+    ChallengeSlot& slot = s_challenges[pick];
+    slot.nonce[0] = (char)('0' + pick);
+    TokenGenerator::fillAlphanumeric(slot.nonce + 1, 7);
+    slot.nonce[8] = '\0';
+    slot.clientIp = clientIp;
+    slot.issuedAt = now;
+    return slot.nonce;
+}
+
+SessionManager::ChallengeSlot* SessionManager::findChallenge(const char* challenge) {
+    uint8_t idx = (uint8_t)(challenge[0] - '0');
+    if (idx >= Config::CHALLENGE_SLOTS || strnlen(challenge, 9) != 8) return nullptr;
+
+    ChallengeSlot& slot = s_challenges[idx];
+    if (slot.nonce[0] == '\0' || (millis() - slot.issuedAt) >= Config::CHALLENGE_TTL_MS) return nullptr;
+    if (!Utils::constantTimeEquals((const uint8_t*)slot.nonce, (const uint8_t*)challenge, 8)) return nullptr;
+    return &slot;
+}
+
+bool SessionManager::checkChallenge(const char* challenge) {
+    return findChallenge(challenge) != nullptr;
+}
+
+void SessionManager::redeemChallenge(const char* challenge) {
+    ChallengeSlot* slot = findChallenge(challenge);
+    if (slot) slot->nonce[0] = '\0';
 }
 
 // ── Private helpers ───────────────────────────────────────────────────────────
 
-void SessionManager::generateSessionToken(char* buf, size_t bufLen) {
-    if (bufLen < 41) return;
-    snprintf(buf, 9, "%08lX", millis());
-    for (int i = 0; i < 16; i++) {
-        snprintf(buf + 8 + i * 2, 3, "%02X", (uint8_t)random(256));
+#if FEATURE_STATELESS_SESSIONS_ENABLED
+uint32_t SessionManager::clockSeconds() {
+    unsigned long now = millis();
+    s_clockMs        += (unsigned long)(now - s_clockLastMillis);
+    s_clockLastMillis = now;
+    return (uint32_t)(s_clockMs / 1000);
+}
+
+void SessionManager::rotateSecret() {
+    TokenGenerator::fillRandom(s_secret, sizeof(s_secret));
+    // Sub tags change with the secret, and every old token is dead anyway
+    s_revokedMask   = 0;
+    s_revokedBefore = 0;
+}
+
+void SessionManager::mintToken(const char* sub, uint8_t* token) {
+    uint32_t issued = clockSeconds();
+    token[0] = (uint8_t)(issued >> 24);
+    token[1] = (uint8_t)(issued >> 16);
+    token[2] = (uint8_t)(issued >> 8);
+    token[3] = (uint8_t)issued;
+
+    uint8_t digest[Hmac::SHA256_LEN];
+    Hmac::sha256(s_secret, sizeof(s_secret),
+                 reinterpret_cast<const uint8_t*>(sub), strlen(sub), nullptr, 0, digest);
+    memcpy(token + 4, digest, 4);
+
+    computeTokenMac(token, token + 8);
+}
+
+void SessionManager::computeTokenMac(const uint8_t* token, uint8_t* mac) {
+    uint32_t issued = ((uint32_t)token[0] << 24) | ((uint32_t)token[1] << 16) |
+                      ((uint32_t)token[2] << 8)  |  (uint32_t)token[3];
+    uint32_t expiry = issued + Config::SESSION_EXPIRY_SECONDS;
+    const uint8_t expiryBE[4] = {
+        (uint8_t)(expiry >> 24), (uint8_t)(expiry >> 16), (uint8_t)(expiry >> 8), (uint8_t)expiry
+    };
+
+    uint8_t digest[Hmac::SHA256_LEN];
+    Hmac::sha256(s_secret, sizeof(s_secret), token, 8, expiryBE, sizeof(expiryBE), digest);
+    memcpy(mac, digest, Config::SESSION_TOKEN_BYTES - 8);
+}
+
+bool SessionManager::verifyToken(const uint8_t* token, uint32_t& ageSec) {
+    uint8_t mac[Config::SESSION_TOKEN_BYTES - 8];
+    computeTokenMac(token, mac);
+    if (!Utils::constantTimeEquals(mac, token + 8, sizeof(mac))) return false;
+    if (isRevoked(token)) return false;
+
+    uint32_t issued = ((uint32_t)token[0] << 24) | ((uint32_t)token[1] << 16) |
+                      ((uint32_t)token[2] << 8)  |  (uint32_t)token[3];
+    uint32_t now = clockSeconds();
+    if (issued > now) return false;
+    ageSec = now - issued;
+    return ageSec < Config::SESSION_EXPIRY_SECONDS;
+}
+
+void SessionManager::cacheToken(const uint8_t* token, uint32_t ageSec) {
+    int idx = findFreeOrOldestSlot();
+    SessionEntry& slot = s_sessions[idx];
+    slot.sub[0] = '\0';  // not recoverable from the token; only the tag is
+    memcpy(slot.token, token, sizeof(slot.token));
+    // Back-date so the cached entry expires together with the token
+    slot.createdAtMillis = millis() - ageSec * 1000UL;
+    slot.valid           = true;
+    s_liveMask |= (uint8_t)(1u << idx);
+    refreshOldest();
+#if FEATURE_SESSION_PERSIST_ENABLED
+    s_snapshotDirty = true;
+#endif
+}
+
+static uint32_t readBE32(const uint8_t* p) {
+    return ((uint32_t)p[0] << 24) | ((uint32_t)p[1] << 16) | ((uint32_t)p[2] << 8) | (uint32_t)p[3];
+}
+
+void SessionManager::revokeOlderTokens(const uint8_t* newest) {
+    const uint32_t tag = readBE32(newest + 4);
+
+    // Same sub first, then a free entry, then the one with the oldest cut-off
+    int slot = -1;
+    for (uint8_t i = 0; i < Config::SESSION_REVOKE_SLOTS; i++) {
+        bool used = s_revokedMask & (1u << i);
+        if (used && s_revoked[i].subTag == tag) { slot = i; break; }
+        if (slot < 0 && !used) slot = i;
+    }
+    if (slot < 0) {
+        slot = 0;
+        for (uint8_t i = 1; i < Config::SESSION_REVOKE_SLOTS; i++) {
+            if (s_revoked[i].notBefore < s_revoked[slot].notBefore) slot = i;
+        }
+        // The evicted sub keeps its cut-off through the global floor
+        if (s_revoked[slot].notBefore > s_revokedBefore) s_revokedBefore = s_revoked[slot].notBefore;
+    }
+
+    RevokeEntry& e = s_revoked[slot];
+    e.subTag    = tag;
+    e.notBefore = readBE32(newest);
+    s_revokedMask |= (uint8_t)(1u << slot);
+
+    // Cached copies of superseded tokens would otherwise still match
+    for (uint8_t i = 0; i < Config::MAX_SESSIONS; i++) {
+        if ((s_liveMask & (1u << i)) && isRevoked(s_sessions[i].token)) {
+            s_sessions[i].valid = false;
+            s_liveMask &= (uint8_t)~(1u << i);
+        }
+    }
+}
+
+bool SessionManager::isRevoked(const uint8_t* token) {
+    const uint32_t issued = readBE32(token);
+    if (issued < s_revokedBefore) return true;
+
+    const uint32_t tag = readBE32(token + 4);
+    for (uint8_t i = 0; i < Config::SESSION_REVOKE_SLOTS; i++) {
+        if (!(s_revokedMask & (1u << i)) || s_revoked[i].subTag != tag) continue;
+        return issued < s_revoked[i].notBefore;
+    }
+    return false;
+}
+#endif
+
+#if FEATURE_SESSION_PERSIST_ENABLED
+void SessionManager::saveSnapshot() {
+    static SessionSnapshot snap;  // static: keeps ~370 bytes off the cont stack
+    memset(&snap, 0, sizeof(snap));
+    snap.magic = SNAPSHOT_MAGIC;
+
+    const unsigned long now = millis();
+    for (uint8_t i = 0; i < Config::MAX_SESSIONS; i++) {
+        if (!(s_liveMask & (1u << i))) continue;
+        const SessionEntry& e = s_sessions[i];
+        unsigned long age = now - e.createdAtMillis;
+        if (age >= Config::SESSION_EXPIRY_MS) continue;
+
+        auto& out = snap.slots[snap.count++];
+        memcpy(out.token, e.token, sizeof(out.token));
+        out.remainingSec = (uint32_t)((Config::SESSION_EXPIRY_MS - age) / 1000);
+        if (strlen(e.sub) < sizeof(out.sub)) strcpy(out.sub, e.sub);
     }
-    buf[40] = '\0';
+#if FEATURE_STATELESS_SESSIONS_ENABLED
+    snap.clockSec = clockSeconds();
+    memcpy(snap.secret, s_secret, sizeof(snap.secret));
+    snap.revokedBefore = s_revokedBefore;
+    snap.revokedMask   = s_revokedMask;
+    for (uint8_t i = 0; i < Config::SESSION_REVOKE_SLOTS; i++) {
+        snap.revoked[i][0] = s_revoked[i].subTag;
+        snap.revoked[i][1] = s_revoked[i].notBefore;
+    }
+#endif
+    snap.crc = Utils::crc32(&snap.count, sizeof(snap) - offsetof(SessionSnapshot, count));
+
+#if defined(ARDUINO_ARCH_ESP8266)
+    ESP.rtcUserMemoryWrite(Config::RTC_SESSION_OFFSET_BLOCKS,
+                           reinterpret_cast<uint32_t*>(&snap), sizeof(snap));
+#elif defined(ARDUINO_ARCH_ESP32)
+    memcpy(&s_rtcSnapshot, &snap, sizeof(snap));
+#endif
+
+    s_snapshotDirty = false;
+    s_lastSnapshot  = now;
 }
 
-// Fills s_challengeString with 8 random alphanumeric chars + NUL.
-// No heap allocation — operates entirely on the static char array.
-void SessionManager::generateChallengeString() {
-    static const char kCharset[] =
-        "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789";
-    static const int  kCharsetLen = sizeof(kCharset) - 1; // 62
-    for (int i = 0; i < 8; i++) {
-        s_challengeString[i] = kCharset[random(kCharsetLen)];
+uint8_t SessionManager::restoreSnapshot() {
+    // Cold boots leave RTC memory as garbage — don't even look at it
+#if defined(ARDUINO_ARCH_ESP8266)
+    const uint32_t reason = ESP.getResetInfoPtr()->reason;
+    if (reason == REASON_DEFAULT_RST || reason == REASON_EXT_SYS_RST) return 0;
+#elif defined(ARDUINO_ARCH_ESP32)
+    if (esp_reset_reason() == ESP_RST_POWERON) return 0;
+#endif
+
+    static SessionSnapshot snap;
+#if defined(ARDUINO_ARCH_ESP8266)
+    if (!ESP.rtcUserMemoryRead(Config::RTC_SESSION_OFFSET_BLOCKS,
+                               reinterpret_cast<uint32_t*>(&snap), sizeof(snap))) return 0;
+#elif defined(ARDUINO_ARCH_ESP32)
+    memcpy(&snap, &s_rtcSnapshot, sizeof(snap));
+#endif
+
+    if (snap.magic != SNAPSHOT_MAGIC || snap.count > Config::MAX_SESSIONS) return 0;
+    if (snap.crc != Utils::crc32(&snap.count, sizeof(snap) - offsetof(SessionSnapshot, count))) return 0;
+
+    // The snapshot can be up to one refresh interval old; count that time as
+    // spent so restored sessions never outlive their original deadline.
+    constexpr uint32_t kStaleSec = Config::SESSION_SNAPSHOT_INTERVAL_MS / 1000;
+
+#if FEATURE_STATELESS_SESSIONS_ENABLED
+    memcpy(s_secret, snap.secret, sizeof(s_secret));
+    s_revokedBefore = snap.revokedBefore;
+    s_revokedMask   = snap.revokedMask;
+    for (uint8_t i = 0; i < Config::SESSION_REVOKE_SLOTS; i++) {
+        s_revoked[i].subTag    = snap.revoked[i][0];
+        s_revoked[i].notBefore = snap.revoked[i][1];
+    }
+    s_clockMs         = ((uint64_t)snap.clockSec + kStaleSec) * 1000ULL;
+    s_clockLastMillis = millis();
+#endif
+
+    const unsigned long now = millis();
+    uint8_t restored = 0;
+    for (uint8_t i = 0; i < snap.count; i++) {
+        const auto& in = snap.slots[i];
+        if (in.remainingSec <= kStaleSec) continue;
+        unsigned long remainingMs = (unsigned long)(in.remainingSec - kStaleSec) * 1000UL;
+
+        SessionEntry& e = s_sessions[restored];
+        memcpy(e.token, in.token, sizeof(e.token));
+        memcpy(e.sub, in.sub, sizeof(in.sub));
+        e.sub[sizeof(in.sub) - 1] = '\0';
+        e.createdAtMillis = now - (Config::SESSION_EXPIRY_MS - remainingMs);
+        e.valid           = true;
+        s_liveMask |= (uint8_t)(1u << restored);
+        restored++;
+    }
+    refreshOldest();
+    return restored;
+}
+#endif
+
+void SessionManager::pruneExpired() {
+    if (!s_liveMask || (millis() - s_oldestCreated) < Config::SESSION_EXPIRY_MS) return;
+
+    for (uint8_t i = 0; i < Config::MAX_SESSIONS; i++) {
+        if ((s_liveMask & (1u << i)) && isSlotExpired(s_sessions[i])) {
+            s_sessions[i].valid = false;
+            s_liveMask &= (uint8_t)~(1u << i);
+        }
+    }
+    refreshOldest();
+#if FEATURE_SESSION_PERSIST_ENABLED
+    s_snapshotDirty = true;
+#endif
+}
+
+void SessionManager::refreshOldest() {
+    // Compare ages rather than timestamps so millis() rollover is harmless
+    const unsigned long now = millis();
+    unsigned long oldestAge = 0;
+    for (uint8_t i = 0; i < Config::MAX_SESSIONS; i++) {
+        if (!(s_liveMask & (1u << i))) continue;
+        unsigned long age = now - s_sessions[i].createdAtMillis;
+        if (age >= oldestAge) {
+            oldestAge       = age;
+            s_oldestCreated = s_sessions[i].createdAtMillis;
+        }
     }
-    s_challengeString[8] = '\0';
 }
 
 int SessionManager::findSlotBySub(const char* sub) {
@@ -174,12 +546,15 @@ int SessionManager::findFreeOrOldestSlot() {
     for (uint8_t i = 0; i < Config::MAX_SESSIONS; i++) {
         if (!s_sessions[i].valid || isSlotExpired(s_sessions[i])) return (int)i;
     }
-    // All slots occupied — evict the oldest
+    // All slots occupied — evict the oldest.  Compare ages, not timestamps:
+    // restored and cached slots are back-dated and may sit across a rollover.
+    const unsigned long now = millis();
     int   oldest     = 0;
-    unsigned long min = s_sessions[0].createdAtMillis;
+    unsigned long maxAge = now - s_sessions[0].createdAtMillis;
     for (uint8_t i = 1; i < Config::MAX_SESSIONS; i++) {
-        if (s_sessions[i].createdAtMillis < min) {
-            min    = s_sessions[i].createdAtMillis;
+        unsigned long age = now - s_sessions[i].createdAtMillis;
+        if (age > maxAge) {
+            maxAge = age;
             oldest = (int)i;
         }
     }
@@ -8,13 +8,13 @@
 // Fixed-size char arrays avoid heap fragmentation on ESP8266.
 struct SessionEntry {
     char          sub[64];            // subject identifier (JWT "sub" or "family")
-    char          token[41];          // 40 hex-char opaque session token + NUL
+    uint8_t       token[Config::SESSION_TOKEN_BYTES];  // raw token (hex-encoded on the wire)
     unsigned long createdAtMillis;    // millis() at creation — used for 1-week expiry
     bool          valid;
 
     SessionEntry() : createdAtMillis(0), valid(false) {
-        sub[0]   = '\0';
-        token[0] = '\0';
+        sub[0] = '\0';
+        memset(token, 0, sizeof(token));
     }
 };
 
@@ -22,10 +22,19 @@ struct SessionEntry {
 //
 // Policy summary:
 //   • Up to MAX_SESSIONS (5) active sessions kept purely in RAM — cleared on reboot.
-//   • Each slot is keyed by "sub"; re-login for the same sub replaces that slot.
-//   • Session tokens expire after SESSION_EXPIRY_MS (1 week) or on reboot.
-//   • The "bound JWT" (first successful login) is persisted to flash so the
-//     embedded sub can be re-verified on every boot (signature check only).
+//   • With FEATURE_STATELESS_SESSIONS_ENABLED the token itself is the session:
+//     issue time + sub tag + truncated HMAC under a per-boot secret.  Any
+//     number of clients stay logged in; the slots only cache recent tokens.
+//   • Each slot is keyed by "sub"; re-login for the same sub replaces that slot
+//     and so ends the previous session.  Stateless tokens outlive their slot,
+//     so re-login also records a per-sub not-before time that verifyToken
+//     checks (see RevokeEntry).
+//   • Session tokens expire after SESSION_EXPIRY_MS (1 week) or on power loss;
+//     with FEATURE_SESSION_PERSIST_ENABLED they survive soft reboots through
+//     an RTC-memory snapshot refreshed from tick().
+//   • The "bound JWT" (first successful login) is persisted to flash with an
+//     HMAC tag; boot restores the sub when the tag matches and re-checks the
+//     signature only when it does not (see AuthManager::tick()).
 //
 class SessionManager {
 public:
@@ -39,7 +48,8 @@ public:
 
     /**
      * @brief Run deferred tasks from loop() — writes bound token to flash when
-     *        a bind is pending (avoids LittleFS stack overflow in HTTP handler).
+     *        a bind is pending (avoids LittleFS stack overflow in HTTP handler)
+     *        and refreshes the RTC session snapshot.
      */
     static void tick();
 
@@ -54,10 +64,14 @@ public:
     static String createSession(const char* sub);
 
     /**
-     * @brief Validate an opaque session token against all active slots.
+     * @brief Validate an opaque session token against the live slots.
+     *        The hex token is decoded in place and compared in constant time;
+     *        expired slots are pruned lazily, so only live slots are visited.
+     * @param sessionToken Hex token (need not be NUL-terminated)
+     * @param len          Length of @p sessionToken in characters
      * @return true if a matching, non-expired slot exists.
      */
-    static bool validateSession(const char* sessionToken);
+    static bool validateSession(const char* sessionToken, size_t len);
 
     /**
      * @brief Invalidate all active in-RAM sessions (logout-all / factory reset).
@@ -89,25 +103,48 @@ public:
      */
     static void setBoundSub(const char* sub);
 
-    // ── Challenge management ──────────────────────────────────────────────────
+    // ── Challenge nonces ──────────────────────────────────────────────────────
 
-    /** @return Current challenge C-string (8 chars + NUL), refreshed automatically. */
-    static const char* getCurrentChallenge();
+    /**
+     * @brief Issue a fresh challenge nonce (8 chars + NUL) for @p clientIp.
+     *        A client asking again replaces its own outstanding nonce, so one
+     *        client cannot push other clients' nonces out of the ring.
+     * @return The nonce; valid until the next issueChallenge() call
+     */
+    static const char* issueChallenge(uint32_t clientIp);
+
+    /**
+     * @return true if @p challenge is outstanding and younger than
+     *         Config::CHALLENGE_TTL_MS.  O(1): the first character names the slot.
+     */
+    static bool checkChallenge(const char* challenge);
 
-    /** @brief Refresh challenge if the refresh interval has elapsed. */
-    static void updateChallenge();
+    /** @brief Retire @p challenge so it cannot be used again. */
+    static void redeemChallenge(const char* challenge);
 
 private:
     static SessionEntry  s_sessions[Config::MAX_SESSIONS];
 
+    // Live-slot index: bit i set ⇔ s_sessions[i].valid.  All sessions share
+    // one lifetime, so nothing can expire before the oldest live slot does —
+    // pruneExpired() only walks the table once that deadline has passed.
+    static uint8_t       s_liveMask;
+    static unsigned long s_oldestCreated;  // createdAtMillis of the oldest live slot
+    static_assert(Config::MAX_SESSIONS <= 8, "s_liveMask holds one bit per slot");
+
     // Bound identity (populated from flash at boot by AuthManager)
     static char s_boundSub[64];
     static bool s_hasBoundSub;
 
-    // Challenge — 8-char alphanumeric + NUL  (no heap allocation)
-    static char          s_challengeString[9];
-    static unsigned long s_challengeGeneratedTime;
-    static const unsigned long CHALLENGE_REFRESH_INTERVAL = 300000UL; // 5 min
+    // Challenge ring — one nonce per recent client, each redeemed at most once.
+    // nonce[0] is the slot digit, so lookup never scans the ring.
+    struct ChallengeSlot {
+        char          nonce[9];   // slot digit + 7 random alphanumerics + NUL, "" = free
+        uint32_t      clientIp;   // IPv4 of the client it was issued to
+        unsigned long issuedAt;   // millis() at issue
+    };
+    static ChallengeSlot s_challenges[Config::CHALLENGE_SLOTS];
+    static_assert(Config::CHALLENGE_SLOTS <= 10, "slot index is one decimal digit");
 
     // Deferred flash write for bound JWT — fixed-size buffers prevent fragmentation
     static bool s_pendingBind;
@@ -116,11 +153,81 @@ private:
 
     // ── Helpers ───────────────────────────────────────────────────────────────
 
-    /** Fill @p buf (41 bytes) with a new 40-character hex session token. */
-    static void generateSessionToken(char* buf, size_t bufLen);
+#if FEATURE_STATELESS_SESSIONS_ENABLED
+    // Stateless token layout (SESSION_TOKEN_BYTES):
+    //   [0..3]  issue time, session-clock seconds, big-endian
+    //   [4..7]  sub tag   = HMAC(secret, sub)[0..3]
+    //   [8..19] MAC       = HMAC(secret, token[0..7] || expiry BE)[0..11]
+    static uint8_t       s_secret[32];
+    static uint64_t      s_clockMs;          // session clock, ms since this boot
+    static unsigned long s_clockLastMillis;
+
+    /** @return Session-clock seconds; rollover-safe while called every < 49 days. */
+    static uint32_t clockSeconds();
+
+    /** Replace s_secret with fresh hardware randomness (revokes every token). */
+    static void rotateSecret();
+
+    /** Fill @p token with a stateless token for @p sub issued now. */
+    static void mintToken(const char* sub, uint8_t* token);
+
+    /** Compute the 12-byte MAC field for the issue time + sub tag in @p token. */
+    static void computeTokenMac(const uint8_t* token, uint8_t* mac);
+
+    /**
+     * @brief Verify a stateless token's MAC and lifetime.
+     * @param ageSec Receives the token age in seconds on success
+     */
+    static bool verifyToken(const uint8_t* token, uint32_t& ageSec);
+
+    /** Remember a verified token in a slot so its next use skips the HMAC. */
+    static void cacheToken(const uint8_t* token, uint32_t ageSec);
+
+    // Re-login cut-off per sub tag: tokens of that sub issued before its
+    // newest one are revoked (a token is a function of sub and issue second,
+    // so a re-login within the same second mints the very same token).  The
+    // table is small — evicting an entry raises s_revokedBefore to its time,
+    // so running out of entries revokes too much (everyone logs in again),
+    // never too little.
+    struct RevokeEntry {
+        uint32_t subTag;     // token[4..7] of the newest token for the sub
+        uint32_t notBefore;  // issue time of that token
+    };
+    static RevokeEntry s_revoked[Config::SESSION_REVOKE_SLOTS];
+    static uint8_t     s_revokedMask;    // bit i set ⇔ s_revoked[i] in use
+    static uint32_t    s_revokedBefore;  // tokens issued earlier are revoked for every sub
+    static_assert(Config::SESSION_REVOKE_SLOTS <= 8, "s_revokedMask holds one bit per entry");
+
+    /** Make @p newest the only live token of its sub; drops stale cached copies. */
+    static void revokeOlderTokens(const uint8_t* newest);
+
+    /** @return true if a later login of the same sub superseded @p token. */
+    static bool isRevoked(const uint8_t* token);
+#endif
+
+#if FEATURE_SESSION_PERSIST_ENABLED
+    static bool          s_snapshotDirty;
+    static unsigned long s_lastSnapshot;
+
+    /** Write the live slots (and stateless secret/clock) to RTC memory. */
+    static void saveSnapshot();
+
+    /**
+     * @brief Reload sessions from the RTC snapshot after a soft reboot.
+     *        Ignored after power-on or if the magic / CRC do not match.
+     * @return Number of sessions restored
+     */
+    static uint8_t restoreSnapshot();
+#endif
+
+    /** Drop expired slots from s_liveMask and recompute s_oldestCreated. */
+    static void pruneExpired();
+
+    /** Recompute s_oldestCreated from the live slots. */
+    static void refreshOldest();
 
-    /** Fill s_challengeString (8 chars + NUL) with random alphanumeric chars. */
-    static void generateChallengeString();
+    /** @return Slot named by @p challenge if it is live and unexpired, else nullptr. */
+    static ChallengeSlot* findChallenge(const char* challenge);
 
     /** Index of slot whose sub matches @p sub, or -1. */
     static int findSlotBySub(const char* sub);
@@ -13,11 +13,17 @@ namespace Config {
 
     // EC P-256 public key (PEM) — used to verify JWT signatures
     // Stored once here; all TUs reference this single copy via the extern decl.
+    // A build can supply its own with -D JWT_PUB_KEY_HEADER='"file.h"', a
+    // header that defines JWT_PUB_KEY (the host build signs with a test key).
+#ifdef JWT_PUB_KEY_HEADER
+    #include JWT_PUB_KEY_HEADER
+#else
     const char JWT_PUB_KEY[] =
         "-----BEGIN PUBLIC KEY-----\n"
         "MFkwEwYHKoZIzj0CAQYIKoZIzj0DAQcDQgAEIAnXvd2yBqvGfsjTi4cAQ0hYkaRi\n"
         "/MqU8VSHyIBzErl8L2A2SERAXb6Epvjv4Zb5nu78LiIfkuB6gJvMj/fUrA==\n"
         "-----END PUBLIC KEY-----";
+#endif
 
     // ── LittleFS file paths ───────────────────────────────────────────────────
     const char WIFI_CONFIG_FILE[]        = "/WiFiConfig.bin";
@@ -26,6 +32,12 @@ namespace Config {
     const char SESSION_FILE[]            = "/Session.json";
     const char BOUND_TOKEN_FILE[]        = "/BoundToken.bin";
     const char SLEEP_CONFIG_FILE[]       = "/SleepConfig.bin";
+    const char DEVICE_SECRET_FILE[]      = "/DeviceSecret.bin";
+    const char BOUND_TAG_FILE[]          = "/BoundToken.tag";
+    const char JWT_KEYS_FILE[]           = "/JwtKeys.bin";
+    const char RECORD_STORE_FILE[]       = "/Config.log";
+    const char RECORD_STORE_TMP_FILE[]   = "/Config.log.tmp";
+    const char IR_LIBRARY_FILE[]         = "/IrLibrary.bin";
 
 } // namespace Config
 
@@ -48,11 +48,18 @@ namespace Config {
     constexpr uint8_t  RECV_TIMEOUT_SEC     = 8;
     constexpr uint8_t  WIRELESS_TIMEOUT_SEC = 20;
     constexpr uint8_t  IR_TIMEOUT_MS        = 50;
+    constexpr uint16_t GPIO_FLUSH_QUIET_MS  = 3000;  // persist GPIO state once changes stop
 
     // ── Session ───────────────────────────────────────────────────────────
     constexpr unsigned long SESSION_EXPIRY_SECONDS = 604800UL;       // 1 week
     constexpr unsigned long SESSION_EXPIRY_MS      = 604800000UL;    // 1 week (millis)
     constexpr uint8_t       MAX_SESSIONS           = 5;
+    constexpr uint8_t       SESSION_TOKEN_BYTES    = 20;             // 40 hex chars on the wire
+    constexpr uint8_t       SESSION_REVOKE_SLOTS   = 4;              // stateless: subs with a re-login cut-off
+    constexpr unsigned long SESSION_SNAPSHOT_INTERVAL_MS = 60000UL;  // RTC snapshot refresh
+    constexpr uint32_t      RTC_SESSION_OFFSET_BLOCKS    = 32;       // ESP8266: skip eboot's first 128 bytes
+    constexpr uint8_t       CHALLENGE_SLOTS        = 8;              // outstanding /ping nonces (≤ 10)
+    constexpr unsigned long CHALLENGE_TTL_MS       = 300000UL;       // nonce lifetime (5 min)
 
     // ── Serial ────────────────────────────────────────────────────────────
     constexpr uint32_t BAUD_RATE             = 115200;
@@ -65,6 +72,14 @@ namespace Config {
     constexpr uint8_t  MIN_UNKNOWN_SIZE    = 12;
     // Maximum number of raw IR entries to send (prevents 2 KB VLA on stack)
     constexpr uint16_t IR_RAW_SEND_MAX     = 512;
+    // Stored IR code library: fixed slots of header + payload in IR_LIBRARY_FILE
+    constexpr uint8_t  IR_LIBRARY_SLOTS      = 32;
+    constexpr uint16_t IR_LIBRARY_CODE_BYTES = IR_RAW_SEND_MAX * 2;  // a full raw timing array
+    // Transmit queue (/api/ir/queue): waiting jobs, payload bytes they share,
+    // and finished-job results kept for polling
+    constexpr uint8_t  IR_TX_QUEUE_DEPTH     = 8;
+    constexpr uint16_t IR_TX_QUEUE_BYTES     = IR_LIBRARY_CODE_BYTES * 2;
+    constexpr uint8_t  IR_TX_STATUS_SLOTS    = 16;
 
     // ── Camera (ESP32 only) ───────────────────────────────────────────────
     constexpr uint32_t CAMERA_XCLK_FREQ_HZ = 20000000; // 20 MHz
@@ -83,10 +98,44 @@ namespace Config {
 
     // ── Protocol ──────────────────────────────────────────────────────────
     constexpr uint16_t MAX_REQUEST_LENGTH = 5120;
-
-    // ── Rate limiting ─────────────────────────────────────────────────────
-    constexpr uint8_t  RATE_LIMIT_MAX_REQUESTS = 2;      // max requests per window
-    constexpr uint32_t RATE_LIMIT_WINDOW_MS     = 1000;  // sliding window duration (ms)
+    // Largest binary response (status line + headers + body) written to the
+    // socket in one call; bigger bodies continue in TCP_MSS_BYTES slices.
+    constexpr uint16_t TCP_MSS_BYTES      = 1460;
+    constexpr uint8_t  BATCH_MAX_COMMANDS = 16;    // sub-commands per /api/batch
+    constexpr uint16_t BATCH_MAX_DELAY_MS = 2000;  // clamp for a single inter-command delay
+    // Sum of (clamped) delays one batch may ask for — delay() blocks loop(),
+    // so longer sequences are rejected and belong in several batches.
+    constexpr uint16_t BATCH_MAX_TOTAL_DELAY_MS = 3000;
+
+    // ── Rate limiting (per-client token bucket) ───────────────────────────
+    // Each client IP gets a bucket of RATE_LIMIT_BUCKET_CAPACITY tokens that
+    // refills at RATE_LIMIT_REFILL_PER_SEC; every route spends its cost.  When
+    // the table is busy, clients without a slot share one overflow bucket.
+    constexpr uint8_t  RATE_LIMIT_CLIENTS         = 8;      // tracked client IPs (static table)
+    constexpr uint16_t RATE_LIMIT_BUCKET_CAPACITY = 10;     // burst size in tokens
+    constexpr uint16_t RATE_LIMIT_REFILL_PER_SEC  = 4;      // tokens regained per second
+    constexpr uint8_t  RATE_COST_CHEAP            = 1;      // /ping, reads served from RAM
+    constexpr uint8_t  RATE_COST_DEFAULT          = 2;      // ordinary protected endpoints
+    constexpr uint8_t  RATE_COST_EXPENSIVE        = 8;      // ES256 verify, WiFi scan, flash format
+
+    // ── Request profiling (FEATURE_REQUEST_PROFILING_ENABLED) ─────────────
+    constexpr uint32_t PROFILE_REPORT_INTERVAL_MS = 10000; // throughput summary period
+
+    // ── Bound identity ────────────────────────────────────────────────────
+    constexpr uint8_t  DEVICE_SECRET_BYTES      = 32;     // HMAC key for the bound-token tag
+    constexpr uint32_t BOUND_VERIFY_DEFER_MS    = 5000;   // idle-time ECDSA check after boot
+
+    // ── JWT verification keys ─────────────────────────────────────────────
+    constexpr uint8_t  JWT_KEY_SLOTS            = 4;      // built-in key + 3 added at runtime
+    constexpr uint8_t  JWT_KID_LEN              = 16;     // "kid" header value, 15 chars + NUL
+
+    // ── Config record store ───────────────────────────────────────────────
+    constexpr uint16_t RECORD_MAX_BYTES         = 1024;   // largest single record payload
+    constexpr uint32_t RECORD_COMPACT_BYTES     = 16384;  // superseded bytes that make compaction due
+    constexpr uint32_t RECORD_COMPACT_IDLE_MS   = 2000;   // quiet time before compacting in loop
+
+    // ── File streaming ────────────────────────────────────────────────────
+    constexpr uint16_t FILE_CHUNK_BYTES         = 128;    // read/write block for streamed files
 
     // ── Flash file paths (extern — single copy in flash via Config.cpp) ───
     extern const char WIFI_CONFIG_FILE[];
@@ -95,6 +144,12 @@ namespace Config {
     extern const char SESSION_FILE[];
     extern const char BOUND_TOKEN_FILE[];
     extern const char SLEEP_CONFIG_FILE[];
+    extern const char DEVICE_SECRET_FILE[];
+    extern const char BOUND_TAG_FILE[];
+    extern const char JWT_KEYS_FILE[];
+    extern const char RECORD_STORE_FILE[];
+    extern const char RECORD_STORE_TMP_FILE[];
+    extern const char IR_LIBRARY_FILE[];
 }
 
 // ================================
@@ -158,6 +213,20 @@ struct GPIOConfigData {
     GPIOConfigData() : count(0) {}
 };
 
+// JWT verification keys added through /api/keys, persisted to JWT_KEYS_FILE.
+// The compiled-in key (Config::JWT_PUB_KEY) is never stored here.
+struct JwtKeyEntry {
+    char    kid[Config::JWT_KID_LEN];  // JWT header "kid", NUL-terminated
+    uint8_t q[65];                     // P-256 public point, 0x04 || X || Y
+};
+
+struct JwtKeyStoreData {
+    uint8_t     count;
+    JwtKeyEntry keys[Config::JWT_KEY_SLOTS - 1];
+
+    JwtKeyStoreData() : count(0) {}
+};
+
 // ── Response message tokens (extern — single definition in Config.cpp) ────────
 namespace ResponseMsg {
     extern const char SUCCESS[];
@@ -45,6 +45,46 @@
     #define FEATURE_SERIAL_LOG_ENABLED 1
 #endif
 
+// Stateless session tokens — tokens carry their issue time and an HMAC tag
+// under a device secret, so any number of clients can hold a valid session.
+// The in-RAM slot table becomes a fast-path cache; invalidating all sessions
+// rotates the secret.  Off: classic table-only sessions (MAX_SESSIONS cap).
+#ifndef FEATURE_STATELESS_SESSIONS_ENABLED
+    #define FEATURE_STATELESS_SESSIONS_ENABLED 0
+#endif
+
+// Keep sessions across soft reboots (restart, OTA, watchdog) by snapshotting
+// the session table into RTC memory.  Power loss still clears them.
+#ifndef FEATURE_SESSION_PERSIST_ENABLED
+    #define FEATURE_SESSION_PERSIST_ENABLED 1
+#endif
+
+// Request profiling — per-request latency, throughput and heap low-water mark
+// printed over serial from the HTTP middleware.  The repeatable baseline for
+// performance work is the host replay (test/host); this covers the device.
+#ifndef FEATURE_REQUEST_PROFILING_ENABLED
+    #define FEATURE_REQUEST_PROFILING_ENABLED 0
+#endif
+
+// Per-route counters and latency histograms served at GET /api/metrics
+#ifndef FEATURE_ROUTE_METRICS_ENABLED
+    #define FEATURE_ROUTE_METRICS_ENABLED 1
+#endif
+
+// Binary responses leave in a single socket write (head + body in one buffer).
+// Set to 0 for the old sendHeader()/send()/sendContent() writer, kept so the
+// host replay can time both (firmware_split_write).
+#ifndef FEATURE_SINGLE_WRITE_RESPONSE_ENABLED
+    #define FEATURE_SINGLE_WRITE_RESPONSE_ENABLED 1
+#endif
+
+// ES256 verify takes u2·Q from a comb table built when a key is loaded
+// (960 bytes of heap per key).  Set to 0 for the generic BearSSL / mbedtls
+// point multiplication and no table (host: auth_bench_no_key_table).
+#ifndef FEATURE_JWT_KEY_TABLE_ENABLED
+    #define FEATURE_JWT_KEY_TABLE_ENABLED 1
+#endif
+
 // ── Debug build — enable verbose internal logging ─────────────────────────────
 // Enable by passing -DDEBUG_BUILD to the compiler (never in production).
 // Exposes hash/signature hex dumps in AuthManager and other diagnostics.
@@ -9,7 +9,9 @@
 // ════════════════════════════════════════════════════════════════════════
 
 #include "../platform/Platform.h"
+#include "../config/Config.h"
 #include "../protocol/BinaryProtocol.h"
+#include "../utils/Utils.h"
 #include <string.h>
 
 // ── CORS (shared with JSON helpers — kept in ResponseHelper.h) ───────────────
@@ -26,36 +28,169 @@ inline void sendCorsHeaders(WebServerType& server) {
 #endif
 
 // ── Send a binary response ───────────────────────────────────────────────────
+//
+// The WebServer send path emits the status line, every sendHeader() call and
+// the body as separate writes, which the ESP8266 lwIP stack turns into several
+// small TCP segments with Nagle / delayed-ACK stalls between them.  Binary
+// responses are instead assembled into one buffer and written to the client
+// directly; only bodies that do not fit in one TCP MSS fall back to slices.
+
+/** @brief Reason phrase for the status codes the REST API emits. */
+inline const char* httpReasonPhrase(int code) {
+    switch (code) {
+        case 200: return "OK";
+        case 202: return "Accepted";
+        case 204: return "No Content";
+        case 400: return "Bad Request";
+        case 401: return "Unauthorized";
+        case 404: return "Not Found";
+        case 409: return "Conflict";
+        case 413: return "Payload Too Large";
+        case 429: return "Too Many Requests";
+        case 500: return "Internal Server Error";
+        case 503: return "Service Unavailable";
+        default:  break;
+    }
+    // Anything else gets its class name rather than a misleading phrase
+    if (code < 300) return "Success";
+    if (code < 400) return "Redirection";
+    if (code < 500) return "Client Error";
+    return "Server Error";
+}
+
+/**
+ * @brief Running total of bytes written by sendBinaryResponse() since boot.
+ *        The route metrics middleware samples it around each handler.
+ */
+inline uint32_t& binaryTxBytes() {
+    static uint32_t total = 0;
+    return total;
+}
+
+// Worst-case size of the response head produced by formatBinaryHead() when no
+// extra headers are passed — used to size prebuilt response buffers.
+constexpr size_t BINARY_HEAD_MAX = 320;
+
+/**
+ * @brief Format the status line and headers of a binary response.
+ * @param buf           Destination buffer
+ * @param cap           Capacity of @p buf
+ * @param code          HTTP status code
+ * @param len           Body length (Content-Length)
+ * @param extraHeaders  Optional pre-formatted header lines, each ending in "\r\n"
+ * @return Head length in bytes, or 0 if it did not fit
+ */
+inline size_t formatBinaryHead(char* buf, size_t cap, int code, size_t len,
+                               const char* extraHeaders = nullptr) {
+    static const char kHead[] PROGMEM =
+        "HTTP/1.1 %d %s\r\n"
+        "Content-Type: application/octet-stream\r\n"
+        "Content-Length: %u\r\n"
+        "Access-Control-Allow-Origin: *\r\n"
+        "Access-Control-Allow-Methods: GET, POST, PUT, DELETE, OPTIONS\r\n"
+        "Access-Control-Allow-Headers: Content-Type, Authorization, Accept\r\n"
+        "Access-Control-Max-Age: 86400\r\n"
+        "Connection: close\r\n"
+        "%s\r\n";
+
+    int headLen = snprintf_P(buf, cap, kHead, code, httpReasonPhrase(code),
+                             (unsigned)len, extraHeaders ? extraHeaders : "");
+    if (headLen <= 0 || (size_t)headLen >= cap) return 0;
+    return (size_t)headLen;
+}
+
+/**
+ * @brief Write a complete, already formatted HTTP response (head + body)
+ *        to the client in one call.  Used for responses cached as wire bytes.
+ */
+inline void sendPreparedResponse(WebServerType& server, const void* wire, size_t len) {
+    WiFiClient& client = server.client();
+    client.setNoDelay(true);
+    client.write(reinterpret_cast<const uint8_t*>(wire), len);
+    binaryTxBytes() += (uint32_t)len;
+}
 
 /**
  * @brief Send a packed binary struct as the HTTP response body.
- * @param server  WebServer instance
- * @param code    HTTP status code
- * @param data    Pointer to packed struct data
- * @param len     Size of data in bytes
+ * @param server        WebServer instance
+ * @param code          HTTP status code
+ * @param data          Pointer to packed struct data
+ * @param len           Size of data in bytes
+ * @param extraHeaders  Optional pre-formatted header lines, each ending in "\r\n"
  */
 inline void sendBinaryResponse(WebServerType& server, int code,
-                                const void* data, size_t len) {
+                                const void* data, size_t len,
+                                const char* extraHeaders = nullptr) {
+#if !FEATURE_SINGLE_WRITE_RESPONSE_ENABLED
+    // Old writer: status line + headers, then the body, as separate writes
     sendCorsHeaders(server);
+    for (const char* line = extraHeaders; line && *line; ) {
+        const char* colon = strchr(line, ':');
+        const char* end   = strstr(line, "\r\n");
+        if (!colon || !end || colon > end) break;
+        const char* value = colon + 1;
+        while (*value == ' ') value++;
+        server.sendHeader(String(line).substring(0, colon - line),
+                          String(value).substring(0, end - value));
+        line = end + 2;
+    }
     server.setContentLength(len);
     server.send(code, F("application/octet-stream"), "");
     server.sendContent(reinterpret_cast<const char*>(data), len);
+    binaryTxBytes() += (uint32_t)len;  // body only: the core formats the head
+#else
+    // Static: ESP8266 cont stack is ~4 KB and responses are serial.
+    static char txBuf[Config::TCP_MSS_BYTES];
+
+    size_t headLen = formatBinaryHead(txBuf, sizeof(txBuf), code, len, extraHeaders);
+    if (headLen == 0 && extraHeaders) {
+        // Oversized extra headers: still answer, just without them
+        Utils::printSerial(F("Response headers too long, sending without extras"));
+        headLen = formatBinaryHead(txBuf, sizeof(txBuf), code, len);
+    }
+    if (headLen == 0) {
+        // Never leave the client waiting for a response that will not come
+        Utils::printSerial(F("Response head does not fit, closing connection"));
+        server.client().stop();
+        return;
+    }
+
+    const uint8_t* body = reinterpret_cast<const uint8_t*>(data);
+    size_t first = sizeof(txBuf) - headLen;
+    if (first > len) first = len;
+    memcpy(txBuf + headLen, body, first);
+
+    WiFiClient& client = server.client();
+    client.setNoDelay(true);
+    client.write(reinterpret_cast<const uint8_t*>(txBuf), headLen + first);
+
+    // Oversized bodies: remaining bytes straight from the caller's buffer
+    for (size_t off = first; off < len; off += Config::TCP_MSS_BYTES) {
+        size_t n = len - off;
+        if (n > Config::TCP_MSS_BYTES) n = Config::TCP_MSS_BYTES;
+        client.write(body + off, n);
+    }
+
+    binaryTxBytes() += (uint32_t)(headLen + len);
+#endif
 }
 
 /**
  * @brief Send a binary error response (BinErrorResponse struct).
- * @param server  WebServer instance
- * @param code    HTTP status code
- * @param status  BinStatus enum value
- * @param message Error message string
+ * @param server       WebServer instance
+ * @param code         HTTP status code
+ * @param status       BinStatus enum value
+ * @param message      Error message string
+ * @param extraHeaders Optional pre-formatted header lines (see sendBinaryResponse)
  */
 inline void sendBinaryError(WebServerType& server, int code,
-                             uint8_t status, const char* message) {
+                             uint8_t status, const char* message,
+                             const char* extraHeaders = nullptr) {
     BinErrorResponse resp;
     resp.status = status;
     memset(resp.error, 0, sizeof(resp.error));
     strncpy(resp.error, message, sizeof(resp.error) - 1);
-    sendBinaryResponse(server, code, &resp, sizeof(resp));
+    sendBinaryResponse(server, code, &resp, sizeof(resp), extraHeaders);
 }
 
 // ── Read binary request body ─────────────────────────────────────────────────
@@ -108,6 +243,26 @@ inline size_t readBinaryBody(WebServerType& server, void* dest, size_t maxLen) {
     return 0;
 }
 
+/**
+ * @brief Borrow the raw request body without copying it.
+ *
+ * The WebServer hands raw bodies to the route in HTTP_RAW_BUFLEN chunks and
+ * only the last chunk survives in HTTPRaw.buf, so a view is only possible
+ * when the whole body arrived in one chunk.
+ *
+ * @param server  WebServer instance (route registered with rawBodyStub)
+ * @param len     Output: body length in bytes
+ * @return Pointer into the server's raw buffer, or nullptr if there is no
+ *         body or it spanned more than one chunk
+ */
+inline const uint8_t* rawBodyView(WebServerType& server, size_t& len) {
+    HTTPRaw& raw = server.raw();
+    len = 0;
+    if (raw.totalSize == 0 || raw.currentSize != raw.totalSize) return nullptr;
+    len = raw.totalSize;
+    return raw.buf;
+}
+
 /**
  * @brief Helper to copy a C-string into a fixed-size char field with NUL padding.
  */
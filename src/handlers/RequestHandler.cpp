@@ -1,17 +1,30 @@
 #include "RequestHandler.h"
 #include "ResponseHelper.h"
 #include "BinaryHelper.h"
+#include "ResponseCache.h"
 
 #if defined(ESP_CAM_HW_EXIST)
 #include "CameraHandler.h"
 #endif
 
-// ArduinoJson is only needed for JWT payload parsing inside AuthManager.
-// No JSON is used in request/response bodies any more.
+// No JSON is used in request/response bodies any more; ArduinoJson is left to
+// StorageManager for the files on flash.
 
 // ── Rate limiter state ────────────────────────────────────────────────────────
-uint8_t       ESPCommandHandler::_rlCount       = 0;
-unsigned long ESPCommandHandler::_rlWindowStart = 0;
+ESPCommandHandler::RateBucket ESPCommandHandler::_rlBuckets[Config::RATE_LIMIT_CLIENTS] = {};
+ESPCommandHandler::RateBucket ESPCommandHandler::_rlOverflow = { 0, Config::RATE_LIMIT_BUCKET_CAPACITY * 1000UL, 0 };
+
+// ── Request profiling state ───────────────────────────────────────────────────
+#if FEATURE_REQUEST_PROFILING_ENABLED
+uint32_t      ESPCommandHandler::_profWindowRequests = 0;
+unsigned long ESPCommandHandler::_profWindowStart    = 0;
+uint32_t      ESPCommandHandler::_profHeapLow        = UINT32_MAX;
+#endif
+
+// ── Route metrics state ───────────────────────────────────────────────────────
+#if FEATURE_ROUTE_METRICS_ENABLED
+ESPCommandHandler::MetricsTable ESPCommandHandler::_metrics = {};
+#endif
 
 // ── Sleep mode state ─────────────────────────────────────────────────────────
 #if FEATURE_SLEEP_ENABLED
@@ -21,6 +34,7 @@ void ESPCommandHandler::initSleep() {
     bool loaded = false;
     bool ok = StorageManager::loadSleepEnabled(loaded);
     _sleepEnabled = ok ? loaded : false;
+    ResponseCache::setSleepEnabled(_sleepEnabled);
 
 #if defined(ARDUINO_ARCH_ESP32)
     WiFi.setSleep(_sleepEnabled);
@@ -43,56 +57,96 @@ void ESPCommandHandler::setupRoutes(WebServerType& server) {
     
     // Public endpoint - with LED indicator
     server.on("/ping", HTTP_GET, [&server]() { 
-        withLEDIndicator(server, handlePing); 
+        withLEDIndicator(server, handlePing, BIN_ROUTE_PING, Config::RATE_COST_CHEAP); 
     });
     
     // Authentication endpoint - with LED indicator
     server.on("/api/auth", HTTP_POST, [&server]() { 
-        withLEDIndicator(server, handleAuth); 
+        withLEDIndicator(server, handleAuth, BIN_ROUTE_AUTH, Config::RATE_COST_EXPENSIVE); 
     }, rawBodyStub);
     
     // Protected endpoints - with LED indicator
     server.on("/api/device", HTTP_GET, [&server]() { 
-        withLEDIndicator(server, handleDeviceInfo); 
+        withLEDIndicator(server, handleDeviceInfo, BIN_ROUTE_DEVICE); 
     });
     server.on("/api/ir/capture", HTTP_POST, [&server]() { 
-        withLEDIndicator(server, handleIRCapture); 
+        withLEDIndicator(server, handleIRCapture, BIN_ROUTE_IR_CAPTURE); 
     }, rawBodyStub);
     server.on("/api/ir/send", HTTP_POST, [&server]() { 
-        withLEDIndicator(server, handleIRSend); 
+        withLEDIndicator(server, handleIRSend, BIN_ROUTE_IR_SEND); 
+    }, rawBodyStub);
+    server.on("/api/ir/codes", HTTP_POST, [&server]() {
+        withLEDIndicator(server, handleIRCodeStore, BIN_ROUTE_IR_CODES);
+    }, rawBodyStub);
+    server.on("/api/ir/codes", HTTP_GET, [&server]() {
+        withLEDIndicator(server, handleIRCodeList, BIN_ROUTE_IR_CODES, Config::RATE_COST_CHEAP);
+    });
+    server.on("/api/ir/codes", HTTP_DELETE, [&server]() {
+        withLEDIndicator(server, handleIRCodeRemove, BIN_ROUTE_IR_CODES);
+    }, rawBodyStub);
+    server.on("/api/ir/fire", HTTP_POST, [&server]() {
+        withLEDIndicator(server, handleIRFire, BIN_ROUTE_IR_FIRE);
+    }, rawBodyStub);
+    server.on("/api/ir/emit", HTTP_POST, [&server]() {
+        withLEDIndicator(server, handleIREmit, BIN_ROUTE_IR_EMIT);
+    }, rawBodyStub);
+    server.on("/api/ir/queue", HTTP_POST, [&server]() {
+        withLEDIndicator(server, handleIRQueue, BIN_ROUTE_IR_QUEUE);
+    }, rawBodyStub);
+    server.on("/api/ir/queue", HTTP_GET, [&server]() {
+        withLEDIndicator(server, handleIRQueueStatus, BIN_ROUTE_IR_QUEUE, Config::RATE_COST_CHEAP);
+    });
+    server.on("/api/batch", HTTP_POST, [&server]() { 
+        withLEDIndicator(server, handleBatch, BIN_ROUTE_BATCH, Config::RATE_COST_EXPENSIVE); 
     }, rawBodyStub);
     server.on("/api/wireless", HTTP_PUT, [&server]() { 
-        withLEDIndicator(server, handleSetWireless); 
+        withLEDIndicator(server, handleSetWireless, BIN_ROUTE_WIRELESS_SET); 
     }, rawBodyStub);
     server.on("/api/wireless", HTTP_GET, [&server]() { 
-        withLEDIndicator(server, handleGetWireless); 
+        withLEDIndicator(server, handleGetWireless, BIN_ROUTE_WIRELESS_GET); 
     });
     server.on("/api/wireless/scan", HTTP_GET, [&server]() { 
-        withLEDIndicator(server, handleWirelessScan); 
+        withLEDIndicator(server, handleWirelessScan, BIN_ROUTE_WIRELESS_SCAN, Config::RATE_COST_EXPENSIVE); 
     });
 
     server.on("/api/gpio/set", HTTP_POST, [&server]() { 
-        withLEDIndicator(server, handleGPIOSet); 
+        withLEDIndicator(server, handleGPIOSet, BIN_ROUTE_GPIO_SET); 
     }, rawBodyStub);
     server.on("/api/gpio/get", HTTP_GET, [&server]() { 
-        withLEDIndicator(server, handleGPIOGet); 
+        withLEDIndicator(server, handleGPIOGet, BIN_ROUTE_GPIO_GET); 
     });
     server.on("/api/restart", HTTP_POST, [&server]() { 
-        withLEDIndicator(server, handleRestart); 
+        withLEDIndicator(server, handleRestart, BIN_ROUTE_RESTART); 
     }, rawBodyStub);
     server.on("/api/reset", HTTP_POST, [&server]() { 
-        withLEDIndicator(server, handleReset); 
+        withLEDIndicator(server, handleReset, BIN_ROUTE_RESET, Config::RATE_COST_EXPENSIVE); 
+    }, rawBodyStub);
+
+    server.on("/api/keys", HTTP_GET, [&server]() {
+        withLEDIndicator(server, handleKeyList, BIN_ROUTE_KEYS);
+    });
+    server.on("/api/keys", HTTP_POST, [&server]() {
+        withLEDIndicator(server, handleKeyAdd, BIN_ROUTE_KEYS, Config::RATE_COST_EXPENSIVE);
+    }, rawBodyStub);
+    server.on("/api/keys", HTTP_DELETE, [&server]() {
+        withLEDIndicator(server, handleKeyRemove, BIN_ROUTE_KEYS, Config::RATE_COST_EXPENSIVE);
     }, rawBodyStub);
 
+#if FEATURE_ROUTE_METRICS_ENABLED
+    server.on("/api/metrics", HTTP_GET, [&server]() {
+        withLEDIndicator(server, handleMetrics, BIN_ROUTE_METRICS, Config::RATE_COST_CHEAP);
+    });
+#endif
+
 #if FEATURE_SLEEP_ENABLED
     server.on("/api/sleep", HTTP_PUT, [&server]() {
-        withLEDIndicator(server, handleSleep);
+        withLEDIndicator(server, handleSleep, BIN_ROUTE_SLEEP);
     }, rawBodyStub);
 #endif
 
 #if defined(ESP_CAM_HW_EXIST)
     server.on("/api/camera/enable", HTTP_PUT, [&server]() {
-        withLEDIndicator(server, handleCameraEnable);
+        withLEDIndicator(server, handleCameraEnable, BIN_ROUTE_CAMERA_ENABLE);
     }, rawBodyStub);
 #endif
 
@@ -111,26 +165,28 @@ void ESPCommandHandler::setupRoutes(WebServerType& server) {
 }
 
 bool ESPCommandHandler::validateSessionToken(WebServerType& server) {
-    // Check for Authorization header
-    if (!server.hasHeader("Authorization")) {
+    // collectHeaders() always reserves slot 0 for Authorization on both
+    // WebServer cores; reading it by index avoids building a String key, and
+    // on ESP8266 the reference aliases the server's own copy (no allocation).
+    const String& authHeader = server.header(0);
+    const char*   value      = authHeader.c_str();
+    const size_t  len        = authHeader.length();
+
+    if (len == 0) {
         Utils::printSerial(F("Missing Authorization header."));
         return false;
     }
-    
-    String authHeader = server.header("Authorization");
-    Utils::printSerial(F("Authorization header: "), authHeader.c_str());
 
     // Check format: "Session <token>"
-    if (!authHeader.startsWith("Session ")) {
+    static const char kScheme[] = "Session ";
+    constexpr size_t kSchemeLen = sizeof(kScheme) - 1;
+    if (len <= kSchemeLen || memcmp(value, kScheme, kSchemeLen) != 0) {
         Utils::printSerial(F("Invalid Authorization header format."));
         return false;
     }
     
-    // Extract token
-    String sessionToken = authHeader.substring(8); // Skip "Session "
-    
-    // Validate session
-    if (!AuthManager::validateSession(sessionToken)) {
+    // Validate session (token parsed in place, after the scheme)
+    if (!AuthManager::validateSession(value + kSchemeLen, len - kSchemeLen)) {
         Utils::printSerial(F("Invalid or expired session token."));
         return false;
     }
@@ -162,6 +218,9 @@ bool ESPCommandHandler::validateResetJWT(WebServerType& server) {
 }
 
 bool ESPCommandHandler::checkWiFiAuth(WebServerType& server) {
+    // A bound sub restored at boot without its ECDSA check must not gate access
+    AuthManager::ensureBoundVerified();
+
     // If device is not bound to an identity yet, allow WiFi configuration without auth
     if (!SessionManager::hasBoundSub()) {
         Utils::printSerial(F("Device not bound - allowing WiFi configuration without auth"));
@@ -172,29 +231,121 @@ bool ESPCommandHandler::checkWiFiAuth(WebServerType& server) {
     return validateSessionToken(server);
 }
 
-bool ESPCommandHandler::checkRateLimit(WebServerType& server) {
+ESPCommandHandler::RateBucket& ESPCommandHandler::findBucket(uint32_t ip, unsigned long now) {
+    RateBucket* victim = nullptr;
+    for (uint8_t i = 0; i < Config::RATE_LIMIT_CLIENTS; i++) {
+        RateBucket& b = _rlBuckets[i];
+        if (b.ip == ip) return b;
+        if (victim && victim->ip == 0) continue;  // already holding a free slot
+        // Free slots first, then the longest-idle bucket that has refilled
+        if (b.ip == 0 || (isBucketFull(b, now) &&
+                          (!victim || (now - b.lastRefill) > (now - victim->lastRefill)))) {
+            victim = &b;
+        }
+    }
+
+    // Every tracked client still owes tokens: newcomers share one bucket
+    // rather than evicting somebody's debt.
+    if (!victim) return _rlOverflow;
+
+    victim->ip          = ip;
+    victim->milliTokens = Config::RATE_LIMIT_BUCKET_CAPACITY * 1000UL;
+    victim->lastRefill  = now;
+    return *victim;
+}
+
+bool ESPCommandHandler::isBucketFull(const RateBucket& b, unsigned long now) {
+    constexpr uint32_t kCapacity = Config::RATE_LIMIT_BUCKET_CAPACITY * 1000UL;
+    unsigned long elapsed = now - b.lastRefill;
+    if (elapsed >= kCapacity / Config::RATE_LIMIT_REFILL_PER_SEC) return true;
+    return b.milliTokens + elapsed * Config::RATE_LIMIT_REFILL_PER_SEC >= kCapacity;
+}
+
+bool ESPCommandHandler::checkRateLimit(WebServerType& server, uint8_t cost) {
+    constexpr uint32_t kCapacity = Config::RATE_LIMIT_BUCKET_CAPACITY * 1000UL;
     unsigned long now = millis();
 
-    // Reset the counter when the window has expired
-    if (now - _rlWindowStart >= Config::RATE_LIMIT_WINDOW_MS) {
-        _rlWindowStart = now;
-        _rlCount       = 0;
+    RateBucket& b = findBucket((uint32_t)server.client().remoteIP(), now);
+
+    // Refill: REFILL_PER_SEC tokens per 1000 ms == REFILL_PER_SEC milli-tokens per ms
+    unsigned long elapsed = now - b.lastRefill;
+    b.lastRefill = now;
+    if (elapsed >= kCapacity / Config::RATE_LIMIT_REFILL_PER_SEC) {
+        b.milliTokens = kCapacity;
+    } else {
+        b.milliTokens += elapsed * Config::RATE_LIMIT_REFILL_PER_SEC;
+        if (b.milliTokens > kCapacity) b.milliTokens = kCapacity;
     }
 
-    if (_rlCount >= Config::RATE_LIMIT_MAX_REQUESTS) {
-        // Tell the client how many seconds remain in the current window
-        unsigned long remaining = (Config::RATE_LIMIT_WINDOW_MS - (now - _rlWindowStart) + 999UL) / 1000UL;
-        char retryAfter[4];
-        snprintf(retryAfter, sizeof(retryAfter), "%u", (unsigned)remaining);
-        server.sendHeader("Retry-After", retryAfter);
-        sendError(server, 429, "Rate limit exceeded");
+    uint32_t need = cost * 1000UL;
+    if (b.milliTokens < need) {
+        // Tell the client how many seconds until enough tokens have accrued
+        uint32_t perSec    = Config::RATE_LIMIT_REFILL_PER_SEC * 1000UL;
+        uint32_t remaining = (need - b.milliTokens + perSec - 1) / perSec;
+        char retryAfter[24];
+        snprintf(retryAfter, sizeof(retryAfter), "Retry-After: %u\r\n", (unsigned)remaining);
+        sendBinaryError(server, 429, BIN_STATUS_ERROR, "Rate limit exceeded", retryAfter);
         return false;
     }
 
-    _rlCount++;
+    b.milliTokens -= need;
     return true;
 }
 
+#if FEATURE_ROUTE_METRICS_ENABLED
+uint32_t ESPCommandHandler::beginRouteMetrics(WebServerType& server, BinRouteId route) {
+    BinRouteMetrics& m = _metrics.routes[route];
+    m.calls++;
+    m.bytesIn += (uint32_t)server.clientContentLength();
+    return binaryTxBytes();
+}
+
+void ESPCommandHandler::endRouteMetrics(BinRouteId route, uint32_t txMark,
+                                        uint32_t elapsedUs, bool rateLimited) {
+    BinRouteMetrics& m = _metrics.routes[route];
+    m.bytesOut += binaryTxBytes() - txMark;
+    if (rateLimited) {
+        m.rateLimited++;
+        return;
+    }
+
+    // Bucket 0: < 256 µs; bucket i: [2^(i+7), 2^(i+8)) µs; last bucket open-ended
+    uint32_t scaled = elapsedUs >> 8;
+    uint8_t bucket = scaled ? (uint8_t)(32 - __builtin_clz(scaled)) : 0;
+    if (bucket >= BIN_METRICS_LATENCY_BUCKETS) bucket = BIN_METRICS_LATENCY_BUCKETS - 1;
+    m.latency[bucket]++;
+}
+#endif
+
+#if FEATURE_REQUEST_PROFILING_ENABLED
+void ESPCommandHandler::recordProfile(BinRouteId route, uint32_t elapsedUs) {
+    if (!Config::SERIAL_MONITOR_ENABLED) return;
+
+    uint32_t freeHeap = ESP.getFreeHeap();
+    if (freeHeap < _profHeapLow) _profHeapLow = freeHeap;
+    _profWindowRequests++;
+
+    Utils::printSerial(F("[PROF] route "), "");
+    Utils::printSerial((unsigned long)route, ": ");
+    Utils::printSerial((unsigned long)elapsedUs, " us, heap ");
+    Utils::printSerial((unsigned long)freeHeap, " B\n");
+
+    unsigned long now     = millis();
+    unsigned long elapsed = now - _profWindowStart;
+    if (elapsed >= Config::PROFILE_REPORT_INTERVAL_MS) {
+        // Fixed-point req/s with one decimal — avoids pulling in float printf
+        unsigned long rate10 = (_profWindowRequests * 10000UL) / elapsed;
+        Utils::printSerial(F("[PROF] "), "");
+        Utils::printSerial(rate10 / 10, ".");
+        Utils::printSerial(rate10 % 10, " req/s over ");
+        Utils::printSerial(elapsed, " ms, heap low-water ");
+        Utils::printSerial((unsigned long)_profHeapLow, " B\n");
+        _profWindowStart    = now;
+        _profWindowRequests = 0;
+    }
+}
+#endif
+
 void ESPCommandHandler::sendError(WebServerType& server, int code, const char* message) {
     uint8_t binStatus = BIN_STATUS_ERROR;
     if (code == 401) binStatus = BIN_STATUS_UNAUTHORIZED;
@@ -208,17 +359,7 @@ void ESPCommandHandler::sendError(WebServerType& server, int code, const char* m
 void ESPCommandHandler::handlePing(WebServerType& server) {
     Utils::printSerial(F("\nHandling /ping request"));
 
-    BinPingResponse resp;
-    memset(&resp, 0, sizeof(resp));
-    copyToField(resp.deviceID,      Utils::getDeviceIDString(), sizeof(resp.deviceID));
-    copyToField(resp.ipAddress,     WirelessNetworkManager::getIPAddress(), sizeof(resp.ipAddress));
-    copyToField(resp.deviceName,    Config::DEVICE_NAME, sizeof(resp.deviceName));
-    copyToField(resp.challenge,     SessionManager::getCurrentChallenge(), sizeof(resp.challenge));
-    resp.isBound = SessionManager::hasBoundSub() ? 1 : 0;
-    copyToField(resp.platform_name, PLATFORM_NAME, sizeof(resp.platform_name));
-    copyToField(resp.platform_key,  PLATFORM_KEY, sizeof(resp.platform_key));
-
-    sendBinaryResponse(server, 200, &resp, sizeof(resp));
+    ResponseCache::sendPing(server);
 }
 
 // ================================
@@ -272,31 +413,7 @@ void ESPCommandHandler::handleDeviceInfo(WebServerType& server) {
         return;
     }
 
-    BinDeviceInfoResponse resp;
-    memset(&resp, 0, sizeof(resp));
-    copyToField(resp.deviceName, Config::DEVICE_NAME, sizeof(resp.deviceName));
-    copyToField(resp.deviceID,   Utils::getDeviceIDString(), sizeof(resp.deviceID));
-    copyToField(resp.macAddress, WirelessNetworkManager::getMacAddress(), sizeof(resp.macAddress));
-    copyToField(resp.ipAddress,  WirelessNetworkManager::getIPAddress(), sizeof(resp.ipAddress));
-
-#if defined(ARDUINO_ARCH_ESP8266)
-    copyToField(resp.platform, "ESP8266", sizeof(resp.platform));
-    resp.deviceIDDecimal = (uint32_t)Utils::getDeviceID();
-#elif defined(ARDUINO_ARCH_ESP32)
-    copyToField(resp.platform, "ESP32", sizeof(resp.platform));
-    resp.deviceIDDecimal = (uint32_t)(Utils::getDeviceID() & 0xFFFFFFFF);
-#endif
-    copyToField(resp.platform_name, PLATFORM_NAME, sizeof(resp.platform_name));
-    copyToField(resp.platform_key,  PLATFORM_KEY,  sizeof(resp.platform_key));
-    copyToField(resp.wirelessMode,  WirelessNetworkManager::getWirelessConfig().mode, sizeof(resp.wirelessMode));
-    resp.isBound = SessionManager::hasBoundSub() ? 1 : 0;
-#if FEATURE_SLEEP_ENABLED
-    resp.sleepEnabled = _sleepEnabled ? 1 : 0;
-#else
-    resp.sleepEnabled = 0;
-#endif
-
-    sendBinaryResponse(server, 200, &resp, sizeof(resp));
+    ResponseCache::sendDeviceInfo(server);
 }
 
 void ESPCommandHandler::handleIRCapture(WebServerType& server) {
@@ -313,10 +430,11 @@ void ESPCommandHandler::handleIRCapture(WebServerType& server) {
         return;
     }
 
-    Utils::setLED(LOW);
-    // IRManager handles the full SSE response internally; do NOT send any response after.
-    IRManager::captureIR(req.captureMode, server);
-    Utils::setLED(HIGH);
+    // IRManager takes over the client and streams the SSE response from loop();
+    // do NOT send any response after a successful start.
+    if (!IRManager::startCapture(req.captureMode, req.flags, server)) {
+        sendError(server, 409, "IR capture already in progress");
+    }
 }
 
 void ESPCommandHandler::handleIRSend(WebServerType& server) {
@@ -327,46 +445,367 @@ void ESPCommandHandler::handleIRSend(WebServerType& server) {
         return;
     }
 
-    // Variable-length: BinIrSendHeader followed by irCode data
-    if (!server.hasArg("plain")) {
+    // Variable-length: BinIrSendHeader followed by irCode data.  A body that
+    // fits one raw chunk is parsed in place; only a longer one is reassembled.
+    size_t bodyLen = 0;
+    const uint8_t* body = rawBodyView(server, bodyLen);
+    String plain;
+    if (!body && server.hasArg("plain")) {
+        plain   = server.arg("plain");
+        body    = reinterpret_cast<const uint8_t*>(plain.c_str());
+        bodyLen = plain.length();
+    }
+    if (!body) {
         sendError(server, 400, "IR send data required");
         return;
     }
 
-    String body = server.arg("plain");
-    if (body.length() < sizeof(BinIrSendHeader)) {
-        sendError(server, 400, "IR send data too short");
+    BinIrSendResponse resp;
+    const char* error = runIRSend(body, bodyLen, &resp);
+    if (error) {
+        sendError(server, 400, error);
         return;
     }
 
-    const uint8_t* raw = reinterpret_cast<const uint8_t*>(body.c_str());
+    sendBinaryResponse(server, 200, &resp, sizeof(resp));
+}
+
+const char* ESPCommandHandler::runIRSend(const uint8_t* data, size_t len,
+                                         BinIrSendResponse* resp) {
+    if (len < sizeof(BinIrSendHeader)) {
+        return "IR send data too short";
+    }
+
     BinIrSendHeader hdr;
-    memcpy(&hdr, raw, sizeof(hdr));
+    memcpy(&hdr, data, sizeof(hdr));
     hdr.protocol[sizeof(hdr.protocol) - 1] = '\0';
 
     // Validate irCodeLen against actual body length
     size_t expectedTotal = sizeof(BinIrSendHeader) + hdr.irCodeLen;
-    if (body.length() < expectedTotal) {
+    if (len < expectedTotal) {
+        return "IR code data incomplete";
+    }
+
+    // irCode text follows the header; the parsers are length-bounded, so it
+    // is read where it lies
+    memset(resp, 0, sizeof(BinIrSendResponse));
+
+    Utils::setLED(LOW);
+    IRManager::sendIR(hdr.protocol, hdr.bitLength,
+                      reinterpret_cast<const char*>(data + sizeof(BinIrSendHeader)),
+                      hdr.irCodeLen, resp);
+    Utils::setLED(HIGH);
+    return nullptr;
+}
+
+void ESPCommandHandler::handleIRCodeStore(WebServerType& server) {
+    Utils::printSerial(F("\nHandling POST /api/ir/codes request"));
+
+    if (!validateSessionToken(server)) {
+        sendError(server, 401, ResponseMsg::UNAUTHORIZED);
+        return;
+    }
+
+    // Largest code (header + full raw array) fits in one raw-body chunk
+    static_assert(sizeof(BinIrCodeHeader) + Config::IR_LIBRARY_CODE_BYTES <= HTTP_RAW_BUFLEN,
+                  "stored IR code must arrive in a single raw body chunk");
+
+    size_t bodyLen = 0;
+    const uint8_t* body = rawBodyView(server, bodyLen);
+    if (!body || bodyLen < sizeof(BinIrCodeHeader)) {
+        sendError(server, 400, "IR code data required");
+        return;
+    }
+
+    BinIrCodeHeader hdr;
+    memcpy(&hdr, body, sizeof(hdr));
+    if (bodyLen - sizeof(hdr) < hdr.dataLen) {
         sendError(server, 400, "IR code data incomplete");
         return;
     }
 
-    // irCode data follows the header (NUL-terminated hex string)
-    static char irCodeBuf[2048];
-    size_t copyLen = (hdr.irCodeLen < sizeof(irCodeBuf) - 1) ? hdr.irCodeLen : (sizeof(irCodeBuf) - 1);
-    memcpy(irCodeBuf, raw + sizeof(BinIrSendHeader), copyLen);
-    irCodeBuf[copyLen] = '\0';
+    const char* error = IRManager::storeCode(hdr, body + sizeof(hdr));
+    if (error) {
+        sendError(server, 400, error);
+        return;
+    }
+
+    BinSimpleResponse resp;
+    resp.status = BIN_STATUS_OK;
+    sendBinaryResponse(server, 200, &resp, sizeof(resp));
+}
+
+void ESPCommandHandler::handleIRCodeList(WebServerType& server) {
+    Utils::printSerial(F("\nHandling GET /api/ir/codes request"));
+
+    if (!validateSessionToken(server)) {
+        sendError(server, 401, ResponseMsg::UNAUTHORIZED);
+        return;
+    }
+
+    uint8_t respBuf[sizeof(BinIrCodeListHeader) + Config::IR_LIBRARY_SLOTS * sizeof(uint16_t)];
+    BinIrCodeListHeader* respHdr = reinterpret_cast<BinIrCodeListHeader*>(respBuf);
+    uint16_t ids[Config::IR_LIBRARY_SLOTS];
+    respHdr->status = BIN_STATUS_OK;
+    respHdr->count  = IrLibrary::list(ids, Config::IR_LIBRARY_SLOTS);
+    memcpy(respBuf + sizeof(BinIrCodeListHeader), ids, respHdr->count * sizeof(uint16_t));
+
+    sendBinaryResponse(server, 200, respBuf,
+                       sizeof(BinIrCodeListHeader) + respHdr->count * sizeof(uint16_t));
+}
+
+void ESPCommandHandler::handleIRCodeRemove(WebServerType& server) {
+    Utils::printSerial(F("\nHandling DELETE /api/ir/codes request"));
+
+    if (!validateSessionToken(server)) {
+        sendError(server, 401, ResponseMsg::UNAUTHORIZED);
+        return;
+    }
+
+    BinIrCodeIdRequest req;
+    if (readBinaryBody(server, &req, sizeof(req)) != sizeof(req)) {
+        sendError(server, 400, "IR code id required");
+        return;
+    }
+
+    if (!IrLibrary::remove(req.id)) {
+        sendError(server, 404, "Unknown IR code");
+        return;
+    }
+
+    BinSimpleResponse resp;
+    resp.status = BIN_STATUS_OK;
+    sendBinaryResponse(server, 200, &resp, sizeof(resp));
+}
+
+void ESPCommandHandler::handleIRFire(WebServerType& server) {
+    Utils::printSerial(F("\nHandling /api/ir/fire request"));
+
+    if (!validateSessionToken(server)) {
+        sendError(server, 401, ResponseMsg::UNAUTHORIZED);
+        return;
+    }
+
+    BinIrCodeIdRequest req;
+    if (readBinaryBody(server, &req, sizeof(req)) != sizeof(req)) {
+        sendError(server, 400, "IR code id required");
+        return;
+    }
 
     BinIrSendResponse resp;
-    memset(&resp, 0, sizeof(resp));
+    Utils::setLED(LOW);
+    bool found = IRManager::sendStored(req.id, &resp);
+    Utils::setLED(HIGH);
+    if (!found) {
+        sendError(server, 404, "Unknown IR code");
+        return;
+    }
 
+    sendBinaryResponse(server, 200, &resp, sizeof(resp));
+}
+
+void ESPCommandHandler::handleIREmit(WebServerType& server) {
+    Utils::printSerial(F("\nHandling /api/ir/emit request"));
+
+    if (!validateSessionToken(server)) {
+        sendError(server, 401, ResponseMsg::UNAUTHORIZED);
+        return;
+    }
+
+    size_t bodyLen = 0;
+    const uint8_t* body = rawBodyView(server, bodyLen);
+    if (!body || bodyLen < sizeof(BinIrCodeHeader)) {
+        sendError(server, 400, "IR code data required");
+        return;
+    }
+
+    BinIrCodeHeader hdr;
+    memcpy(&hdr, body, sizeof(hdr));
+    if (bodyLen - sizeof(hdr) < hdr.dataLen) {
+        sendError(server, 400, "IR code data incomplete");
+        return;
+    }
+
+    BinIrSendResponse resp;
     Utils::setLED(LOW);
-    IRManager::sendIR(hdr.protocol, hdr.bitLength, irCodeBuf, (uint16_t)copyLen, &resp);
+    const char* error = IRManager::sendCode(hdr, body + sizeof(hdr), &resp);
     Utils::setLED(HIGH);
+    if (error) {
+        sendError(server, 400, error);
+        return;
+    }
 
     sendBinaryResponse(server, 200, &resp, sizeof(resp));
 }
 
+void ESPCommandHandler::handleIRQueue(WebServerType& server) {
+    Utils::printSerial(F("\nHandling POST /api/ir/queue request"));
+
+    if (!validateSessionToken(server)) {
+        sendError(server, 401, ResponseMsg::UNAUTHORIZED);
+        return;
+    }
+
+    size_t bodyLen = 0;
+    const uint8_t* body = rawBodyView(server, bodyLen);
+    if (!body || bodyLen < sizeof(BinIrCodeHeader)) {
+        sendError(server, 400, "IR code data required");
+        return;
+    }
+
+    BinIrCodeHeader hdr;
+    memcpy(&hdr, body, sizeof(hdr));
+    if (bodyLen - sizeof(hdr) < hdr.dataLen) {
+        sendError(server, 400, "IR code data incomplete");
+        return;
+    }
+
+    uint16_t jobId = 0;
+    const char* error = IRManager::enqueue(hdr, body + sizeof(hdr), jobId);
+    if (error) {
+        sendError(server, 400, error);
+        return;
+    }
+
+    // Transmission happens from loop() after this response has gone out
+    BinIrQueueResponse resp;
+    resp.status  = jobId ? BIN_STATUS_OK : BIN_STATUS_ERROR;
+    resp.jobId   = jobId;
+    resp.pending = IRManager::pendingJobs();
+    sendBinaryResponse(server, jobId ? 202 : 503, &resp, sizeof(resp));
+}
+
+void ESPCommandHandler::handleIRQueueStatus(WebServerType& server) {
+    Utils::printSerial(F("\nHandling GET /api/ir/queue request"));
+
+    if (!validateSessionToken(server)) {
+        sendError(server, 401, ResponseMsg::UNAUTHORIZED);
+        return;
+    }
+
+    BinIrJobStatusResponse resp;
+    resp.status  = BIN_STATUS_OK;
+    resp.jobId   = server.hasArg("job") ? (uint16_t)server.arg("job").toInt() : 0;
+    resp.state   = IRManager::getJobStatus(resp.jobId);
+    resp.pending = IRManager::pendingJobs();
+    sendBinaryResponse(server, 200, &resp, sizeof(resp));
+}
+
+void ESPCommandHandler::handleBatch(WebServerType& server) {
+    Utils::printSerial(F("\nHandling /api/batch request"));
+
+    // One session check covers every sub-command in the batch
+    if (!validateSessionToken(server)) {
+        sendError(server, 401, ResponseMsg::UNAUTHORIZED);
+        return;
+    }
+
+    // The batch is parsed in place, so it has to arrive in one raw chunk
+    size_t bodyLen = 0;
+    const uint8_t* body = rawBodyView(server, bodyLen);
+    if (!body && server.raw().totalSize > 0) {
+        sendError(server, 413, "Batch too large: split it into smaller batches");
+        return;
+    }
+    if (!body || bodyLen < sizeof(BinBatchHeader)) {
+        sendError(server, 400, "Batch data required");
+        return;
+    }
+
+    BinBatchHeader hdr;
+    memcpy(&hdr, body, sizeof(hdr));
+    if (hdr.count == 0 || hdr.count > Config::BATCH_MAX_COMMANDS) {
+        sendError(server, 400, "Invalid batch size");
+        return;
+    }
+
+    // Validate the framing of every command before executing any of them,
+    // so a truncated batch never leaves the device half-applied.
+    size_t   pos        = sizeof(BinBatchHeader);
+    uint32_t totalDelay = 0;
+    for (uint8_t i = 0; i < hdr.count; i++) {
+        BinBatchCommandHeader cmd;
+        if (bodyLen - pos < sizeof(cmd)) {
+            sendError(server, 400, "Batch data incomplete");
+            return;
+        }
+        memcpy(&cmd, body + pos, sizeof(cmd));
+        pos += sizeof(cmd);
+        if (bodyLen - pos < cmd.payloadLen) {
+            sendError(server, 400, "Batch data incomplete");
+            return;
+        }
+        pos += cmd.payloadLen;
+        totalDelay += cmd.delayMs < Config::BATCH_MAX_DELAY_MS ? cmd.delayMs : Config::BATCH_MAX_DELAY_MS;
+    }
+    if (totalDelay > Config::BATCH_MAX_TOTAL_DELAY_MS) {
+        sendError(server, 400, "Batch delays too long");
+        return;
+    }
+
+    uint8_t respBuf[sizeof(BinBatchResponseHeader) + Config::BATCH_MAX_COMMANDS * sizeof(BinBatchResult)];
+    memset(respBuf, 0, sizeof(respBuf));
+    BinBatchResponseHeader* respHdr = reinterpret_cast<BinBatchResponseHeader*>(respBuf);
+    BinBatchResult* results = reinterpret_cast<BinBatchResult*>(respBuf + sizeof(BinBatchResponseHeader));
+    respHdr->status = BIN_STATUS_OK;
+    respHdr->count  = hdr.count;
+
+    pos = sizeof(BinBatchHeader);
+    for (uint8_t i = 0; i < hdr.count; i++) {
+        BinBatchCommandHeader cmd;
+        memcpy(&cmd, body + pos, sizeof(cmd));
+        pos += sizeof(cmd);
+        const uint8_t* payload = body + pos;
+        pos += cmd.payloadLen;
+
+        if (cmd.delayMs > 0) {
+            delay(cmd.delayMs < Config::BATCH_MAX_DELAY_MS ? cmd.delayMs : Config::BATCH_MAX_DELAY_MS);
+        }
+
+        BinBatchResult& result = results[i];
+        result.status = BIN_STATUS_ERROR;
+        result.value  = 0;
+
+        if (cmd.type == BIN_BATCH_GPIO_SET && cmd.payloadLen >= sizeof(BinGpioSetRequest)) {
+            BinGpioSetRequest req;
+            memcpy(&req, payload, sizeof(req));
+            BinGpioSetResponse gpioResp;
+            GPIOManager::applyGPIO(req.pinNumber, req.pinMode, req.pinValue, &gpioResp);
+            result.status = gpioResp.status;
+            result.value  = gpioResp.pinValue;
+        } else if (cmd.type == BIN_BATCH_IR_SEND) {
+            BinIrSendResponse irResp;
+            if (runIRSend(payload, cmd.payloadLen, &irResp) == nullptr) {
+                result.status = irResp.status;
+            }
+        } else if (cmd.type == BIN_BATCH_IR_FIRE && cmd.payloadLen >= sizeof(BinIrCodeIdRequest)) {
+            BinIrCodeIdRequest req;
+            memcpy(&req, payload, sizeof(req));
+            BinIrSendResponse irResp;
+            Utils::setLED(LOW);
+            IRManager::sendStored(req.id, &irResp);
+            Utils::setLED(HIGH);
+            result.status = irResp.status;
+        } else if (cmd.type == BIN_BATCH_IR_EMIT && cmd.payloadLen >= sizeof(BinIrCodeHeader)) {
+            BinIrCodeHeader code;
+            memcpy(&code, payload, sizeof(code));
+            BinIrSendResponse irResp;
+            if (cmd.payloadLen - sizeof(code) >= code.dataLen) {
+                Utils::setLED(LOW);
+                if (IRManager::sendCode(code, payload + sizeof(code), &irResp) == nullptr) {
+                    result.status = irResp.status;
+                }
+                Utils::setLED(HIGH);
+            }
+        }
+
+        if (result.status != BIN_STATUS_OK) respHdr->status = BIN_STATUS_ERROR;
+    }
+
+    sendBinaryResponse(server, 200, respBuf,
+                       sizeof(BinBatchResponseHeader) + hdr.count * sizeof(BinBatchResult));
+}
+
 void ESPCommandHandler::handleSetWireless(WebServerType& server) {
     Utils::printSerial(F("\nHandling /api/wireless PUT request"));
 
@@ -562,6 +1001,28 @@ void ESPCommandHandler::handleGPIOGet(WebServerType& server) {
     delete[] buf;
 }
 
+#if FEATURE_ROUTE_METRICS_ENABLED
+void ESPCommandHandler::handleMetrics(WebServerType& server) {
+    Utils::printSerial(F("\nHandling /api/metrics request"));
+
+    if (!validateSessionToken(server)) {
+        sendError(server, 401, ResponseMsg::UNAUTHORIZED);
+        return;
+    }
+
+    // Row IDs are fixed; stamping them here keeps the table zero-initialised
+    for (uint8_t i = 0; i < BIN_ROUTE_COUNT; i++) {
+        _metrics.routes[i].routeId = i;
+    }
+    _metrics.header.status      = BIN_STATUS_OK;
+    _metrics.header.routeCount  = BIN_ROUTE_COUNT;
+    _metrics.header.bucketCount = BIN_METRICS_LATENCY_BUCKETS;
+    _metrics.header.uptimeMs    = millis();
+
+    sendBinaryResponse(server, 200, &_metrics, sizeof(_metrics));
+}
+#endif
+
 void ESPCommandHandler::handleRestart(WebServerType& server) {
     Utils::printSerial(F("\nHandling /api/restart request"));
 
@@ -574,6 +1035,7 @@ void ESPCommandHandler::handleRestart(WebServerType& server) {
     resp.status = BIN_STATUS_RESTARTING;
     sendBinaryResponse(server, 200, &resp, sizeof(resp));
 
+    GPIOManager::flush();
     delay(100);
     ESP.restart();
 }
@@ -605,6 +1067,7 @@ void ESPCommandHandler::handleSleep(WebServerType& server) {
 
     _sleepEnabled = enable;
     StorageManager::saveSleepEnabled(_sleepEnabled);
+    ResponseCache::setSleepEnabled(_sleepEnabled);
     Utils::printSerial(F("Sleep mode: "), enable ? "enabled" : "disabled");
 
     BinSleepResponse resp;
@@ -632,6 +1095,8 @@ void ESPCommandHandler::handleReset(WebServerType& server) {
         // Invalidate all sessions and clear bound identity since device is being reset
         SessionManager::invalidateAllSessions();
         SessionManager::setBoundSub(""); // Clear bound sub in memory
+        AuthManager::resetKeys();        // Key file went with the format
+        GPIOManager::clearConfig();      // Pending pin changes must not outlive it
 
         Utils::printSerial(F("Reset completed. Device is now unbound."));
     }
@@ -641,6 +1106,75 @@ void ESPCommandHandler::handleReset(WebServerType& server) {
     sendBinaryResponse(server, 200, &resp, sizeof(resp));
 }
 
+static_assert(BIN_JWT_KEY_SLOTS == Config::JWT_KEY_SLOTS, "BinKeyListResponse out of step with key table");
+static_assert(sizeof(BinKeyAddRequest::kid) == Config::JWT_KID_LEN, "BinKeyAddRequest kid size");
+
+void ESPCommandHandler::handleKeyList(WebServerType& server) {
+    Utils::printSerial(F("\nHandling GET /api/keys request"));
+
+    if (!validateSessionToken(server)) {
+        sendError(server, 401, ResponseMsg::UNAUTHORIZED);
+        return;
+    }
+
+    BinKeyListResponse resp;
+    memset(&resp, 0, sizeof(resp));
+    resp.status = BIN_STATUS_OK;
+    resp.count  = AuthManager::getKeyIds(resp.kids, BIN_JWT_KEY_SLOTS);
+    sendBinaryResponse(server, 200, &resp, sizeof(resp));
+}
+
+void ESPCommandHandler::handleKeyAdd(WebServerType& server) {
+    Utils::printSerial(F("\nHandling POST /api/keys request"));
+
+    // Trusting a new signer is owner-only, same as factory reset
+    if (!validateResetJWT(server)) {
+        sendError(server, 401, ResponseMsg::UNAUTHORIZED);
+        return;
+    }
+
+    BinKeyAddRequest req;
+    if (readBinaryBody(server, &req, sizeof(req)) != sizeof(req)) {
+        sendError(server, 400, "Key data required");
+        return;
+    }
+    req.kid[sizeof(req.kid) - 1] = '\0';
+
+    if (!AuthManager::addKey(req.kid, req.point)) {
+        sendError(server, 400, "Invalid key or key table full");
+        return;
+    }
+
+    BinSimpleResponse resp;
+    resp.status = BIN_STATUS_OK;
+    sendBinaryResponse(server, 200, &resp, sizeof(resp));
+}
+
+void ESPCommandHandler::handleKeyRemove(WebServerType& server) {
+    Utils::printSerial(F("\nHandling DELETE /api/keys request"));
+
+    if (!validateResetJWT(server)) {
+        sendError(server, 401, ResponseMsg::UNAUTHORIZED);
+        return;
+    }
+
+    BinKeyRemoveRequest req;
+    if (readBinaryBody(server, &req, sizeof(req)) == 0) {
+        sendError(server, 400, "Key id required");
+        return;
+    }
+    req.kid[sizeof(req.kid) - 1] = '\0';
+
+    if (!AuthManager::removeKey(req.kid)) {
+        sendError(server, 404, "Unknown key id");
+        return;
+    }
+
+    BinSimpleResponse resp;
+    resp.status = BIN_STATUS_OK;
+    sendBinaryResponse(server, 200, &resp, sizeof(resp));
+}
+
 #if defined(ESP_CAM_HW_EXIST)
 // Track whether the stream server has been started (deferred from boot).
 static bool _streamServerStarted = false;
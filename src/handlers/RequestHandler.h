@@ -38,31 +38,116 @@ private:
     // Middleware
     /**
      * @brief LED indicator middleware wrapper.
-     *        Also enforces the global rate limit before dispatching.
+     *        Also enforces the per-client rate limit before dispatching and
+     *        records the request in the route metrics table.
      * @param server WebServer instance
      * @param handler Request handler function
+     * @param route Metrics row for this route
+     * @param cost Tokens this route spends from the client's bucket
      */
     template<typename HandlerFunc>
-    static void withLEDIndicator(WebServerType& server, HandlerFunc handler) {
-        if (!checkRateLimit(server)) return;  // 429 already sent
+    static void withLEDIndicator(WebServerType& server, HandlerFunc handler, BinRouteId route,
+                                 uint8_t cost = Config::RATE_COST_DEFAULT) {
+#if FEATURE_ROUTE_METRICS_ENABLED
+        const uint32_t txMark = beginRouteMetrics(server, route);
+#endif
+        if (!checkRateLimit(server, cost)) {  // 429 already sent
+#if FEATURE_ROUTE_METRICS_ENABLED
+            endRouteMetrics(route, txMark, 0, true);
+#endif
+            return;
+        }
+#if FEATURE_REQUEST_PROFILING_ENABLED || FEATURE_ROUTE_METRICS_ENABLED
+        const uint32_t startUs = micros();
+#endif
         Utils::toggleLED();  // Toggle LED
         handler(server);
         Utils::toggleLED(); // Toggle LED back
+#if FEATURE_REQUEST_PROFILING_ENABLED || FEATURE_ROUTE_METRICS_ENABLED
+        const uint32_t elapsedUs = micros() - startUs;
+#endif
+#if FEATURE_ROUTE_METRICS_ENABLED
+        endRouteMetrics(route, txMark, elapsedUs, false);
+#endif
+#if FEATURE_REQUEST_PROFILING_ENABLED
+        recordProfile(route, elapsedUs);
+#endif
     }
 
     /**
-     * @brief Global fixed-window rate limiter.
-     *        Allows at most Config::RATE_LIMIT_MAX_REQUESTS per
-     *        Config::RATE_LIMIT_WINDOW_MS milliseconds across all endpoints.
+     * @brief Per-client token-bucket rate limiter.
+     *        Each remote IP owns a bucket of Config::RATE_LIMIT_BUCKET_CAPACITY
+     *        tokens refilled at Config::RATE_LIMIT_REFILL_PER_SEC.  A request is
+     *        admitted when the bucket holds at least @p cost tokens.
      * @param server WebServer instance (used to send 429 on violation)
+     * @param cost   Tokens charged for this route
      * @return true if the request is within the limit, false if rejected
      */
-    static bool checkRateLimit(WebServerType& server);
+    static bool checkRateLimit(WebServerType& server, uint8_t cost);
+
+    // One bucket per recently seen client — fixed table, no heap allocation.
+    // Tokens are kept in thousandths so sub-second refills are not lost.
+    struct RateBucket {
+        uint32_t      ip;           // IPv4 address, 0 = free slot
+        uint32_t      milliTokens;  // tokens × 1000
+        unsigned long lastRefill;   // millis() of the last refill
+    };
+
+    /**
+     * @brief Find the bucket for @p ip.  An unknown client takes a free slot or
+     *        recycles the longest-idle bucket that has refilled completely (so
+     *        nothing it owed is forgiven).  When every tracked client still has
+     *        tokens outstanding, unknown clients share _rlOverflow instead.
+     */
+    static RateBucket& findBucket(uint32_t ip, unsigned long now);
+
+    /** @brief True once @p b would be back at capacity if refilled at @p now. */
+    static bool isBucketFull(const RateBucket& b, unsigned long now);
+
+    static RateBucket _rlBuckets[Config::RATE_LIMIT_CLIENTS];
+    static RateBucket _rlOverflow;  // shared by clients that found no slot
+
+#if FEATURE_REQUEST_PROFILING_ENABLED
+    /**
+     * @brief Log one handled request (route, latency, free heap) and, once per
+     *        Config::PROFILE_REPORT_INTERVAL_MS, the aggregate requests/sec and
+     *        the lowest free heap seen since boot.
+     * @param route     Route that handled the request (logged by id, so no
+     *                  URI String is built per request)
+     * @param elapsedUs Handler wall time in microseconds
+     */
+    static void recordProfile(BinRouteId route, uint32_t elapsedUs);
 
-    // Rate limiter state (fixed-window counters)
-    static uint8_t       _rlCount;        // requests in the current window
-    static unsigned long _rlWindowStart;  // millis() when the current window began
+    // Profiling state
+    static uint32_t      _profWindowRequests;  // requests since the last summary
+    static unsigned long _profWindowStart;     // millis() when the summary window began
+    static uint32_t      _profHeapLow;         // lowest free heap observed after a request
+#endif
     
+#if FEATURE_ROUTE_METRICS_ENABLED
+    /**
+     * @brief Count a request against @p route and add its body size to bytesIn.
+     * @return Snapshot of binaryTxBytes() to pass to endRouteMetrics()
+     */
+    static uint32_t beginRouteMetrics(WebServerType& server, BinRouteId route);
+
+    /**
+     * @brief Attribute the bytes written since @p txMark to @p route and, for
+     *        admitted requests, add @p elapsedUs to its latency histogram.
+     * @param rateLimited true if the request was rejected with 429
+     */
+    static void endRouteMetrics(BinRouteId route, uint32_t txMark,
+                                uint32_t elapsedUs, bool rateLimited);
+
+    // Metrics table laid out exactly as the /api/metrics response body, so the
+    // handler sends it in place.  Fixed size, no heap allocation.
+    struct MetricsTable {
+        BinMetricsResponseHeader header;
+        BinRouteMetrics          routes[BIN_ROUTE_COUNT];
+    };
+    static MetricsTable _metrics;
+#endif
+
     /**
      * @brief Validate session token from Authorization header
      * @param server WebServer instance
@@ -79,7 +164,8 @@ private:
     static bool checkWiFiAuth(WebServerType& server);
     
     /**
-     * @brief Validate JWT token from Authorization: Bearer header for reset endpoint
+     * @brief Validate JWT token from Authorization: Bearer header for owner-only
+     *        endpoints (reset, key management).
      *        Validates challenge, signature, and ensures sub matches bound sub (owner only)
      * @param server WebServer instance
      * @return true if valid, false otherwise
@@ -94,6 +180,16 @@ private:
      */
     static void sendError(WebServerType& server, int code, const char* message);
 
+    /**
+     * @brief Decode a BinIrSendHeader + irCode payload and transmit it.
+     *        Shared by /api/ir/send and IR sub-commands of /api/batch.
+     * @param data Payload (header followed by irCodeLen bytes)
+     * @param len  Payload length in bytes
+     * @param resp BinIrSendResponse to fill on success
+     * @return nullptr on success, otherwise a static error message
+     */
+    static const char* runIRSend(const uint8_t* data, size_t len, BinIrSendResponse* resp);
+
     // Public endpoints (no auth required)
     static void handlePing(WebServerType& server);
     
@@ -104,6 +200,35 @@ private:
     static void handleDeviceInfo(WebServerType& server);
     static void handleIRCapture(WebServerType& server);
     static void handleIRSend(WebServerType& server);
+
+    /**
+     * @brief IR code library: POST /api/ir/codes stores a code
+     *        (BinIrCodeHeader + payload), GET lists stored IDs, DELETE
+     *        removes one (BinIrCodeIdRequest).  POST /api/ir/fire sends a
+     *        stored code from a 2-byte BinIrCodeIdRequest; POST /api/ir/emit
+     *        sends a BinIrCodeHeader + payload without storing it.
+     */
+    static void handleIRCodeStore(WebServerType& server);
+    static void handleIRCodeList(WebServerType& server);
+    static void handleIRCodeRemove(WebServerType& server);
+    static void handleIRFire(WebServerType& server);
+    static void handleIREmit(WebServerType& server);
+
+    /**
+     * @brief IR transmit queue: POST /api/ir/queue queues a code (body as for
+     *        /api/ir/emit) and answers with a job ID before it is sent;
+     *        GET /api/ir/queue?job=<id> reports that job's BinIrJobState.
+     */
+    static void handleIRQueue(WebServerType& server);
+    static void handleIRQueueStatus(WebServerType& server);
+
+    /**
+     * @brief POST /api/batch — run several GPIO set / IR send / IR fire / IR emit
+     *        sub-commands in order under a single session check and return
+     *        one packed array of per-command statuses.
+     *        Body: BinBatchHeader + sub-commands.
+     */
+    static void handleBatch(WebServerType& server);
     static void handleSetWireless(WebServerType& server);
     static void handleGetWireless(WebServerType& server);
     static void handleWirelessScan(WebServerType& server);
@@ -113,6 +238,25 @@ private:
     static void handleRestart(WebServerType& server);
     static void handleReset(WebServerType& server);
 
+    /**
+     * @brief /api/keys — JWT verification keys selected by the header "kid".
+     *        GET (session): BinKeyListResponse.
+     *        POST (owner JWT): BinKeyAddRequest, adds or replaces a key.
+     *        DELETE (owner JWT): BinKeyRemoveRequest.
+     */
+    static void handleKeyList(WebServerType& server);
+    static void handleKeyAdd(WebServerType& server);
+    static void handleKeyRemove(WebServerType& server);
+
+#if FEATURE_ROUTE_METRICS_ENABLED
+    /**
+     * @brief GET /api/metrics — per-route call / 429 / byte counters and
+     *        latency histograms since boot.
+     *        Response: BinMetricsResponseHeader + BIN_ROUTE_COUNT × BinRouteMetrics
+     */
+    static void handleMetrics(WebServerType& server);
+#endif
+
 #if FEATURE_SLEEP_ENABLED
     /**
      * @brief PUT /api/sleep — enable or disable device sleep mode.
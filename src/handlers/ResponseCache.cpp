@@ -0,0 +1,102 @@
+#include "ResponseCache.h"
+#include "BinaryHelper.h"
+#include "../auth/SessionManager.h"
+#include "../network/WirelessNetworkManager.h"
+#include "../utils/Utils.h"
+
+volatile bool ResponseCache::s_stale        = true;
+bool          ResponseCache::s_sleepEnabled = false;
+
+char     ResponseCache::s_pingWire[BINARY_HEAD_MAX + sizeof(BinPingResponse)];
+uint16_t ResponseCache::s_pingLen = 0;
+uint16_t ResponseCache::s_pingChallengeOff = 0;
+char     ResponseCache::s_deviceWire[BINARY_HEAD_MAX + sizeof(BinDeviceInfoResponse)];
+uint16_t ResponseCache::s_deviceLen = 0;
+
+void ResponseCache::invalidate() {
+    s_stale = true;
+}
+
+void ResponseCache::setSleepEnabled(bool enabled) {
+    s_sleepEnabled = enabled;
+    invalidate();
+}
+
+void ResponseCache::consumeStale() {
+    if (!s_stale) return;
+    // Clear the flag before rebuilding so an event landing mid-rebuild
+    // marks the fresh copy stale again instead of being lost.
+    s_stale     = false;
+    s_pingLen   = 0;
+    s_deviceLen = 0;
+}
+
+void ResponseCache::sendPing(WebServerType& server) {
+    consumeStale();
+    if (s_pingLen == 0) buildPing();
+    if (s_pingLen == 0) {
+        sendBinaryError(server, 500, BIN_STATUS_ERROR, "Response build failed");
+        return;
+    }
+
+    // Every /ping carries a fresh nonce for this client — patched into the
+    // cached bytes rather than invalidating them.
+    const char* nonce = SessionManager::issueChallenge((uint32_t)server.client().remoteIP());
+    memcpy(s_pingWire + s_pingChallengeOff, nonce, sizeof(BinPingResponse::challenge));
+
+    sendPreparedResponse(server, s_pingWire, s_pingLen);
+}
+
+void ResponseCache::sendDeviceInfo(WebServerType& server) {
+    consumeStale();
+    if (s_deviceLen == 0) buildDeviceInfo();
+    if (s_deviceLen == 0) {
+        sendBinaryError(server, 500, BIN_STATUS_ERROR, "Response build failed");
+        return;
+    }
+    sendPreparedResponse(server, s_deviceWire, s_deviceLen);
+}
+
+void ResponseCache::buildPing() {
+    size_t headLen = formatBinaryHead(s_pingWire, BINARY_HEAD_MAX, 200, sizeof(BinPingResponse));
+    if (headLen == 0) return;  // s_pingLen stays 0, so the next request retries
+
+    BinPingResponse* resp = reinterpret_cast<BinPingResponse*>(s_pingWire + headLen);
+    memset(resp, 0, sizeof(*resp));
+    copyToField(resp->deviceID,      Utils::getDeviceIDString(), sizeof(resp->deviceID));
+    copyToField(resp->ipAddress,     WirelessNetworkManager::getIPAddress(), sizeof(resp->ipAddress));
+    copyToField(resp->deviceName,    Config::DEVICE_NAME, sizeof(resp->deviceName));
+    resp->isBound = SessionManager::hasBoundSub() ? 1 : 0;
+    copyToField(resp->platform_name, PLATFORM_NAME, sizeof(resp->platform_name));
+    copyToField(resp->platform_key,  PLATFORM_KEY, sizeof(resp->platform_key));
+
+    s_pingChallengeOff = (uint16_t)(headLen + offsetof(BinPingResponse, challenge));
+    s_pingLen          = (uint16_t)(headLen + sizeof(BinPingResponse));
+}
+
+void ResponseCache::buildDeviceInfo() {
+    size_t headLen = formatBinaryHead(s_deviceWire, BINARY_HEAD_MAX, 200, sizeof(BinDeviceInfoResponse));
+    if (headLen == 0) return;  // s_deviceLen stays 0, so the next request retries
+
+    BinDeviceInfoResponse* resp = reinterpret_cast<BinDeviceInfoResponse*>(s_deviceWire + headLen);
+    memset(resp, 0, sizeof(*resp));
+    copyToField(resp->deviceName, Config::DEVICE_NAME, sizeof(resp->deviceName));
+    copyToField(resp->deviceID,   Utils::getDeviceIDString(), sizeof(resp->deviceID));
+    copyToField(resp->macAddress, WirelessNetworkManager::getMacAddress(), sizeof(resp->macAddress));
+    copyToField(resp->ipAddress,  WirelessNetworkManager::getIPAddress(), sizeof(resp->ipAddress));
+
+#if defined(ARDUINO_ARCH_ESP8266)
+    copyToField(resp->platform, "ESP8266", sizeof(resp->platform));
+    resp->deviceIDDecimal = (uint32_t)Utils::getDeviceID();
+#elif defined(ARDUINO_ARCH_ESP32)
+    copyToField(resp->platform, "ESP32", sizeof(resp->platform));
+    resp->deviceIDDecimal = (uint32_t)(Utils::getDeviceID() & 0xFFFFFFFF);
+#endif
+    copyToField(resp->platform_name, PLATFORM_NAME, sizeof(resp->platform_name));
+    copyToField(resp->platform_key,  PLATFORM_KEY,  sizeof(resp->platform_key));
+    copyToField(resp->wirelessMode,  WirelessNetworkManager::getWirelessConfig().mode, sizeof(resp->wirelessMode));
+    resp->isBound      = SessionManager::hasBoundSub() ? 1 : 0;
+    resp->sleepEnabled = s_sleepEnabled ? 1 : 0;
+
+    s_deviceLen = (uint16_t)(headLen + sizeof(BinDeviceInfoResponse));
+}
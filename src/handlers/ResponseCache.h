@@ -0,0 +1,59 @@
+#ifndef RESPONSE_CACHE_H
+#define RESPONSE_CACHE_H
+
+#include <Arduino.h>
+#include "../platform/Platform.h"
+#include "../protocol/BinaryProtocol.h"
+
+// ════════════════════════════════════════════════════════════════════════
+// Prebuilt /ping and /api/device responses
+//
+// Both responses are kept as complete HTTP wire bytes (head + packed body)
+// and rebuilt only after invalidate() — called when something they report
+// changes: IP address, wireless mode, bind / unbind, or sleep toggle.  The
+// per-client challenge nonce is patched into the cached /ping bytes on each
+// send.  Discovery sweeps hit /ping hard, so the hot path is a single client
+// write with no formatting.
+// ════════════════════════════════════════════════════════════════════════
+
+class ResponseCache {
+public:
+    /**
+     * @brief Mark both responses stale.  Only sets a flag, so it is safe to
+     *        call from WiFi event callbacks (ESP32 runs them on another task).
+     */
+    static void invalidate();
+
+    /**
+     * @brief Record the sleep-mode state reported by /api/device and
+     *        invalidate.  ESPCommandHandler owns the setting.
+     */
+    static void setSleepEnabled(bool enabled);
+
+    /** @brief Send the cached BinPingResponse, rebuilding it first if stale. */
+    static void sendPing(WebServerType& server);
+
+    /** @brief Send the cached BinDeviceInfoResponse, rebuilding it first if stale. */
+    static void sendDeviceInfo(WebServerType& server);
+
+private:
+    // Leave the cached length at 0 if the head does not fit, so the next
+    // request rebuilds instead of sending a half-formed response.
+    static void buildPing();
+    static void buildDeviceInfo();
+
+    /** Drop both entries if invalidate() ran since the last send. */
+    static void consumeStale();
+
+    static volatile bool s_stale;
+    static bool          s_sleepEnabled;
+
+    // Wire bytes; length 0 means "rebuild before next send"
+    static char     s_pingWire[];
+    static uint16_t s_pingLen;
+    static uint16_t s_pingChallengeOff;  // offset of BinPingResponse::challenge in s_pingWire
+    static char     s_deviceWire[];
+    static uint16_t s_deviceLen;
+};
+
+#endif // RESPONSE_CACHE_H
@@ -1,12 +1,42 @@
 #include "GPIOManager.h"
 #include "../../utils/Utils.h"
 
+// Static member initialization
+GPIOConfigData GPIOManager::s_config;
+bool           GPIOManager::s_dirty        = false;
+uint32_t       GPIOManager::s_lastChangeMs = 0;
+
 void GPIOManager::begin() {
     Utils::printSerial(F("## Apply GPIO settings."));
+    StorageManager::loadGPIOConfig(s_config); // ok if missing — count stays 0
     BinGpioSetResponse dummy;
     applyGPIO(-1, 0, 0, &dummy);
 }
 
+void GPIOManager::tick() {
+    if (s_dirty && millis() - s_lastChangeMs >= Config::GPIO_FLUSH_QUIET_MS) {
+        if (!flush()) {
+            s_lastChangeMs = millis(); // retry after another quiet period
+        }
+    }
+}
+
+bool GPIOManager::flush() {
+    if (!s_dirty) return true;
+
+    if (!StorageManager::saveGPIOConfig(s_config)) {
+        Utils::printSerial(F("Failed to save GPIO configuration."));
+        return false;
+    }
+    s_dirty = false;
+    return true;
+}
+
+void GPIOManager::clearConfig() {
+    s_config = GPIOConfigData();
+    s_dirty  = false;
+}
+
 void GPIOManager::applyPinConfig(int pinNumber, uint8_t mode, int pinValue) {
     switch (mode) {
         case AP_GPIO_OUTPUT:
@@ -33,8 +63,7 @@ void GPIOManager::applyGPIO(int pinNumber, uint8_t mode, int pinValue,
                             BinGpioSetResponse* resp) {
     Utils::printSerial(F("Applying GPIO settings..."));
 
-    GPIOConfigData data;
-    StorageManager::loadGPIOConfig(data); // ok if missing — count stays 0
+    GPIOConfigData& data = s_config;
 
     memset(resp, 0, sizeof(BinGpioSetResponse));
     bool pinConfigExists = false;
@@ -47,6 +76,8 @@ void GPIOManager::applyGPIO(int pinNumber, uint8_t mode, int pinValue,
         // Update settings for specific pin
         if (pinNumber != -1 && cfg.pinNumber == pinNumber) {
             pinConfigExists = true;
+            const uint8_t oldMode  = cfg.mode;
+            const int     oldValue = cfg.pinValue;
             cfg.mode = mode;
 
             // Toggle if pinValue is -1
@@ -55,6 +86,11 @@ void GPIOManager::applyGPIO(int pinNumber, uint8_t mode, int pinValue,
             } else {
                 cfg.pinValue = pinValue;
             }
+
+            if (cfg.mode != oldMode || cfg.pinValue != oldValue) {
+                s_dirty        = true;
+                s_lastChangeMs = millis();
+            }
         }
 
         // Apply settings (either all if pinNumber == -1, or specific pin)
@@ -69,6 +105,8 @@ void GPIOManager::applyGPIO(int pinNumber, uint8_t mode, int pinValue,
         if (data.count < MAX_GPIO_PINS) {
             data.pins[data.count] = GPIOConfig(pinNumber, mode, pinValue);
             data.count++;
+            s_dirty        = true;
+            s_lastChangeMs = millis();
 
             applyPinConfig(pinNumber, mode, pinValue);
             returnPinValue = pinValue;
@@ -81,25 +119,14 @@ void GPIOManager::applyGPIO(int pinNumber, uint8_t mode, int pinValue,
         }
     }
 
-    // Save updated configuration
-    if (pinNumber != -1) {
-        if (!StorageManager::saveGPIOConfig(data)) {
-            Utils::printSerial(F("Failed to save GPIO configuration."));
-            resp->status = BIN_STATUS_ERROR;
-            resp->pinValue = -1;
-            strncpy(resp->error, "Failed to save config", sizeof(resp->error) - 1);
-            return;
-        }
-    }
-
+    // Flash write is deferred to tick()/flush()
     resp->status = BIN_STATUS_OK;
     resp->pinValue = returnPinValue;
 }
 
 void GPIOManager::getGPIO(int pinNumber, BinGpioGetHeader* header,
                           BinGpioPin* pins) {
-    GPIOConfigData data;
-    StorageManager::loadGPIOConfig(data);
+    const GPIOConfigData& data = s_config;
 
     header->status = BIN_STATUS_OK;
 
@@ -6,12 +6,32 @@
 #include "../../storage/StorageManager.h"
 #include "../../protocol/BinaryProtocol.h"
 
+// GPIO state lives in RAM (s_config) and is the authority for get/set.
+// Changes only mark it dirty; tick() writes it to flash once no change has
+// arrived for Config::GPIO_FLUSH_QUIET_MS, and flush() forces the write
+// before a restart or OTA update.
 class GPIOManager {
 public:
     /**
-     * @brief Initialize GPIO manager and apply stored settings
+     * @brief Load stored settings into RAM and apply them to the pins
      */
     static void begin();
+
+    /**
+     * @brief Persist GPIO state after a quiet period. Call from loop().
+     */
+    static void tick();
+
+    /**
+     * @brief Persist GPIO state now if it has unsaved changes
+     * @return true if nothing was pending or the save succeeded
+     */
+    static bool flush();
+
+    /**
+     * @brief Forget all pin settings in RAM (storage was already wiped)
+     */
+    static void clearConfig();
     
     /**
      * @brief Apply GPIO settings for a specific pin (binary response)
@@ -24,7 +44,7 @@ public:
                           BinGpioSetResponse* resp);
 
     /**
-     * @brief Get GPIO configuration for a pin (binary response)
+     * @brief Get GPIO configuration for a pin from RAM (binary response)
      * @param pinNumber GPIO pin number (-1 to get all pins)
      * @param header    Pointer to BinGpioGetHeader to fill
      * @param pins      Pointer to BinGpioPin array to fill (max MAX_GPIO_PINS)
@@ -47,6 +67,10 @@ private:
      * @param pinValue  Pin value
      */
     static void applyPinConfig(int pinNumber, uint8_t mode, int pinValue);
+
+    static GPIOConfigData s_config;       // authoritative pin settings
+    static bool           s_dirty;        // s_config differs from flash
+    static uint32_t       s_lastChangeMs; // millis() of the latest change
 };
 
 #endif // GPIO_MANAGER_H
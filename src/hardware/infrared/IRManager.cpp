@@ -1,9 +1,15 @@
 #include "IRManager.h"
-#include <ArduinoJson.h>  // only used in sendRawArray/sendIRState for JSON array parsing
 
 IRrecv* IRManager::irRecv = nullptr;
 IRsend* IRManager::irSend = nullptr;
 decode_results IRManager::results;
+IRCaptureSession IRManager::captureSession;
+IRTxQueue IRManager::txQueue;
+
+static_assert(Config::IR_TX_STATUS_SLOTS >= Config::IR_TX_QUEUE_DEPTH,
+              "a queued job's status slot must not be recycled before it is sent");
+static_assert(Config::IR_TX_QUEUE_BYTES >= Config::IR_LIBRARY_CODE_BYTES,
+              "the transmit queue must hold the largest code");
 
 void IRManager::begin() {
     Utils::printSerial(F("## Begin IR Receiver lib."));
@@ -19,8 +25,60 @@ void IRManager::begin() {
     irSend->begin();
 }
 
+namespace {
+
+/** LEB128: 7 bits per byte, low bits first. @return bytes written, 0 if it does not fit */
+inline size_t putVarint(uint32_t v, uint8_t* out, size_t cap) {
+    size_t n = 0;
+    do {
+        if (n == cap) return 0;
+        uint8_t b = v & 0x7F;
+        v >>= 7;
+        out[n++] = v ? (b | 0x80) : b;
+    } while (v);
+    return n;
+}
+
+/** Map signed to unsigned so small magnitudes of either sign stay small. */
+inline uint32_t zigzag(int32_t d) {
+    return ((uint32_t)d << 1) ^ (uint32_t)(d >> 31);
+}
+
+} // namespace
+
+size_t IRManager::encodeRawCapture(const decode_results* results,
+                                   uint8_t* buf, size_t bufSize) {
+    if (bufSize < sizeof(BinIrRawCaptureEventHeader)) return 0;
+
+    uint8_t* out = buf + sizeof(BinIrRawCaptureEventHeader);
+    size_t   cap = bufSize - sizeof(BinIrRawCaptureEventHeader);
+    size_t   pos = 0;
+
+    // rawbuf[0] is the gap before the signal; timings start at index 1 and
+    // alternate mark, space, mark...  Each is predicted by the previous one
+    // of the same kind, so a steady pulse train codes to 1 byte per timing.
+    uint16_t prev[2] = { 0, 0 };
+    uint16_t count = 0;
+    for (uint16_t i = 1; i < results->rawlen; i++, count++) {
+        const uint16_t t = results->rawbuf[i];
+        uint16_t& p = prev[count & 1];
+        size_t n = putVarint(zigzag((int32_t)t - (int32_t)p), out + pos, cap - pos);
+        if (n == 0) return 0;
+        pos += n;
+        p = t;
+    }
+
+    BinIrRawCaptureEventHeader hdr;
+    hdr.eventType = BIN_IR_EVENT_CAPTURE_RAW;
+    hdr.tickUs    = kRawTick;
+    hdr.count     = count;
+    hdr.dataLen   = (uint16_t)pos;
+    memcpy(buf, &hdr, sizeof(hdr));
+    return sizeof(hdr) + pos;
+}
+
 size_t IRManager::generateIRResult(const decode_results* results,
-                                    uint8_t* buf, size_t bufSize) {
+                                    uint8_t* buf, size_t bufSize, bool compact) {
     if (!results || bufSize < sizeof(BinIrCaptureEventHeader)) {
         return 0;
     }
@@ -29,6 +87,10 @@ size_t IRManager::generateIRResult(const decode_results* results,
     uint16_t size = results->bits;
     
     irRecv->disableIRIn();
+
+    if (compact && protocol == decode_type_t::UNKNOWN) {
+        return encodeRawCapture(results, buf, bufSize);
+    }
     
     BinIrCaptureEventHeader* header = reinterpret_cast<BinIrCaptureEventHeader*>(buf);
     header->eventType = BIN_IR_EVENT_CAPTURE;
@@ -92,111 +154,158 @@ size_t IRManager::generateIRResult(const decode_results* results,
     return sizeof(BinIrCaptureEventHeader) + irCodeLen;
 }
 
-void IRManager::captureIR(int captureMode, WebServerType& server) {
+// Buffers for base64-encoded binary events.
+// Max text event: sizeof(BinIrCaptureEventHeader) + ~6000 bytes irCode;
+// large raw captures get truncated to what fits in captureBinBuf.  Compact
+// raw events need at most 3 varint bytes per 16-bit tick count and always fit.
+static uint8_t captureBinBuf[4096];
+static_assert(sizeof(BinIrRawCaptureEventHeader) + 3 * Config::CAPTURE_BUFFER_SIZE <= sizeof(captureBinBuf),
+              "compact raw capture must never truncate");
+// One HTTP chunk: "<hex>\r\n" + "data: " + base64 + "\n\n" + "\r\n".
+// The chunk-size line is right-aligned into the first CHUNK_HEAD bytes once
+// the event length is known, so the whole frame goes out in one write.
+static constexpr size_t CHUNK_HEAD = 8;
+static char captureEventBuf[CHUNK_HEAD + 6 + Base64::encodedLength(sizeof(captureBinBuf)) + 4 + 1];
+
+void IRManager::sendCaptureEvent(const uint8_t* data, size_t len) {
+    char* body = captureEventBuf + CHUNK_HEAD;
+    memcpy(body, "data: ", 6);
+    size_t bodyLen = 6 + Base64::encode(data, len, body + 6);
+    memcpy(body + bodyLen, "\n\n\r\n", 4);
+
+    char sizeLine[CHUNK_HEAD + 1];
+    int n = snprintf(sizeLine, sizeof(sizeLine), "%X\r\n", (unsigned)(bodyLen + 2));
+    char* frame = body - n;
+    memcpy(frame, sizeLine, n);
+    captureSession.client.write(reinterpret_cast<const uint8_t*>(frame), n + bodyLen + 4);
+}
+
+void IRManager::endCapture() {
+    irRecv->disableIRIn();
+    Utils::setLED(HIGH);
+    if (captureSession.client.connected()) {
+        // Zero-length chunk terminates the chunked body
+        captureSession.client.write(reinterpret_cast<const uint8_t*>("0\r\n\r\n"), 5);
+    }
+    captureSession.client.stop();
+    captureSession.client = WiFiClient();
+    captureSession.active = false;
+}
+
+bool IRManager::isCapturing() {
+    return captureSession.active;
+}
+
+bool IRManager::startCapture(int captureMode, uint8_t flags, WebServerType& server) {
+    if (captureSession.active) return false;
+
     Utils::printSerial(F("\nBeginning IR capture procedure"));
 
-    // Start SSE response — chunked transfer, never a fixed Content-Length
-    server.setContentLength(CONTENT_LENGTH_UNKNOWN);
-    server.sendHeader("Cache-Control", "no-cache");
-    server.sendHeader("Connection", "keep-alive");
-    server.send(200, "text/event-stream", "");
+    IRCaptureSession& cs = captureSession;
+    cs.client       = server.client();
+    cs.active       = true;
+    cs.multiCapture = (captureMode == 1);
+    cs.compact      = (flags & BIN_IR_CAPTURE_COMPACT) != 0;
+    cs.startTime    = millis();
+    cs.previousTime = -1;
+    cs.ledState     = HIGH;
 
-    irRecv->enableIRIn();
+    // SSE response head — chunked transfer, never a fixed Content-Length.
+    // Written to the socket directly: the WebServer finalises any response it
+    // started once the handler returns, but this stream outlives the handler.
+    static const char head[] PROGMEM =
+        "HTTP/1.1 200 OK\r\n"
+        "Content-Type: text/event-stream\r\n"
+        "Cache-Control: no-cache\r\n"
+        "Access-Control-Allow-Origin: *\r\n"
+        "Transfer-Encoding: chunked\r\n"
+        "Connection: close\r\n"
+        "\r\n";
+    char headBuf[sizeof(head)];
+    memcpy_P(headBuf, head, sizeof(head));
+    cs.client.setNoDelay(true);
+    cs.client.write(reinterpret_cast<const uint8_t*>(headBuf), sizeof(head) - 1);
 
-    // Buffers for base64-encoded binary events
-    // Max binary event: sizeof(BinIrCaptureEventHeader) + ~6000 bytes irCode
-    // We'll use a reasonable buffer; large raw captures get truncated
-    static uint8_t binBuf[4096];
-    static char b64Buf[5500]; // ((4096+2)/3)*4 + 1
-    char eventBuf[64];
-    
-    uint32_t startTime = millis();
-    int currentTime = 0;
-    int previousTime = -1;
-    int blinkCounter = 0;
-    bool multiCapture = (captureMode == 1);
+    irRecv->enableIRIn();
 
     // Send initial countdown value (binary progress event, base64-encoded)
-    {
+    BinIrProgressEvent prog;
+    prog.eventType = BIN_IR_EVENT_PROGRESS;
+    prog.value = Config::RECV_TIMEOUT_SEC;
+    sendCaptureEvent(reinterpret_cast<uint8_t*>(&prog), sizeof(prog));
+    return true;
+}
+
+void IRManager::tick() {
+    drainTxQueue();
+
+    IRCaptureSession& cs = captureSession;
+    if (!cs.active) return;
+
+    // Client went away — release the receiver without a timeout event
+    if (!cs.client.connected()) {
+        Utils::printSerial(F("IR capture: client disconnected"));
+        endCapture();
+        return;
+    }
+
+    unsigned long elapsed = millis() - cs.startTime;
+    int currentTime = (int)(elapsed / 1000);
+
+    if (currentTime >= Config::RECV_TIMEOUT_SEC) {
+        // Timeout — send final event then close stream
+        BinIrTimeoutEvent timeout;
+        timeout.eventType = BIN_IR_EVENT_TIMEOUT;
+        sendCaptureEvent(reinterpret_cast<uint8_t*>(&timeout), sizeof(timeout));
+        endCapture();
+        return;
+    }
+
+    // Send countdown once per second
+    if (currentTime > cs.previousTime) {
         BinIrProgressEvent prog;
         prog.eventType = BIN_IR_EVENT_PROGRESS;
-        prog.value = Config::RECV_TIMEOUT_SEC;
-        size_t b64Len = Base64::encode(reinterpret_cast<uint8_t*>(&prog), sizeof(prog), b64Buf);
-        snprintf(eventBuf, sizeof(eventBuf), "data: ");
-        server.sendContent(eventBuf);
-        server.sendContent(b64Buf, b64Len);
-        server.sendContent("\n\n");
+        prog.value = (uint8_t)(Config::RECV_TIMEOUT_SEC - currentTime);
+        sendCaptureEvent(reinterpret_cast<uint8_t*>(&prog), sizeof(prog));
+        cs.previousTime = currentTime;
     }
 
-    WiFiClient client = server.client();
-    while ((currentTime < Config::RECV_TIMEOUT_SEC) && client.connected()) {
-        currentTime = (int)((millis() - startTime) / 1000);
-
-        // Send countdown once per second
-        if (currentTime > previousTime) {
-            Utils::setLED(HIGH);
-            BinIrProgressEvent prog;
-            prog.eventType = BIN_IR_EVENT_PROGRESS;
-            prog.value = (uint8_t)(Config::RECV_TIMEOUT_SEC - currentTime);
-            size_t b64Len = Base64::encode(reinterpret_cast<uint8_t*>(&prog), sizeof(prog), b64Buf);
-            snprintf(eventBuf, sizeof(eventBuf), "data: ");
-            server.sendContent(eventBuf);
-            server.sendContent(b64Buf, b64Len);
-            server.sendContent("\n\n");
-            previousTime = currentTime;
-        }
-
-        // Check for IR signal
-        if (irRecv->decode(&results)) {
-            irRecv->disableIRIn();
-            size_t totalLen = generateIRResult(&results, binBuf, sizeof(binBuf));
-
-            if (totalLen > 0) {
-                // Emit the captured signal as a base64-encoded SSE event
-                size_t b64Len = Base64::encode(binBuf, totalLen, b64Buf);
-                server.sendContent("data: ");
-                server.sendContent(b64Buf, b64Len);
-                server.sendContent("\n\n");
-            }
+    // Check for IR signal
+    if (irRecv->decode(&results)) {
+        irRecv->disableIRIn();
+        size_t totalLen = generateIRResult(&results, captureBinBuf, sizeof(captureBinBuf), cs.compact);
 
-            if (multiCapture) {
-                // Re-arm receiver for next capture; reset timer
-                irRecv->enableIRIn();
-                irRecv->resume();
-                startTime = millis();
-                currentTime = 0;
-                previousTime = -1;
-            } else {
-                Utils::setLED(HIGH);
-                // Close the SSE stream
-                server.sendContent("");
-                return;
-            }
+        if (totalLen > 0) {
+            // Emit the captured signal as a base64-encoded SSE event
+            sendCaptureEvent(captureBinBuf, totalLen);
         }
 
-        // LED blinking for visual feedback
-        if (blinkCounter % 100 == 0)       Utils::setLED(LOW);
-        else if ((blinkCounter - 8) % 100 == 0) Utils::setLED(HIGH);
-
-        delay(1);
-        yield();
-        blinkCounter++;
+        if (cs.multiCapture) {
+            // Re-arm receiver for next capture; reset timer
+            irRecv->enableIRIn();
+            irRecv->resume();
+            cs.startTime = millis();
+            cs.previousTime = -1;
+        } else {
+            endCapture();
+        }
+        return;
     }
 
-    Utils::setLED(HIGH);
-
-    // Timeout — send final event then close stream
-    {
-        BinIrTimeoutEvent timeout;
-        timeout.eventType = BIN_IR_EVENT_TIMEOUT;
-        size_t b64Len = Base64::encode(reinterpret_cast<uint8_t*>(&timeout), sizeof(timeout), b64Buf);
-        server.sendContent("data: ");
-        server.sendContent(b64Buf, b64Len);
-        server.sendContent("\n\n");
+    // LED blinking for visual feedback: 8 ms LOW at the start of every 100 ms
+    uint8_t led = ((elapsed % 100) < 8) ? LOW : HIGH;
+    if (led != cs.ledState) {
+        Utils::setLED(led);
+        cs.ledState = led;
     }
-    server.sendContent("");
 }
 
+// Shared transmit buffer for every send path: raw timings, AC state bytes,
+// or a code loaded from the IR library.  uint16_t keeps sendRaw() aligned.
+static uint16_t txBuf[Config::IR_LIBRARY_CODE_BYTES / 2];
+static_assert(Config::IR_RAW_SEND_MAX <= sizeof(txBuf) / sizeof(txBuf[0]),
+              "txBuf must hold a full raw array");
+
 void IRManager::sendIR(const char* protocolStr, uint16_t bitLength,
                        const char* irCode, uint16_t irCodeLen,
                        BinIrSendResponse* resp) {
@@ -204,13 +313,13 @@ void IRManager::sendIR(const char* protocolStr, uint16_t bitLength,
     decode_type_t protocol = strToDecodeType(protocolStr);
 
     if (protocol == decode_type_t::UNKNOWN) {
-        sendRawArray(bitLength, irCode);
+        sendRawArray(bitLength, irCode, irCodeLen);
         resp->status = BIN_STATUS_OK;
         strncpy(resp->response, "success", sizeof(resp->response) - 1);
     } else {
         bool success = hasACState(protocol)
-            ? sendIRState(bitLength, protocol, irCode)
-            : sendIRValue(bitLength, protocol, irCode);
+            ? sendIRState(bitLength, protocol, irCode, irCodeLen)
+            : sendIRValue(bitLength, protocol, irCode, irCodeLen);
         resp->status = success ? BIN_STATUS_OK : BIN_STATUS_ERROR;
         snprintf(resp->response, sizeof(resp->response), "%s %s",
                  typeToString(protocol).c_str(),
@@ -218,48 +327,225 @@ void IRManager::sendIR(const char* protocolStr, uint16_t bitLength,
     }
 }
 
-void IRManager::sendRawArray(uint16_t size, const char* irData) {
-    JsonDocument json;
-    if (deserializeJson(json, irData) != DeserializationError::Ok) {
-        Utils::printSerial(F("sendRawArray: JSON parse error"));
-        return;
+const char* IRManager::validateCode(const BinIrCodeHeader& hdr) {
+    const decode_type_t protocol = static_cast<decode_type_t>(hdr.protocol);
+    const bool knownProtocol = hdr.protocol > 0 && hdr.protocol <= kLastDecodeType;
+
+    switch (hdr.kind) {
+        case BIN_IR_CODE_VALUE:
+            if (!knownProtocol || hasACState(protocol) || hdr.bits == 0 || hdr.dataLen != 8) {
+                return "Invalid IR value code";
+            }
+            return nullptr;
+        case BIN_IR_CODE_STATE:
+            if (!knownProtocol || !hasACState(protocol) || hdr.bits == 0 || hdr.dataLen != hdr.bits ||
+                hdr.dataLen > Config::IR_LIBRARY_CODE_BYTES) {
+                return "Invalid IR state code";
+            }
+            return nullptr;
+        case BIN_IR_CODE_RAW:
+            if (hdr.bits == 0 || hdr.bits > Config::IR_RAW_SEND_MAX || hdr.dataLen != hdr.bits * 2) {
+                return "Invalid IR raw code";
+            }
+            return nullptr;
+        default:
+            return "Unknown IR code kind";
+    }
+}
+
+const char* IRManager::storeCode(const BinIrCodeHeader& hdr, const uint8_t* data) {
+    const char* error = validateCode(hdr);
+    if (error) return error;
+    return IrLibrary::store(hdr, data) ? nullptr : "IR library full or write failed";
+}
+
+const char* IRManager::sendCode(const BinIrCodeHeader& hdr, const uint8_t* data,
+                                BinIrSendResponse* resp) {
+    const char* error = validateCode(hdr);
+    if (error) return error;
+
+    memset(resp, 0, sizeof(BinIrSendResponse));
+    const decode_type_t protocol = static_cast<decode_type_t>(hdr.protocol);
+    bool success = false;
+
+    switch (hdr.kind) {
+        case BIN_IR_CODE_VALUE: {
+            uint64_t value;
+            memcpy(&value, data, sizeof(value));
+            success = irSend->send(protocol, value, hdr.bits);
+            break;
+        }
+        case BIN_IR_CODE_STATE:
+            success = irSend->send(protocol, data, hdr.bits);
+            break;
+        case BIN_IR_CODE_RAW: {
+            // Timings are sent in place; only an odd address (possible inside
+            // a batch) needs the copy, as Xtensa faults on unaligned loads.
+            const uint16_t* timings = reinterpret_cast<const uint16_t*>(data);
+            if (reinterpret_cast<uintptr_t>(data) & 1) {
+                memcpy(txBuf, data, hdr.dataLen);
+                timings = txBuf;
+            }
+            irSend->sendRaw(timings, hdr.bits, Config::IR_FREQUENCY);
+            success = true;
+            break;
+        }
+        default:
+            break;
+    }
+
+    resp->status = success ? BIN_STATUS_OK : BIN_STATUS_ERROR;
+    if (hdr.kind == BIN_IR_CODE_RAW) {
+        strncpy(resp->response, "success", sizeof(resp->response) - 1);
+    } else {
+        snprintf(resp->response, sizeof(resp->response), "%s %s",
+                 typeToString(protocol).c_str(),
+                 success ? "success" : "failure");
+    }
+    return nullptr;
+}
+
+bool IRManager::sendStored(uint16_t id, BinIrSendResponse* resp) {
+    memset(resp, 0, sizeof(BinIrSendResponse));
+
+    uint8_t* data = reinterpret_cast<uint8_t*>(txBuf);
+    BinIrCodeHeader hdr;
+    if (!IrLibrary::load(id, hdr, data, sizeof(txBuf))) {
+        resp->status = BIN_STATUS_ERROR;
+        strncpy(resp->response, "Unknown IR code", sizeof(resp->response) - 1);
+        return false;
     }
 
-    // Clamp to compile-time maximum to prevent stack overflow
+    const char* error = sendCode(hdr, data, resp);
+    if (error) {
+        resp->status = BIN_STATUS_ERROR;
+        strncpy(resp->response, error, sizeof(resp->response) - 1);
+    }
+    return true;
+}
+
+void IRManager::sendRawArray(uint16_t size, const char* irData, uint16_t len) {
+    // Clamp to compile-time maximum
     const uint16_t safeSize = (size > Config::IR_RAW_SEND_MAX)
                               ? Config::IR_RAW_SEND_MAX : size;
 
-    uint16_t* rawData = new(std::nothrow) uint16_t[safeSize];
-    if (!rawData) {
-        Utils::printSerial(F("sendRawArray: alloc failed"));
-        return;
+    // "[9000,4500,560,...]" — every run of decimal digits is one timing
+    uint16_t count = 0;
+    uint16_t i = 0;
+    while (count < safeSize && i < len) {
+        if (!isdigit((unsigned char)irData[i])) {
+            i++;
+            continue;
+        }
+        uint32_t v = 0;
+        while (i < len && isdigit((unsigned char)irData[i])) {
+            if (v <= UINT16_MAX) v = v * 10 + (irData[i] - '0');
+            i++;
+        }
+        txBuf[count++] = (v > UINT16_MAX) ? UINT16_MAX : (uint16_t)v;
     }
 
-    for (uint16_t i = 0; i < safeSize; i++) {
-        rawData[i] = json[i].as<uint16_t>();
+    if (count == 0) {
+        Utils::printSerial(F("sendRawArray: no timings"));
+        return;
     }
-
-    irSend->sendRaw(rawData, safeSize, Config::IR_FREQUENCY);
-    delete[] rawData;
+    irSend->sendRaw(txBuf, count, Config::IR_FREQUENCY);
 }
 
-bool IRManager::sendIRValue(uint16_t size, decode_type_t protocol, const char* irData) {
-    uint64_t value = Utils::getUInt64FromHex(irData);
+bool IRManager::sendIRValue(uint16_t size, decode_type_t protocol, const char* irData, uint16_t len) {
+    uint64_t value = Utils::getUInt64FromHex(irData, len);
     return irSend->send(protocol, value, size);
 }
 
-bool IRManager::sendIRState(uint16_t size, decode_type_t protocol, const char* data) {
-    String stateListString = String(data);
-    stateListString.replace("'", "\"");
-    
-    JsonDocument doc;
-    deserializeJson(doc, stateListString.c_str());
-    
-    uint8_t stateList[size];
-    for (uint16_t i = 0; i < size; i++) {
-        const char* hexStr = doc[i];
-        stateList[i] = strtol(hexStr, NULL, 16);
+bool IRManager::sendIRState(uint16_t size, decode_type_t protocol, const char* data, uint16_t len) {
+    if (size == 0 || size > sizeof(txBuf)) return false;
+
+    // "['0x01','0xA4',...]" — one optionally 0x-prefixed hex number per element
+    uint8_t* state = reinterpret_cast<uint8_t*>(txBuf);
+    uint16_t count = 0;
+    uint16_t i = 0;
+    while (count < size && i < len) {
+        if (!isxdigit((unsigned char)data[i])) {
+            i++;
+            continue;
+        }
+        if (data[i] == '0' && i + 1 < len && (data[i + 1] == 'x' || data[i + 1] == 'X')) {
+            i += 2;
+        }
+        uint8_t v = 0;
+        while (i < len && isxdigit((unsigned char)data[i])) {
+            char c = data[i++];
+            v = (uint8_t)((v << 4) | (isdigit((unsigned char)c) ? c - '0' : (c | 0x20) - 'a' + 10));
+        }
+        state[count++] = v;
     }
-    
-    return irSend->send(protocol, stateList, size);
+
+    if (count != size) return false;
+    return irSend->send(protocol, state, size);
+}
+
+const char* IRManager::enqueue(const BinIrCodeHeader& hdr, const uint8_t* data, uint16_t& jobId) {
+    jobId = 0;
+    if (hdr.kind == BIN_IR_CODE_STORED) {
+        if (hdr.dataLen != 0) return "Invalid stored IR code reference";
+    } else {
+        const char* error = validateCode(hdr);
+        if (error) return error;
+    }
+
+    IRTxQueue& q = txQueue;
+    if (q.count == Config::IR_TX_QUEUE_DEPTH || hdr.dataLen > sizeof(q.data) - q.used) {
+        return nullptr;
+    }
+
+    IRTxJob& job = q.jobs[q.count++];
+    job.jobId = q.nextJobId++;
+    if (q.nextJobId == 0) q.nextJobId = 1;
+    job.code  = hdr;
+    memcpy(reinterpret_cast<uint8_t*>(q.data) + q.used, data, hdr.dataLen);
+    q.used += hdr.dataLen;
+
+    setJobState(job.jobId, BIN_IR_JOB_QUEUED);
+    jobId = job.jobId;
+    return nullptr;
+}
+
+void IRManager::drainTxQueue() {
+    IRTxQueue& q = txQueue;
+    if (q.count == 0) return;
+
+    const IRTxJob job = q.jobs[0];
+    uint8_t* data = reinterpret_cast<uint8_t*>(q.data);
+
+    // The capture session owns the LED while it runs
+    const bool ownLED = !captureSession.active;
+    if (ownLED) Utils::setLED(LOW);
+    BinIrSendResponse resp;
+    bool ok = (job.code.kind == BIN_IR_CODE_STORED)
+        ? sendStored(job.code.id, &resp)
+        : sendCode(job.code, data, &resp) == nullptr;
+    ok = ok && resp.status == BIN_STATUS_OK;
+    if (ownLED) Utils::setLED(HIGH);
+
+    q.used -= job.code.dataLen;
+    memmove(data, data + job.code.dataLen, q.used);
+    memmove(&q.jobs[0], &q.jobs[1], --q.count * sizeof(IRTxJob));
+
+    setJobState(job.jobId, ok ? BIN_IR_JOB_DONE : BIN_IR_JOB_FAILED);
+}
+
+void IRManager::setJobState(uint16_t jobId, uint8_t state) {
+    IRTxJobStatus& st = txQueue.status[jobId % Config::IR_TX_STATUS_SLOTS];
+    st.jobId = jobId;
+    st.state = state;
+}
+
+uint8_t IRManager::getJobStatus(uint16_t jobId) {
+    const IRTxJobStatus& st = txQueue.status[jobId % Config::IR_TX_STATUS_SLOTS];
+    if (jobId == 0 || st.jobId != jobId) return BIN_IR_JOB_UNKNOWN;
+    return st.state;
+}
+
+uint8_t IRManager::pendingJobs() {
+    return txQueue.count;
 }
@@ -9,14 +9,63 @@
 #include <IRutils.h>
 #include "../../config/Config.h"
 #include "../../utils/Utils.h"
+#include "../../utils/Base64.h"
 #include "../../platform/Platform.h"
 #include "../../protocol/BinaryProtocol.h"
+#include "../../storage/IrLibrary.h"
+
+// ── IR capture session ────────────────────────────────────────────────────────
+// State of the one in-flight /api/ir/capture request.  The SSE response is
+// written straight to the client socket (the WebServer has already moved on to
+// other requests), and IRManager::tick() advances it from loop().
+struct IRCaptureSession {
+    WiFiClient    client;        // SSE connection (kept open across loop() passes)
+    bool          active;
+    bool          multiCapture;  // stay open after a capture, re-arming the timer
+    bool          compact;       // raw captures as BIN_IR_EVENT_CAPTURE_RAW
+    unsigned long startTime;     // millis() when the countdown (re)started
+    int           previousTime;  // last countdown second reported, -1 = none yet
+    uint8_t       ledState;      // last value written to the status LED
+
+    IRCaptureSession()
+        : active(false), multiCapture(false), compact(false), startTime(0), previousTime(-1),
+          ledState(HIGH) {}
+};
+
+// ── IR transmit queue ─────────────────────────────────────────────────────────
+// Codes accepted by /api/ir/queue wait here until loop() reaches
+// IRManager::tick(), so the HTTP response goes out before the blocking
+// waveform.  Payloads sit back-to-back in `data` in job order: the head job's
+// payload always starts at data[0], which keeps raw timings aligned, and is
+// shifted out once the job has been sent.
+struct IRTxJob {
+    uint16_t        jobId;
+    BinIrCodeHeader code;
+};
+
+struct IRTxJobStatus {
+    uint16_t jobId;
+    uint8_t  state;  // BinIrJobState
+};
+
+struct IRTxQueue {
+    IRTxJob       jobs[Config::IR_TX_QUEUE_DEPTH];
+    uint8_t       count;
+    uint16_t      used;        // payload bytes in data
+    uint16_t      nextJobId;   // never 0
+    uint16_t      data[Config::IR_TX_QUEUE_BYTES / 2];
+    IRTxJobStatus status[Config::IR_TX_STATUS_SLOTS];  // indexed by jobId % slots
+
+    IRTxQueue() : count(0), used(0), nextJobId(1), status() {}
+};
 
 class IRManager {
 private:
     static IRrecv* irRecv;
     static IRsend* irSend;
     static decode_results results;
+    static IRCaptureSession captureSession;
+    static IRTxQueue txQueue;
     
 public:
     /**
@@ -25,64 +74,149 @@ public:
     static void begin();
     
     /**
-     * @brief Capture IR signal and stream results via SSE.
+     * @brief Begin an IR capture and stream results via SSE.
      *        captureMode: 0 = single capture, 1 = multi-capture (stays open until timeout)
-     *        Sends HTTP 200 text/event-stream directly; caller must NOT send any additional
-     *        response after calling this function.
+     *        Sends the HTTP 200 text/event-stream head and the initial progress event,
+     *        then returns; tick() drives the rest of the session from loop().
      *        SSE event data fields are base64-encoded binary structs.
+     *        The caller must NOT send any response when this returns true.
      * @param captureMode 0=single, 1=multi
-     * @param server WebServer instance (response sent inside)
+     * @param flags  BinIrCaptureFlags (BIN_IR_CAPTURE_COMPACT for varint raw events)
+     * @param server WebServer instance (its current client is taken over)
+     * @return false if another capture is already in progress (nothing sent)
      */
-    static void captureIR(int captureMode, WebServerType& server);
+    static bool startCapture(int captureMode, uint8_t flags, WebServerType& server);
+
+    /**
+     * @brief Send the oldest queued code (one per call), then advance the
+     *        active capture session: countdown events, decode check, LED
+     *        blink and timeout.  Call from loop(); no-op when idle.
+     */
+    static void tick();
+
+    /** @return true while a capture session owns the IR receiver. */
+    static bool isCapturing();
     
     /**
      * @brief Send IR signal (binary interface)
      * @param protocol Protocol name string
      * @param bitLength Bit length / raw size
-     * @param irCode   IR code data (hex string or array string)
+     * @param irCode   IR code data (hex string or array string, need not be NUL-terminated)
      * @param irCodeLen Length of irCode string
      * @param resp     Pointer to BinIrSendResponse to fill
      */
     static void sendIR(const char* protocol, uint16_t bitLength,
                        const char* irCode, uint16_t irCodeLen,
                        BinIrSendResponse* resp);
+
+    /**
+     * @brief Validate a code against its kind and protocol, then store it in
+     *        the IR library
+     * @param hdr  Code header (hdr.dataLen payload bytes follow in @p data)
+     * @param data Payload in the layout given by hdr.kind
+     * @return nullptr on success, otherwise a static error message
+     */
+    static const char* storeCode(const BinIrCodeHeader& hdr, const uint8_t* data);
+
+    /**
+     * @brief Send a code given in binary form, straight from the caller's
+     *        buffer (no parsing, no copy unless raw timings are misaligned)
+     * @param hdr  Code header (hdr.dataLen payload bytes follow in @p data)
+     * @param data Payload in the layout given by hdr.kind (little-endian)
+     * @param resp Pointer to BinIrSendResponse to fill
+     * @return nullptr on success, otherwise a static error message
+     */
+    static const char* sendCode(const BinIrCodeHeader& hdr, const uint8_t* data,
+                                BinIrSendResponse* resp);
+
+    /**
+     * @brief Send a code from the IR library by ID (binary interface)
+     * @param id   Stored code ID
+     * @param resp Pointer to BinIrSendResponse to fill
+     * @return false if the ID is unknown (resp is still filled)
+     */
+    static bool sendStored(uint16_t id, BinIrSendResponse* resp);
     
+    /**
+     * @brief Queue a code for tick() to send; returns without transmitting.
+     * @param hdr   Code header; kind BIN_IR_CODE_STORED fires library code hdr.id
+     * @param data  Payload (hdr.dataLen bytes), copied into the queue
+     * @param jobId Output: ID for getJobStatus(), 0 if the queue had no room
+     * @return nullptr unless the code itself is invalid (static error message)
+     */
+    static const char* enqueue(const BinIrCodeHeader& hdr, const uint8_t* data, uint16_t& jobId);
+
+    /** @return BinIrJobState of @p jobId */
+    static uint8_t getJobStatus(uint16_t jobId);
+
+    /** @return Number of queued jobs not yet sent */
+    static uint8_t pendingJobs();
+
     /**
      * @brief Generate binary IR capture event from decode_results.
      *        Writes header + irCode data into caller-provided buffer.
      * @param results Pointer to decode_results
      * @param buf     Output buffer (must be large enough)
      * @param bufSize Size of output buffer
+     * @param compact Encode UNKNOWN (raw) captures as BIN_IR_EVENT_CAPTURE_RAW
      * @return Total bytes written (header + irCode data), or 0 on error
      */
     static size_t generateIRResult(const decode_results* results,
+                                   uint8_t* buf, size_t bufSize, bool compact = false);
+
+    /**
+     * @brief Encode raw timings as a BIN_IR_EVENT_CAPTURE_RAW event.
+     * @return Total bytes written, or 0 if @p bufSize cannot hold every timing
+     */
+    static size_t encodeRawCapture(const decode_results* results,
                                    uint8_t* buf, size_t bufSize);
     
 private:
+    /**
+     * @brief Base64-encode @p len bytes and write them to the capture client
+     *        as one "data: ...\n\n" SSE event in its own HTTP chunk.
+     */
+    static void sendCaptureEvent(const uint8_t* data, size_t len);
+
+    /** @brief Terminate the chunked SSE stream and release the session. */
+    static void endCapture();
+
+    /** @brief Send and pop the head of txQueue, recording its result. */
+    static void drainTxQueue();
+
+    /** Record @p state as the result of @p jobId. */
+    static void setJobState(uint16_t jobId, uint8_t state);
+
+    /** @return nullptr if @p hdr is consistent with its kind and protocol, else an error message */
+    static const char* validateCode(const BinIrCodeHeader& hdr);
+
     /**
      * @brief Send raw IR array
      * @param size Array size
-     * @param irData JSON array string
+     * @param irData Array text "[9000,4500,...]" (need not be NUL-terminated)
+     * @param len Length of @p irData
      */
-    static void sendRawArray(uint16_t size, const char* irData);
+    static void sendRawArray(uint16_t size, const char* irData, uint16_t len);
     
     /**
      * @brief Send IR value (non-AC protocols)
      * @param size Data size
      * @param protocol Protocol type
-     * @param irData Hex string
+     * @param irData Hex string (need not be NUL-terminated)
+     * @param len Length of @p irData
      * @return true if successful, false otherwise
      */
-    static bool sendIRValue(uint16_t size, decode_type_t protocol, const char* irData);
+    static bool sendIRValue(uint16_t size, decode_type_t protocol, const char* irData, uint16_t len);
     
     /**
      * @brief Send IR state (AC protocols)
      * @param size State array size
      * @param protocol Protocol type
-     * @param data State array as JSON string
+     * @param data State array text "['0x01','0xA4',...]" (need not be NUL-terminated)
+     * @param len Length of @p data
      * @return true if successful, false otherwise
      */
-    static bool sendIRState(uint16_t size, decode_type_t protocol, const char* data);
+    static bool sendIRState(uint16_t size, decode_type_t protocol, const char* data, uint16_t len);
 };
 
 #endif // IR_MANAGER_H
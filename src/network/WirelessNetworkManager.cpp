@@ -1,5 +1,6 @@
 #include "WirelessNetworkManager.h"
 #include "../utils/Utils.h"
+#include "../handlers/ResponseCache.h"
 #ifdef ARDUINO_ARCH_ESP8266
     #include <ESP8266mDNS.h>
 #elif defined(ARDUINO_ARCH_ESP32)
@@ -9,6 +10,10 @@
 WirelessConfig WirelessNetworkManager::wirelessConfig;
 bool           WirelessNetworkManager::wirelessUpdatePending = false;
 char           WirelessNetworkManager::cachedMacAddress[18]  = {};
+#ifdef ARDUINO_ARCH_ESP8266
+WiFiEventHandler WirelessNetworkManager::gotIPHandler;
+WiFiEventHandler WirelessNetworkManager::disconnectedHandler;
+#endif
 
 void WirelessNetworkManager::begin() {
     Utils::printSerial(F("## Initialize Network Manager."));
@@ -17,11 +22,25 @@ void WirelessNetworkManager::begin() {
     if (cachedMacAddress[0] == '\0') {
         WiFi.macAddress().toCharArray(cachedMacAddress, sizeof(cachedMacAddress));
     }
+
+    // Cached /ping and /api/device responses carry the IP address
+#ifdef ARDUINO_ARCH_ESP8266
+    gotIPHandler = WiFi.onStationModeGotIP(
+        [](const WiFiEventStationModeGotIP&) { ResponseCache::invalidate(); });
+    disconnectedHandler = WiFi.onStationModeDisconnected(
+        [](const WiFiEventStationModeDisconnected&) { ResponseCache::invalidate(); });
+#elif defined(ARDUINO_ARCH_ESP32)
+    WiFi.onEvent(onAddressEvent);
+#endif
 }
 
 void WirelessNetworkManager::initWireless() {
     Utils::printSerial(F("## Begin wireless network."));
     
+    // Blocking — no request is served before it returns, so the cached
+    // responses are rebuilt against the new mode and addresses.
+    ResponseCache::invalidate();
+    
     // Load wireless configuration
     if (!StorageManager::loadWirelessConfig(wirelessConfig)) {
         Utils::printSerial(F("Using default wireless configuration."));
@@ -114,6 +133,21 @@ void WirelessNetworkManager::onRangeExtenderEvent(arduino_event_id_t event, ardu
 }
 #endif
 
+#ifdef ARDUINO_ARCH_ESP32
+void WirelessNetworkManager::onAddressEvent(arduino_event_id_t event, arduino_event_info_t info) {
+    switch (event) {
+        case ARDUINO_EVENT_WIFI_STA_GOT_IP:
+        case ARDUINO_EVENT_WIFI_STA_LOST_IP:
+        case ARDUINO_EVENT_WIFI_STA_DISCONNECTED:
+        case ARDUINO_EVENT_WIFI_AP_START:
+            ResponseCache::invalidate();
+            break;
+        default:
+            break;
+    }
+}
+#endif
+
 void WirelessNetworkManager::initRangeExtender() {
     Utils::printSerial(F("## Initializing Range Extender (STA + NATed AP)."));
 
@@ -304,6 +338,7 @@ bool WirelessNetworkManager::updateWirelessConfig(const WirelessConfig& config)
     }
 
     wirelessUpdatePending = true;
+    ResponseCache::invalidate();  // /api/device reports the wireless mode
     Utils::printSerial(F("Wireless configuration updated successfully."));
     return true;
 }
@@ -34,6 +34,17 @@ private:
      * @brief WiFi event handler used by the range-extender on ESP32
      */
     static void onRangeExtenderEvent(arduino_event_id_t event, arduino_event_info_t info);
+
+    /**
+     * @brief Invalidates cached responses when an interface address changes
+     */
+    static void onAddressEvent(arduino_event_id_t event, arduino_event_info_t info);
+#endif
+
+#ifdef ARDUINO_ARCH_ESP8266
+    // Handlers must stay referenced or the core unregisters them
+    static WiFiEventHandler gotIPHandler;
+    static WiFiEventHandler disconnectedHandler;
 #endif
 
 public:
@@ -163,6 +163,7 @@ enum BinIrEventType : uint8_t {
     BIN_IR_EVENT_CAPTURE  = 1,
     BIN_IR_EVENT_TIMEOUT  = 2,
     BIN_IR_EVENT_ERROR    = 3,
+    BIN_IR_EVENT_CAPTURE_RAW = 4,  // compact raw capture (BIN_IR_CAPTURE_COMPACT)
 };
 
 // Progress event (sent during countdown)
@@ -185,8 +186,31 @@ struct BinIrCaptureEventHeader {
     uint16_t irCodeLen;      // length of irCode data that follows (bytes)
 };
 
+// Compact raw capture — sent instead of BinIrCaptureEventHeader for UNKNOWN
+// (raw) captures when the client set BIN_IR_CAPTURE_COMPACT.
+// Wire format: BinIrRawCaptureEventHeader + dataLen bytes of varints.
+// Timings stay in receiver ticks (tickUs µs each, first entry is a mark).
+// Each timing is coded against the previous timing of the same kind
+// (mark vs. mark, space vs. space; 0 before the first): the difference is
+// zigzag-mapped ((d << 1) ^ (d >> 31)) and written as an LEB128 varint,
+// 7 bits per byte, low bits first, high bit set on all but the last byte.
+struct BinIrRawCaptureEventHeader {
+    uint8_t  eventType;  // BIN_IR_EVENT_CAPTURE_RAW
+    uint8_t  tickUs;     // microseconds per tick
+    uint16_t count;      // number of timings encoded
+    uint16_t dataLen;    // varint bytes that follow
+};
+// Total: 1+1+2+2 = 6 bytes
+
+enum BinIrCaptureFlags : uint8_t {
+    BIN_IR_CAPTURE_COMPACT = 0x01,  // raw captures as BinIrRawCaptureEventHeader
+};
+
+// Clients that predate the flags byte send only captureMode; the missing
+// byte reads as 0, keeping the "[9000,4500,...]" text form.
 struct BinIrCaptureRequest {
     uint8_t captureMode;  // 0 = single, 1 = multi
+    uint8_t flags;        // BinIrCaptureFlags
 };
 
 // ── IR Send ──────────────────────────────────────────────────────────────────
@@ -203,6 +227,204 @@ struct BinIrSendResponse {
     char    response[80];  // e.g. "NEC success"
 };
 
+// ── IR code library (/api/ir/codes, /api/ir/fire, /api/ir/emit) ──────────────
+
+// How the payload after BinIrCodeHeader is laid out (all little-endian)
+enum BinIrCodeKind : uint8_t {
+    BIN_IR_CODE_VALUE  = 0,  // uint64 code value; bits = protocol bit count
+    BIN_IR_CODE_STATE  = 1,  // AC state bytes; bits = byte count
+    BIN_IR_CODE_RAW    = 2,  // uint16 mark/space µs; bits = timing count
+    BIN_IR_CODE_STORED = 3,  // /api/ir/queue only: fire library code `id`; no payload
+};
+
+// POST /api/ir/codes — store or replace a code.  Also the on-flash slot
+// header, so a stored code is fired without any re-encoding.
+// Wire format: BinIrCodeHeader + dataLen bytes of payload
+struct BinIrCodeHeader {
+    uint16_t id;        // caller-chosen code ID
+    uint8_t  kind;      // BinIrCodeKind
+    uint8_t  reserved;
+    int16_t  protocol;  // IRremoteESP8266 decode_type_t (-1 = UNKNOWN / raw)
+    uint16_t bits;      // see BinIrCodeKind
+    uint16_t dataLen;   // VALUE: 8, STATE: bits, RAW: bits × 2
+};
+// Total: 2+1+1+2+2+2 = 10 bytes
+// Response: BinSimpleResponse
+
+// POST /api/ir/emit — send a code given in binary form, without storing it.
+// Wire format: BinIrCodeHeader (id ignored) + dataLen bytes of payload; the
+// payload is handed to IRsend straight from the request buffer.
+// Response: BinIrSendResponse
+
+// POST /api/ir/fire (send a stored code), DELETE /api/ir/codes
+struct BinIrCodeIdRequest {
+    uint16_t id;
+};
+// Response to fire: BinIrSendResponse; to DELETE: BinSimpleResponse
+
+// GET /api/ir/codes
+// Wire format: BinIrCodeListHeader + count × uint16_t id
+struct BinIrCodeListHeader {
+    uint8_t status;
+    uint8_t count;
+};
+
+// ── IR transmit queue (/api/ir/queue) ───────────────────────────────────────
+
+// POST /api/ir/queue — queue a code and return before it is transmitted.
+// Wire format: BinIrCodeHeader + dataLen bytes of payload, as for
+// /api/ir/emit; kind BIN_IR_CODE_STORED (dataLen 0) fires library code `id`.
+struct BinIrQueueResponse {
+    uint8_t  status;   // BIN_STATUS_OK, or BIN_STATUS_ERROR if the queue is full
+    uint16_t jobId;    // 0 when not queued
+    uint8_t  pending;  // jobs waiting, including this one
+};
+// Total: 1+2+1 = 4 bytes
+
+enum BinIrJobState : uint8_t {
+    BIN_IR_JOB_UNKNOWN = 0,  // never issued, or its result has been recycled
+    BIN_IR_JOB_QUEUED  = 1,
+    BIN_IR_JOB_DONE    = 2,
+    BIN_IR_JOB_FAILED  = 3,
+};
+
+// GET /api/ir/queue?job=<jobId>
+struct BinIrJobStatusResponse {
+    uint8_t  status;
+    uint16_t jobId;
+    uint8_t  state;    // BinIrJobState
+    uint8_t  pending;  // jobs waiting
+};
+// Total: 1+2+1+1 = 5 bytes
+
+// ── Batch (POST /api/batch) ──────────────────────────────────────────────────
+
+// Request wire format (must fit in one HTTP_RAW_BUFLEN raw chunk, else 413):
+//   BinBatchHeader
+//   count × (BinBatchCommandHeader + payloadLen bytes of payload)
+// Payload per command type:
+//   BIN_BATCH_GPIO_SET: BinGpioSetRequest
+//   BIN_BATCH_IR_SEND:  BinIrSendHeader + irCodeLen bytes of irCode data
+//   BIN_BATCH_IR_FIRE:  BinIrCodeIdRequest
+//   BIN_BATCH_IR_EMIT:  BinIrCodeHeader + dataLen bytes of payload
+enum BinBatchCommandType : uint8_t {
+    BIN_BATCH_GPIO_SET = 0,
+    BIN_BATCH_IR_SEND  = 1,
+    BIN_BATCH_IR_FIRE  = 2,
+    BIN_BATCH_IR_EMIT  = 3,
+};
+
+struct BinBatchHeader {
+    uint8_t count;  // number of sub-commands that follow
+};
+
+struct BinBatchCommandHeader {
+    uint8_t  type;        // BinBatchCommandType
+    uint16_t delayMs;     // wait before executing this command (0 = none); the
+                          // batch is rejected if the delays add up to more
+                          // than Config::BATCH_MAX_TOTAL_DELAY_MS
+    uint16_t payloadLen;  // bytes of payload that follow
+};
+// Total: 1+2+2 = 5 bytes
+
+// Response wire format:
+//   BinBatchResponseHeader
+//   count × BinBatchResult (one per executed command, in request order)
+struct BinBatchResponseHeader {
+    uint8_t status;  // BIN_STATUS_OK if every command succeeded, else BIN_STATUS_ERROR
+    uint8_t count;   // number of BinBatchResult entries that follow
+};
+
+struct BinBatchResult {
+    uint8_t status;  // BinStatus of this command
+    int32_t value;   // GPIO: resulting pin value; IR: 0
+};
+// Total: 1+4 = 5 bytes
+
+// ── Route metrics (GET /api/metrics) ─────────────────────────────────────────
+
+// Stable route identifiers — the index of each BinRouteMetrics row.  Append
+// new routes at the end; rows for routes compiled out stay zero.
+enum BinRouteId : uint8_t {
+    BIN_ROUTE_PING          = 0,
+    BIN_ROUTE_AUTH          = 1,
+    BIN_ROUTE_DEVICE        = 2,
+    BIN_ROUTE_IR_CAPTURE    = 3,
+    BIN_ROUTE_IR_SEND       = 4,
+    BIN_ROUTE_BATCH         = 5,
+    BIN_ROUTE_WIRELESS_SET  = 6,
+    BIN_ROUTE_WIRELESS_GET  = 7,
+    BIN_ROUTE_WIRELESS_SCAN = 8,
+    BIN_ROUTE_GPIO_SET      = 9,
+    BIN_ROUTE_GPIO_GET      = 10,
+    BIN_ROUTE_RESTART       = 11,
+    BIN_ROUTE_RESET         = 12,
+    BIN_ROUTE_SLEEP         = 13,
+    BIN_ROUTE_CAMERA_ENABLE = 14,
+    BIN_ROUTE_METRICS       = 15,
+    BIN_ROUTE_KEYS          = 16,
+    BIN_ROUTE_IR_CODES      = 17,
+    BIN_ROUTE_IR_FIRE       = 18,
+    BIN_ROUTE_IR_EMIT       = 19,
+    BIN_ROUTE_IR_QUEUE      = 20,
+    BIN_ROUTE_COUNT
+};
+
+// Latency histogram: bucket 0 counts handlers faster than 256 µs, bucket i
+// counts [2^(i+7), 2^(i+8)) µs and the last bucket everything from ~1 s up.
+static const uint8_t BIN_METRICS_LATENCY_BUCKETS = 14;
+
+// Response wire format:
+//   BinMetricsResponseHeader
+//   routeCount × BinRouteMetrics (row i describes BinRouteId i)
+// All counters are cumulative since boot and wrap at 2^32.
+struct BinMetricsResponseHeader {
+    uint8_t  status;       // BIN_STATUS_OK
+    uint8_t  routeCount;   // BIN_ROUTE_COUNT
+    uint8_t  bucketCount;  // BIN_METRICS_LATENCY_BUCKETS
+    uint8_t  reserved;
+    uint32_t uptimeMs;     // millis() when the snapshot was taken
+};
+// Total: 1+1+1+1+4 = 8 bytes
+
+struct BinRouteMetrics {
+    uint8_t  routeId;      // BinRouteId
+    uint8_t  reserved[3];
+    uint32_t calls;        // requests received (including rate-limited ones)
+    uint32_t rateLimited;  // requests rejected with 429
+    uint32_t bytesIn;      // request body bytes (Content-Length)
+    uint32_t bytesOut;     // response bytes written, headers included
+    uint32_t latency[BIN_METRICS_LATENCY_BUCKETS];  // handler wall time histogram
+};
+// Total: 1+3+4+4+4+4+14×4 = 76 bytes
+
+// ── /api/keys (JWT verification keys, selected by the JWT header "kid") ───────
+
+// Slot 0 is the compiled-in key; its kid is "" and it verifies tokens that
+// carry no "kid" header.  It cannot be removed.
+static const uint8_t BIN_JWT_KEY_SLOTS = 4;
+
+// GET /api/keys (session)
+struct BinKeyListResponse {
+    uint8_t status;                      // BIN_STATUS_OK
+    uint8_t count;                       // populated entries in kids[]
+    char    kids[BIN_JWT_KEY_SLOTS][16]; // NUL-terminated, slot order
+};
+// Total: 1+1+4×16 = 66 bytes
+
+// POST /api/keys (owner JWT in Authorization: Bearer) — add or replace a key
+struct BinKeyAddRequest {
+    char    kid[16];    // 1..15 chars + NUL
+    uint8_t point[65];  // uncompressed P-256 point: 0x04 || X || Y
+};
+// Total: 16+65 = 81 bytes
+
+// DELETE /api/keys (owner JWT in Authorization: Bearer)
+struct BinKeyRemoveRequest {
+    char kid[16];
+};
+// Response to POST / DELETE: BinSimpleResponse
+
 // ── Camera ───────────────────────────────────────────────────────────────────
 
 struct BinCameraEnableRequest {
@@ -308,43 +530,4 @@ struct BinSimpleResponse {
 
 #pragma pack(pop)
 
-// ── Base64 utilities (for SSE binary events) ─────────────────────────────────
-
-namespace Base64 {
-
-static const char TABLE[] =
-    "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
-
-/**
- * @brief Encode binary data to base64 in-place into a caller-provided buffer.
- * @param src  Source binary data
- * @param len  Length of source data
- * @param dst  Destination buffer (must be at least ((len+2)/3)*4 + 1 bytes)
- * @return Length of base64 string (not including NUL terminator)
- */
-inline size_t encode(const uint8_t* src, size_t len, char* dst) {
-    size_t i = 0, j = 0;
-    for (; i + 2 < len; i += 3) {
-        dst[j++] = TABLE[(src[i] >> 2) & 0x3F];
-        dst[j++] = TABLE[((src[i] & 0x03) << 4) | ((src[i+1] >> 4) & 0x0F)];
-        dst[j++] = TABLE[((src[i+1] & 0x0F) << 2) | ((src[i+2] >> 6) & 0x03)];
-        dst[j++] = TABLE[src[i+2] & 0x3F];
-    }
-    if (i < len) {
-        dst[j++] = TABLE[(src[i] >> 2) & 0x3F];
-        if (i + 1 < len) {
-            dst[j++] = TABLE[((src[i] & 0x03) << 4) | ((src[i+1] >> 4) & 0x0F)];
-            dst[j++] = TABLE[((src[i+1] & 0x0F) << 2)];
-        } else {
-            dst[j++] = TABLE[((src[i] & 0x03) << 4)];
-            dst[j++] = '=';
-        }
-        dst[j++] = '=';
-    }
-    dst[j] = '\0';
-    return j;
-}
-
-} // namespace Base64
-
 #endif // BINARY_PROTOCOL_H
@@ -0,0 +1,94 @@
+#ifndef FILE_STREAM_H
+#define FILE_STREAM_H
+
+#include <Arduino.h>
+#include <LittleFS.h>
+#include "../config/Config.h"
+
+// ════════════════════════════════════════════════════════════════════════
+// Block-buffered File adapters
+//
+// ArduinoJson pulls and pushes one character at a time when handed a File
+// directly, which turns into one LittleFS call per byte.  These adapters
+// satisfy ArduinoJson's custom reader/writer interface and move data in
+// Config::FILE_CHUNK_BYTES blocks, so a JSON file of any size costs one
+// small buffer on the stack instead of its full length in heap.
+// ════════════════════════════════════════════════════════════════════════
+
+/** Reader: int read() / readBytes() served from a refillable block. */
+class FileChunkReader {
+public:
+    explicit FileChunkReader(File& file) : _file(file) {}
+
+    int read() {
+        if (_pos == _len && !fill()) return -1;
+        return _buf[_pos++];
+    }
+
+    size_t readBytes(char* dst, size_t len) {
+        size_t n = 0;
+        while (n < len) {
+            if (_pos == _len && !fill()) break;
+            size_t take = _len - _pos;
+            if (take > len - n) take = len - n;
+            memcpy(dst + n, _buf + _pos, take);
+            _pos += take;
+            n    += take;
+        }
+        return n;
+    }
+
+private:
+    bool fill() {
+        int got = _file.read(_buf, sizeof(_buf));
+        _len = (got > 0) ? (size_t)got : 0;
+        _pos = 0;
+        return _len > 0;
+    }
+
+    File&   _file;
+    uint8_t _buf[Config::FILE_CHUNK_BYTES];
+    size_t  _pos = 0;
+    size_t  _len = 0;
+};
+
+/** Writer: write() stages bytes and hands the File whole blocks. */
+class FileChunkWriter {
+public:
+    explicit FileChunkWriter(File& file) : _file(file) {}
+    ~FileChunkWriter() { flush(); }
+
+    size_t write(uint8_t c) {
+        if (_len == sizeof(_buf) && !flush()) return 0;
+        _buf[_len++] = c;
+        return 1;
+    }
+
+    size_t write(const uint8_t* src, size_t len) {
+        size_t n = 0;
+        while (n < len) {
+            if (_len == sizeof(_buf) && !flush()) break;
+            size_t take = sizeof(_buf) - _len;
+            if (take > len - n) take = len - n;
+            memcpy(_buf + _len, src + n, take);
+            _len += take;
+            n    += take;
+        }
+        return n;
+    }
+
+    /** Write out the staged block. @return false if any write came up short */
+    bool flush() {
+        if (_len && _file.write(_buf, _len) != _len) _failed = true;
+        _len = 0;
+        return !_failed;
+    }
+
+private:
+    File&   _file;
+    uint8_t _buf[Config::FILE_CHUNK_BYTES];
+    size_t  _len    = 0;
+    bool    _failed = false;
+};
+
+#endif // FILE_STREAM_H
@@ -0,0 +1,134 @@
+#include "IrLibrary.h"
+#include "../utils/Utils.h"
+
+// Static member initialization
+uint16_t IrLibrary::s_ids[Config::IR_LIBRARY_SLOTS] = {};
+uint32_t IrLibrary::s_used    = 0;
+bool     IrLibrary::s_indexed = false;
+
+void IrLibrary::ensureIndex() {
+    if (s_indexed) return;
+
+    s_used = 0;
+    File file = LittleFS.open(Config::IR_LIBRARY_FILE, "r");
+    if (file) {
+        const size_t size = file.size();
+        for (uint8_t i = 0; i < Config::IR_LIBRARY_SLOTS; i++) {
+            const size_t off = (size_t)i * SLOT_BYTES;
+            if (off + sizeof(BinIrCodeHeader) > size) break;
+
+            BinIrCodeHeader hdr;
+            if (!file.seek(off) ||
+                file.read(reinterpret_cast<uint8_t*>(&hdr), sizeof(hdr)) != sizeof(hdr)) break;
+            if (hdr.dataLen == 0 || hdr.dataLen > Config::IR_LIBRARY_CODE_BYTES) continue;
+
+            s_ids[i] = hdr.id;
+            s_used  |= (1UL << i);
+        }
+        file.close();
+    }
+
+    s_indexed = true;
+}
+
+int IrLibrary::findSlot(uint16_t id) {
+    const uint8_t home = id % Config::IR_LIBRARY_SLOTS;
+    for (uint8_t k = 0; k < Config::IR_LIBRARY_SLOTS; k++) {
+        const uint8_t slot = (home + k) % Config::IR_LIBRARY_SLOTS;
+        if ((s_used & (1UL << slot)) && s_ids[slot] == id) return slot;
+    }
+    return -1;
+}
+
+bool IrLibrary::writeSlot(uint8_t slot, const BinIrCodeHeader& hdr, const uint8_t* data) {
+    File file = LittleFS.open(Config::IR_LIBRARY_FILE, "r+");
+    if (!file) file = LittleFS.open(Config::IR_LIBRARY_FILE, "w");
+    if (!file) return false;
+
+    // Slots past the end of the file are zero-filled, which reads back as free
+    const size_t off = (size_t)slot * SLOT_BYTES;
+    size_t size = file.size();
+    bool ok = file.seek(size);
+    static const uint8_t zeros[64] = {};
+    while (ok && size < off) {
+        size_t n = (off - size < sizeof(zeros)) ? off - size : sizeof(zeros);
+        ok = (file.write(zeros, n) == n);
+        size += n;
+    }
+
+    ok = ok && file.seek(off) &&
+         file.write(reinterpret_cast<const uint8_t*>(&hdr), sizeof(hdr)) == sizeof(hdr) &&
+         (hdr.dataLen == 0 || file.write(data, hdr.dataLen) == hdr.dataLen);
+    file.close();
+    return ok;
+}
+
+bool IrLibrary::store(const BinIrCodeHeader& hdr, const uint8_t* data) {
+    if (hdr.dataLen == 0 || hdr.dataLen > Config::IR_LIBRARY_CODE_BYTES) return false;
+    ensureIndex();
+
+    int slot = findSlot(hdr.id);
+    if (slot < 0) {
+        const uint8_t home = hdr.id % Config::IR_LIBRARY_SLOTS;
+        for (uint8_t k = 0; k < Config::IR_LIBRARY_SLOTS && slot < 0; k++) {
+            const uint8_t s = (home + k) % Config::IR_LIBRARY_SLOTS;
+            if (!(s_used & (1UL << s))) slot = s;
+        }
+        if (slot < 0) {
+            Utils::printSerial(F("IR library full."));
+            return false;
+        }
+    }
+
+    if (!writeSlot(slot, hdr, data)) {
+        Utils::printSerial(F("IR library write failed."));
+        return false;
+    }
+
+    s_ids[slot] = hdr.id;
+    s_used     |= (1UL << slot);
+    return true;
+}
+
+bool IrLibrary::load(uint16_t id, BinIrCodeHeader& hdr, uint8_t* data, size_t cap) {
+    ensureIndex();
+    const int slot = findSlot(id);
+    if (slot < 0) return false;
+
+    File file = LittleFS.open(Config::IR_LIBRARY_FILE, "r");
+    if (!file) return false;
+
+    bool ok = file.seek((size_t)slot * SLOT_BYTES) &&
+              file.read(reinterpret_cast<uint8_t*>(&hdr), sizeof(hdr)) == sizeof(hdr) &&
+              hdr.id == id && hdr.dataLen > 0 && hdr.dataLen <= cap &&
+              file.read(data, hdr.dataLen) == hdr.dataLen;
+    file.close();
+    return ok;
+}
+
+bool IrLibrary::remove(uint16_t id) {
+    ensureIndex();
+    const int slot = findSlot(id);
+    if (slot < 0) return false;
+
+    BinIrCodeHeader empty;
+    memset(&empty, 0, sizeof(empty));
+    if (!writeSlot(slot, empty, nullptr)) return false;
+
+    s_used &= ~(1UL << slot);
+    return true;
+}
+
+uint8_t IrLibrary::list(uint16_t* ids, uint8_t max) {
+    ensureIndex();
+    uint8_t n = 0;
+    for (uint8_t i = 0; i < Config::IR_LIBRARY_SLOTS && n < max; i++) {
+        if (s_used & (1UL << i)) ids[n++] = s_ids[i];
+    }
+    return n;
+}
+
+void IrLibrary::invalidate() {
+    s_used    = 0;
+    s_indexed = false;
+}
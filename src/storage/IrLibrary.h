@@ -0,0 +1,73 @@
+#ifndef IR_LIBRARY_H
+#define IR_LIBRARY_H
+
+#include <Arduino.h>
+#include <LittleFS.h>
+#include "../config/Config.h"
+#include "../protocol/BinaryProtocol.h"
+
+// ════════════════════════════════════════════════════════════════════════
+// Stored IR code library
+//
+// Config::IR_LIBRARY_FILE holds IR_LIBRARY_SLOTS fixed-size slots, each a
+// BinIrCodeHeader followed by IR_LIBRARY_CODE_BYTES of payload space, so a
+// slot's offset is a multiplication and a store rewrites only that slot.
+// A slot whose header has dataLen 0 is free (including never-written
+// space).  The slot headers are read once, on first use, into a RAM index
+// of IDs; an ID's home slot is id % IR_LIBRARY_SLOTS, with linear probing
+// past collisions.  Payloads are stored exactly as they go to IRsend.
+// ════════════════════════════════════════════════════════════════════════
+
+class IrLibrary {
+public:
+    /**
+     * @brief Store a code, replacing any code with the same ID
+     * @param hdr  Code header (hdr.dataLen bytes follow in @p data)
+     * @param data Payload, at most Config::IR_LIBRARY_CODE_BYTES
+     * @return false if the payload is too large, the library is full or
+     *         the flash write failed
+     */
+    static bool store(const BinIrCodeHeader& hdr, const uint8_t* data);
+
+    /**
+     * @brief Read a stored code
+     * @param id   Code ID
+     * @param hdr  Output header
+     * @param data Output payload buffer
+     * @param cap  Capacity of @p data
+     * @return false if the ID is unknown or the slot does not read back
+     */
+    static bool load(uint16_t id, BinIrCodeHeader& hdr, uint8_t* data, size_t cap);
+
+    /** @return false if the ID is unknown or the slot could not be cleared */
+    static bool remove(uint16_t id);
+
+    /**
+     * @brief Copy the stored IDs in slot order
+     * @return Number of IDs written to @p ids (at most @p max)
+     */
+    static uint8_t list(uint16_t* ids, uint8_t max);
+
+    /** @brief Forget the RAM index (the file was wiped by a format). */
+    static void invalidate();
+
+private:
+    static constexpr size_t SLOT_BYTES = sizeof(BinIrCodeHeader) + Config::IR_LIBRARY_CODE_BYTES;
+
+    /** Build the ID index from the slot headers if not done yet. */
+    static void ensureIndex();
+
+    /** @return Slot holding @p id, or -1 */
+    static int findSlot(uint16_t id);
+
+    /** Write @p hdr and its payload to @p slot, zero-filling any gap before it. */
+    static bool writeSlot(uint8_t slot, const BinIrCodeHeader& hdr, const uint8_t* data);
+
+    static uint16_t s_ids[Config::IR_LIBRARY_SLOTS];   // ID per slot
+    static uint32_t s_used;                            // bit i: slot i holds a code
+    static bool     s_indexed;
+
+    static_assert(Config::IR_LIBRARY_SLOTS <= 32, "s_used is a 32-bit slot mask");
+};
+
+#endif // IR_LIBRARY_H
@@ -0,0 +1,299 @@
+#include "RecordStore.h"
+#include "../utils/Utils.h"
+
+// Static member initialization
+RecordStore::IndexEntry RecordStore::s_index[RecordStore::TYPE_COUNT] = {};
+uint32_t RecordStore::s_logSize     = 0;   // bytes of valid log (next append offset)
+uint32_t RecordStore::s_liveSize    = 0;   // header + payload bytes of indexed records
+uint32_t RecordStore::s_lastWriteMs = 0;
+bool     RecordStore::s_ready       = false;
+bool     RecordStore::s_booting     = true;
+uint8_t* RecordStore::s_cache[RecordStore::TYPE_COUNT] = {};
+
+namespace {
+
+constexpr size_t CHUNK = 64;
+
+/** Continue @p crc over the next @p len bytes of @p file; false on short read. */
+bool crcFromFile(File& file, size_t len, uint32_t& crc) {
+    uint8_t chunk[CHUNK];
+    while (len > 0) {
+        size_t n = len < CHUNK ? len : CHUNK;
+        if (file.read(chunk, n) != n) return false;
+        crc = Utils::crc32(chunk, n, crc);
+        len -= n;
+    }
+    return true;
+}
+
+/** Copy @p len bytes from the current position of @p src to @p dst. */
+bool copyBytes(File& src, File& dst, size_t len) {
+    uint8_t chunk[CHUNK];
+    while (len > 0) {
+        size_t n = len < CHUNK ? len : CHUNK;
+        if (src.read(chunk, n) != n || dst.write(chunk, n) != n) return false;
+        len -= n;
+    }
+    return true;
+}
+
+} // namespace
+
+uint32_t RecordStore::headerCrc(const RecordHeader& hdr) {
+    // type and len are adjacent — one call covers both
+    return Utils::crc32(&hdr.type, sizeof(hdr.type) + sizeof(hdr.len));
+}
+
+bool RecordStore::begin() {
+    // A tmp log next to a real one is an unfinished compaction — the old log
+    // is still complete.  A tmp log alone means the crash came between remove
+    // and rename, so the tmp log is the complete one.
+    if (LittleFS.exists(Config::RECORD_STORE_TMP_FILE)) {
+        if (LittleFS.exists(Config::RECORD_STORE_FILE)) {
+            LittleFS.remove(Config::RECORD_STORE_TMP_FILE);
+        } else {
+            LittleFS.rename(Config::RECORD_STORE_TMP_FILE, Config::RECORD_STORE_FILE);
+        }
+    }
+
+    s_ready = true;
+    if (!scan()) {
+        Utils::printSerial(F("Config log has a torn tail — compacting."));
+        s_ready = compact();
+    }
+
+    Utils::printSerial(F("Config records: "), "");
+    Utils::printSerial((unsigned long)s_liveSize, "");
+    Utils::printSerial(F(" live / "), "");
+    Utils::printSerial((unsigned long)s_logSize, "");
+    Utils::printSerial(F(" bytes."));
+    return s_ready;
+}
+
+bool RecordStore::scan() {
+    for (uint8_t t = 0; t < TYPE_COUNT; t++) cacheTake(t, nullptr);
+    memset(s_index, 0, sizeof(s_index));
+    s_logSize  = 0;
+    s_liveSize = 0;
+
+    File file = LittleFS.open(Config::RECORD_STORE_FILE, "r");
+    if (!file) return true;  // no log yet — empty store
+
+    const uint32_t size = file.size();
+    uint32_t off = 0;
+
+    while (off + sizeof(RecordHeader) <= size) {
+        RecordHeader hdr;
+        if (file.read(reinterpret_cast<uint8_t*>(&hdr), sizeof(hdr)) != sizeof(hdr)) break;
+        if (hdr.magic != RECORD_MAGIC || hdr.type == 0 || hdr.type >= TYPE_COUNT ||
+            hdr.len > Config::RECORD_MAX_BYTES) break;
+
+        const uint32_t payloadOff = off + sizeof(RecordHeader);
+        if (payloadOff + hdr.len > size) break;
+
+        uint32_t crc = headerCrc(hdr);
+        if (s_booting && hdr.len) {
+            // Read the payload once into RAM and check the CRC there
+            uint8_t* buf = static_cast<uint8_t*>(malloc(hdr.len));
+            bool ok = buf && file.read(buf, hdr.len) == hdr.len &&
+                      Utils::crc32(buf, hdr.len, crc) == hdr.crc;
+            if (!ok) {
+                free(buf);
+                break;
+            }
+            cacheTake(hdr.type, buf);
+        } else {
+            if (!crcFromFile(file, hdr.len, crc) || crc != hdr.crc) break;
+            if (!hdr.len) cacheTake(hdr.type, nullptr);
+        }
+
+        IndexEntry& e = s_index[hdr.type];
+        if (e.offset) s_liveSize -= sizeof(RecordHeader) + e.len;
+        if (hdr.len) {
+            e = { payloadOff, hdr.len };
+            s_liveSize += sizeof(RecordHeader) + hdr.len;
+        } else {
+            e = {};
+        }
+        off = payloadOff + hdr.len;
+    }
+
+    s_logSize = off;
+    file.close();
+    return off == size;
+}
+
+bool RecordStore::compact() {
+    File dst = LittleFS.open(Config::RECORD_STORE_TMP_FILE, "w");
+    if (!dst) return false;
+
+    File src = LittleFS.open(Config::RECORD_STORE_FILE, "r");
+    IndexEntry next[TYPE_COUNT] = {};
+    uint32_t   outOff = 0;
+    bool       ok = true;
+
+    // Records were CRC-checked at scan or written by us, so header and
+    // payload are copied verbatim.
+    for (uint8_t t = 1; t < TYPE_COUNT && ok; t++) {
+        const IndexEntry& e = s_index[t];
+        if (!e.offset) continue;
+        ok = src && src.seek(e.offset - sizeof(RecordHeader)) &&
+             copyBytes(src, dst, sizeof(RecordHeader) + e.len);
+        next[t] = { outOff + (uint32_t)sizeof(RecordHeader), e.len };
+        outOff += sizeof(RecordHeader) + e.len;
+    }
+
+    if (src) src.close();
+    dst.close();
+
+    if (!ok) {
+        LittleFS.remove(Config::RECORD_STORE_TMP_FILE);
+        Utils::printSerial(F("Config log compaction failed."));
+        return false;
+    }
+
+    LittleFS.remove(Config::RECORD_STORE_FILE);
+    if (!LittleFS.rename(Config::RECORD_STORE_TMP_FILE, Config::RECORD_STORE_FILE)) {
+        Utils::printSerial(F("Config log rename failed."));
+        return false;
+    }
+
+    memcpy(s_index, next, sizeof(s_index));
+    s_logSize  = outOff;
+    s_liveSize = outOff;
+    return true;
+}
+
+bool RecordStore::sameAsStored(uint8_t t, const void* src, size_t len) {
+    const IndexEntry& entry = s_index[t];
+    if (!entry.offset || entry.len != len) return false;
+    if (s_cache[t]) return memcmp(s_cache[t], src, len) == 0;
+
+    File file = LittleFS.open(Config::RECORD_STORE_FILE, "r");
+    if (!file || !file.seek(entry.offset)) return false;
+
+    const uint8_t* p = static_cast<const uint8_t*>(src);
+    uint8_t chunk[CHUNK];
+    bool same = true;
+    while (len > 0 && same) {
+        size_t n = len < CHUNK ? len : CHUNK;
+        same = (file.read(chunk, n) == n) && memcmp(chunk, p, n) == 0;
+        p   += n;
+        len -= n;
+    }
+    file.close();
+    return same;
+}
+
+bool RecordStore::append(RecordType type, const void* src, uint16_t len) {
+    File file = LittleFS.open(Config::RECORD_STORE_FILE, "a");
+    if (!file) return false;
+
+    // A failed append leaves a partial record past s_logSize; rewrite from
+    // the index first so this one does not land behind garbage the mount
+    // scan would stop at.
+    if (file.size() != s_logSize) {
+        file.close();
+        if (!compact()) return false;
+        file = LittleFS.open(Config::RECORD_STORE_FILE, "a");
+        if (!file) return false;
+    }
+
+    RecordHeader hdr = { RECORD_MAGIC, static_cast<uint8_t>(type), len, 0 };
+    hdr.crc = Utils::crc32(src, len, headerCrc(hdr));
+
+    bool ok = (file.write(reinterpret_cast<const uint8_t*>(&hdr), sizeof(hdr)) == sizeof(hdr)) &&
+              (len == 0 || file.write(static_cast<const uint8_t*>(src), len) == len);
+    file.close();
+
+    if (!ok) return false;
+
+    IndexEntry& e = s_index[static_cast<uint8_t>(type)];
+    if (e.offset) s_liveSize -= sizeof(RecordHeader) + e.len;
+    if (len) {
+        e = { s_logSize + (uint32_t)sizeof(RecordHeader), len };
+        s_liveSize += sizeof(RecordHeader) + len;
+    } else {
+        e = {};
+    }
+    if (s_booting) cachePut(static_cast<uint8_t>(type), src, len);
+    s_logSize  += sizeof(RecordHeader) + len;
+    s_lastWriteMs = millis();
+    return true;
+}
+
+bool RecordStore::read(RecordType type, void* dst, size_t len) {
+    const uint8_t t = static_cast<uint8_t>(type);
+    if (!s_ready || t == 0 || t >= TYPE_COUNT) return false;
+
+    const IndexEntry& e = s_index[t];
+    if (!e.offset || e.len != len) return false;
+
+    if (s_cache[t]) {
+        memcpy(dst, s_cache[t], len);
+        return true;
+    }
+
+    File file = LittleFS.open(Config::RECORD_STORE_FILE, "r");
+    if (!file) return false;
+    bool ok = file.seek(e.offset) && file.read(static_cast<uint8_t*>(dst), len) == len;
+    file.close();
+    return ok;
+}
+
+bool RecordStore::write(RecordType type, const void* src, size_t len) {
+    const uint8_t t = static_cast<uint8_t>(type);
+    if (!s_ready || t == 0 || t >= TYPE_COUNT || len == 0 || len > Config::RECORD_MAX_BYTES) return false;
+
+    if (sameAsStored(t, src, len)) return true;
+    return append(type, src, (uint16_t)len);
+}
+
+bool RecordStore::erase(RecordType type) {
+    const uint8_t t = static_cast<uint8_t>(type);
+    if (!s_ready || t == 0 || t >= TYPE_COUNT) return false;
+
+    if (!s_index[t].offset) return true;
+    return append(type, nullptr, 0);
+}
+
+bool RecordStore::exists(RecordType type) {
+    const uint8_t t = static_cast<uint8_t>(type);
+    return s_ready && t != 0 && t < TYPE_COUNT && s_index[t].offset != 0;
+}
+
+void RecordStore::cacheTake(uint8_t t, uint8_t* buf) {
+    free(s_cache[t]);
+    s_cache[t] = buf;
+}
+
+void RecordStore::cachePut(uint8_t t, const void* src, uint16_t len) {
+    uint8_t* buf = nullptr;
+    if (len) {
+        buf = static_cast<uint8_t*>(malloc(len));
+        if (buf) memcpy(buf, src, len);  // on OOM the read just goes to flash
+    }
+    cacheTake(t, buf);
+}
+
+void RecordStore::endBoot() {
+    for (uint8_t t = 0; t < TYPE_COUNT; t++) cacheTake(t, nullptr);
+    s_booting = false;
+}
+
+void RecordStore::tick() {
+    if (!s_ready || s_logSize - s_liveSize < Config::RECORD_COMPACT_BYTES) return;
+    if (millis() - s_lastWriteMs < Config::RECORD_COMPACT_IDLE_MS) return;
+
+    const uint32_t before = s_logSize;
+    if (compact()) {
+        Utils::printSerial(F("Config log compacted: "), "");
+        Utils::printSerial((unsigned long)before, "");
+        Utils::printSerial(F(" -> "), "");
+        Utils::printSerial((unsigned long)s_logSize, "");
+        Utils::printSerial(F(" bytes."));
+    } else {
+        // Try again after another quiet period rather than every loop pass
+        s_lastWriteMs = millis();
+    }
+}
@@ -0,0 +1,120 @@
+#ifndef RECORD_STORE_H
+#define RECORD_STORE_H
+
+#include <Arduino.h>
+#include <LittleFS.h>
+#include "../config/Config.h"
+
+// ════════════════════════════════════════════════════════════════════════
+// Log-structured config record store
+//
+// All small binary settings live as typed records in one append-only file
+// (Config::RECORD_STORE_FILE).  Each record is an 8-byte header followed by
+// its payload; the newest record of a type wins and a zero-length record
+// erases it.  Mount scans the log once and keeps {offset, len} per type in
+// RAM, so a read is one seek + read and a write is one append — no file
+// delete/create and no directory update per save.  Writes identical to the
+// stored payload touch no flash at all.
+//
+// Once superseded records add up to Config::RECORD_COMPACT_BYTES, tick()
+// rewrites the live records into RECORD_STORE_TMP_FILE and renames it over
+// the log.  A torn tail (power loss mid-append) fails its CRC and ends the
+// scan; mount then compacts at once so the next append lands cleanly.
+//
+// Boot: until endBoot(), the mount scan keeps a RAM copy of every live
+// payload it reads for the CRC check, so the managers' begin() calls are
+// served without reopening the log — all persisted config comes from that
+// single pass.  endBoot() frees the copies once setup() is done.
+// ════════════════════════════════════════════════════════════════════════
+
+enum class RecordType : uint8_t {
+    WIRELESS_CONFIG = 1,
+    BOUND_TOKEN     = 2,
+    BOUND_TOKEN_TAG = 3,
+    DEVICE_SECRET   = 4,
+    JWT_KEYS        = 5,
+    GPIO_CONFIG     = 6,
+    SLEEP_ENABLED   = 7,
+    COUNT
+};
+
+class RecordStore {
+public:
+    /**
+     * @brief Open the log, finish an interrupted compaction and build the index.
+     *        LittleFS must already be mounted.
+     * @return true if the store is usable
+     */
+    static bool begin();
+
+    /**
+     * @brief Copy a record's payload into @p dst.
+     * @return true only if the record exists and is exactly @p len bytes
+     */
+    static bool read(RecordType type, void* dst, size_t len);
+
+    /**
+     * @brief Append a new version of a record (no-op if the payload is unchanged).
+     * @return true if the record is stored
+     */
+    static bool write(RecordType type, const void* src, size_t len);
+
+    /** @brief Append a tombstone for @p type. */
+    static bool erase(RecordType type);
+
+    /** @return true if a live record of @p type exists */
+    static bool exists(RecordType type);
+
+    /** @brief Compact the log once it is over threshold and the loop is quiet. */
+    static void tick();
+
+    /** @brief Drop the boot-time payload copies; later reads go to flash. */
+    static void endBoot();
+
+private:
+    struct RecordHeader {
+        uint8_t  magic;   // RECORD_MAGIC
+        uint8_t  type;    // RecordType
+        uint16_t len;     // payload bytes, 0 = tombstone
+        uint32_t crc;     // CRC-32 over type, len and payload
+    };
+    static_assert(sizeof(RecordHeader) == 8, "record header must stay 8 bytes on flash");
+
+    struct IndexEntry {
+        uint32_t offset;  // payload offset in the log, 0 = no record
+        uint16_t len;
+    };
+
+    static constexpr uint8_t RECORD_MAGIC = 0xA5;
+    static constexpr uint8_t TYPE_COUNT   = static_cast<uint8_t>(RecordType::COUNT);
+
+    static IndexEntry s_index[TYPE_COUNT];
+    static uint32_t   s_logSize;
+    static uint32_t   s_liveSize;
+    static uint32_t   s_lastWriteMs;
+    static bool       s_ready;
+    static bool       s_booting;              // keep payload copies in s_cache
+    static uint8_t*   s_cache[TYPE_COUNT];    // boot-time payload copies (heap)
+
+    /** Replace the cached payload of @p t with @p buf (takes ownership). */
+    static void cacheTake(uint8_t t, uint8_t* buf);
+
+    /** Cache a copy of @p len bytes from @p src for @p t (len 0 drops it). */
+    static void cachePut(uint8_t t, const void* src, uint16_t len);
+
+    /** Rebuild the index from the log; @return false if a torn tail was found. */
+    static bool scan();
+
+    /** Rewrite live records into a fresh log. */
+    static bool compact();
+
+    /** Append a record (len 0 = tombstone) and update the index. */
+    static bool append(RecordType type, const void* src, uint16_t len);
+
+    /** Compare the stored payload of type @p t with @p src. */
+    static bool sameAsStored(uint8_t t, const void* src, size_t len);
+
+    static uint32_t headerCrc(const RecordHeader& hdr);
+};
+
+#endif // RECORD_STORE_H
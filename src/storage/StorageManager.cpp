@@ -1,8 +1,34 @@
 #include "StorageManager.h"
+#include "RecordStore.h"
+#include "FileStream.h"
+#include "IrLibrary.h"
 #include "../utils/Utils.h"
 
-bool StorageManager::begin() {
-    Utils::printSerial(F("## Begin flash storage."));
+static_assert(sizeof(WirelessConfig)  <= Config::RECORD_MAX_BYTES, "WirelessConfig exceeds a record");
+static_assert(sizeof(BoundTokenData)  <= Config::RECORD_MAX_BYTES, "BoundTokenData exceeds a record");
+static_assert(sizeof(JwtKeyStoreData) <= Config::RECORD_MAX_BYTES, "JwtKeyStoreData exceeds a record");
+static_assert(sizeof(GPIOConfigData)  <= Config::RECORD_MAX_BYTES, "GPIOConfigData exceeds a record");
+
+namespace {
+
+// Settings that used to live in one file each; folded into the record log
+// on the first boot after an upgrade.
+struct LegacyFile {
+    RecordType  type;
+    const char* path;
+};
+
+const LegacyFile kLegacyFiles[] = {
+    { RecordType::WIRELESS_CONFIG, Config::WIFI_CONFIG_FILE   },
+    { RecordType::BOUND_TOKEN,     Config::BOUND_TOKEN_FILE   },
+    { RecordType::BOUND_TOKEN_TAG, Config::BOUND_TAG_FILE     },
+    { RecordType::DEVICE_SECRET,   Config::DEVICE_SECRET_FILE },
+    { RecordType::JWT_KEYS,        Config::JWT_KEYS_FILE      },
+    { RecordType::GPIO_CONFIG,     Config::GPIO_CONFIG_FILE   },
+    { RecordType::SLEEP_ENABLED,   Config::SLEEP_CONFIG_FILE  },
+};
+
+bool mountFileSystem() {
 #if defined(ARDUINO_ARCH_ESP8266)
     if (LittleFS.begin()) {
         return true;
@@ -18,6 +44,53 @@ bool StorageManager::begin() {
 #endif
 }
 
+} // namespace
+
+bool StorageManager::begin() {
+    Utils::printSerial(F("## Begin flash storage."));
+    if (!mountFileSystem() || !RecordStore::begin()) {
+        return false;
+    }
+    migrateLegacyFiles();
+    return true;
+}
+
+void StorageManager::tick() {
+    RecordStore::tick();
+}
+
+void StorageManager::endBoot() {
+    RecordStore::endBoot();
+}
+
+void StorageManager::migrateLegacyFiles() {
+    for (const LegacyFile& legacy : kLegacyFiles) {
+        if (!LittleFS.exists(legacy.path)) continue;
+
+        // A record already in the log is newer than any leftover file
+        if (!RecordStore::exists(legacy.type)) {
+            File file = LittleFS.open(legacy.path, "r");
+            if (file) {
+                // Heap, not a static: this runs on the first boot after an upgrade only
+                size_t   len  = file.size();
+                bool     fits = len > 0 && len <= Config::RECORD_MAX_BYTES;
+                uint8_t* buf  = fits ? static_cast<uint8_t*>(malloc(len)) : nullptr;
+                bool     oom  = fits && !buf;
+                bool     read = buf && file.read(buf, len) == len;
+                file.close();
+                bool written = read && RecordStore::write(legacy.type, buf, len);
+                free(buf);
+                if (oom || (read && !written)) continue;  // keep the file, retry next boot
+                if (written) {
+                    Utils::printSerial(F("Migrated to config log: "), "");
+                    Utils::printSerial(legacy.path);
+                }
+            }
+        }
+        LittleFS.remove(legacy.path);
+    }
+}
+
 bool StorageManager::readJson(const char* filePath, JsonDocument& doc) {
     Utils::printSerial(F("Reading File: "), "");
     Utils::printSerial(filePath, "...  ");
@@ -31,7 +104,8 @@ bool StorageManager::readJson(const char* filePath, JsonDocument& doc) {
     Utils::printSerial(F(" Done."));
     Utils::printSerial(F("Parsing File...  "), "");
     
-    DeserializationError error = deserializeJson(doc, file);
+    FileChunkReader reader(file);
+    DeserializationError error = deserializeJson(doc, reader);
     file.close();
     
     if (error) {
@@ -56,7 +130,8 @@ bool StorageManager::writeJson(const char* filePath, const JsonDocument& doc) {
         return false;
     }
     
-    if (serializeJson(doc, file) == 0) {
+    FileChunkWriter writer(file);
+    if (serializeJson(doc, writer) == 0 || !writer.flush()) {
         Utils::printSerial(F(" Failed!"));
         file.close();
         return false;
@@ -67,17 +142,6 @@ bool StorageManager::writeJson(const char* filePath, const JsonDocument& doc) {
     return true;
 }
 
-String StorageManager::readFile(const char* filePath) {
-    File file = LittleFS.open(filePath, "r");
-    if (!file) {
-        return String("");
-    }
-    
-    String content = file.readString();
-    file.close();
-    return content;
-}
-
 bool StorageManager::writeFile(const char* filePath, const char* content) {
     File file = LittleFS.open(filePath, "w");
     if (!file) {
@@ -108,10 +172,15 @@ bool StorageManager::format() {
     }
     
     Utils::printSerial(F("Factory reset successful."));
+
+    // The wiped filesystem has no log or IR library — drop the stale indexes
+    IrLibrary::invalidate();
+    if (!RecordStore::begin()) {
+        return false;
+    }
     
-    // Create empty GPIO config file (binary)
-    Utils::printSerial(F("Creating File: "), "");
-    Utils::printSerial(Config::GPIO_CONFIG_FILE, "...  ");
+    // Create empty GPIO config record
+    Utils::printSerial(F("Creating GPIO config record...  "), "");
     GPIOConfigData emptyGPIO;
     if (!saveGPIOConfig(emptyGPIO)) {
         Utils::printSerial(F("Failed!"));
@@ -123,21 +192,11 @@ bool StorageManager::format() {
 }
 
 bool StorageManager::loadWirelessConfig(WirelessConfig& config) {
-    File file = LittleFS.open(Config::WIFI_CONFIG_FILE, "r");
-    if (!file) {
-        Utils::printSerial(F("No wireless config file — using defaults."));
+    if (!RecordStore::read(RecordType::WIRELESS_CONFIG, &config, sizeof(WirelessConfig))) {
+        Utils::printSerial(F("No wireless config record — using defaults."));
         return false;
     }
 
-    if (file.size() != sizeof(WirelessConfig)) {
-        Utils::printSerial(F("Wireless config size mismatch — using defaults."));
-        file.close();
-        return false;
-    }
-
-    bool ok = (file.read(reinterpret_cast<uint8_t*>(&config), sizeof(WirelessConfig)) == sizeof(WirelessConfig));
-    file.close();
-
     // Ensure null-termination in case of corrupt data
     config.mode[sizeof(config.mode) - 1]               = '\0';
     config.stationSSID[sizeof(config.stationSSID) - 1] = '\0';
@@ -145,168 +204,119 @@ bool StorageManager::loadWirelessConfig(WirelessConfig& config) {
     config.apSSID[sizeof(config.apSSID) - 1]           = '\0';
     config.apPSK[sizeof(config.apPSK) - 1]             = '\0';
 
-    if (ok) {
-        Utils::printSerial(F("Wireless config loaded."));
-    } else {
-        Utils::printSerial(F("Wireless config read failed — using defaults."));
-    }
-    return ok;
+    Utils::printSerial(F("Wireless config loaded."));
+    return true;
 }
 
 bool StorageManager::saveWirelessConfig(const WirelessConfig& config) {
-    deleteFile(Config::WIFI_CONFIG_FILE);
-
-    File file = LittleFS.open(Config::WIFI_CONFIG_FILE, "w");
-    if (!file) {
-        Utils::printSerial(F("Failed to open wireless config for write."));
-        return false;
-    }
-
-    bool ok = (file.write(reinterpret_cast<const uint8_t*>(&config), sizeof(WirelessConfig)) == sizeof(WirelessConfig));
-    file.close();
-
-    if (ok) {
-        Utils::printSerial(F("Wireless config saved."));
-    } else {
-        Utils::printSerial(F("Wireless config write failed."));
-    }
+    bool ok = RecordStore::write(RecordType::WIRELESS_CONFIG, &config, sizeof(WirelessConfig));
+    Utils::printSerial(ok ? F("Wireless config saved.") : F("Wireless config write failed."));
     return ok;
 }
 
 bool StorageManager::loadBoundToken(BoundTokenData& data) {
-    File file = LittleFS.open(Config::BOUND_TOKEN_FILE, "r");
-    if (!file) {
-        Utils::printSerial(F("\nNo bound token file found."));
+    if (!RecordStore::read(RecordType::BOUND_TOKEN, &data, sizeof(BoundTokenData))) {
+        Utils::printSerial(F("\nNo bound token record found."));
         return false;
     }
 
-    if (file.size() != sizeof(BoundTokenData)) {
-        Utils::printSerial(F("\nBound token size mismatch — ignoring."));
-        file.close();
-        return false;
-    }
-
-    bool ok = (file.read(reinterpret_cast<uint8_t*>(&data), sizeof(BoundTokenData)) == sizeof(BoundTokenData));
-    file.close();
-
     // Ensure null-termination in case of corrupt data
     data.sub[sizeof(data.sub) - 1] = '\0';
     data.jwt[sizeof(data.jwt) - 1] = '\0';
 
-    if (ok) {
-        Utils::printSerial(F("\nBound token loaded."));
-    } else {
-        Utils::printSerial(F("\nBound token read failed."));
-    }
-    return ok;
+    Utils::printSerial(F("\nBound token loaded."));
+    return true;
 }
 
 bool StorageManager::saveBoundToken(const BoundTokenData& data) {
-    deleteFile(Config::BOUND_TOKEN_FILE);
+    bool ok = RecordStore::write(RecordType::BOUND_TOKEN, &data, sizeof(BoundTokenData));
+    Utils::printSerial(ok ? F("\nBound token saved.") : F("\nBound token write failed."));
+    return ok;
+}
 
-    File file = LittleFS.open(Config::BOUND_TOKEN_FILE, "w");
-    if (!file) {
-        Utils::printSerial(F("\nFailed to open bound token for write."));
-        return false;
-    }
+bool StorageManager::loadBoundTokenTag(uint8_t* tag) {
+    return RecordStore::read(RecordType::BOUND_TOKEN_TAG, tag, 32);
+}
 
-    bool ok = (file.write(reinterpret_cast<const uint8_t*>(&data), sizeof(BoundTokenData)) == sizeof(BoundTokenData));
-    file.close();
+bool StorageManager::saveBoundTokenTag(const uint8_t* tag) {
+    bool ok = RecordStore::write(RecordType::BOUND_TOKEN_TAG, tag, 32);
+    if (!ok) Utils::printSerial(F("\nBound token tag write failed."));
+    return ok;
+}
 
-    if (ok) {
-        Utils::printSerial(F("\nBound token saved."));
-    } else {
-        Utils::printSerial(F("\nBound token write failed."));
-    }
+bool StorageManager::hasDeviceSecret() {
+    return RecordStore::exists(RecordType::DEVICE_SECRET);
+}
+
+bool StorageManager::loadDeviceSecret(uint8_t* secret) {
+    return RecordStore::read(RecordType::DEVICE_SECRET, secret, Config::DEVICE_SECRET_BYTES);
+}
+
+bool StorageManager::saveDeviceSecret(const uint8_t* secret) {
+    bool ok = RecordStore::write(RecordType::DEVICE_SECRET, secret, Config::DEVICE_SECRET_BYTES);
+    if (!ok) Utils::printSerial(F("Device secret write failed."));
     return ok;
 }
 
-bool StorageManager::loadGPIOConfig(GPIOConfigData& data) {
-    File file = LittleFS.open(Config::GPIO_CONFIG_FILE, "r");
-    if (!file) {
-        Utils::printSerial(F("No GPIO config file — using defaults."));
+bool StorageManager::loadJwtKeys(JwtKeyStoreData& data) {
+    if (!RecordStore::read(RecordType::JWT_KEYS, &data, sizeof(JwtKeyStoreData))) {
+        data.count = 0;
         return false;
     }
 
-    if (file.size() != sizeof(GPIOConfigData)) {
-        Utils::printSerial(F("GPIO config size mismatch — using defaults."));
-        file.close();
-        return false;
+    // Clamp count and terminate kids in case of corrupt data
+    if (data.count > Config::JWT_KEY_SLOTS - 1) data.count = 0;
+    for (uint8_t i = 0; i < data.count; i++) {
+        data.keys[i].kid[sizeof(data.keys[i].kid) - 1] = '\0';
     }
+    Utils::printSerial(F("JWT keys loaded: "), (long)data.count);
+    return true;
+}
 
-    bool ok = (file.read(reinterpret_cast<uint8_t*>(&data), sizeof(GPIOConfigData)) == sizeof(GPIOConfigData));
-    file.close();
+bool StorageManager::saveJwtKeys(const JwtKeyStoreData& data) {
+    // An empty table is a tombstone, so the next compaction drops the record
+    bool ok = data.count ? RecordStore::write(RecordType::JWT_KEYS, &data, sizeof(JwtKeyStoreData))
+                         : RecordStore::erase(RecordType::JWT_KEYS);
+    Utils::printSerial(ok ? F("JWT keys saved.") : F("JWT keys write failed."));
+    return ok;
+}
+
+bool StorageManager::loadGPIOConfig(GPIOConfigData& data) {
+    if (!RecordStore::read(RecordType::GPIO_CONFIG, &data, sizeof(GPIOConfigData))) {
+        Utils::printSerial(F("No GPIO config record — using defaults."));
+        return false;
+    }
 
     // Clamp count to valid range
     if (data.count > MAX_GPIO_PINS) {
         data.count = 0;
     }
 
-    if (ok) {
-        Utils::printSerial(F("GPIO config loaded."));
-    } else {
-        Utils::printSerial(F("GPIO config read failed — using defaults."));
-    }
-    return ok;
+    Utils::printSerial(F("GPIO config loaded."));
+    return true;
 }
 
 bool StorageManager::saveGPIOConfig(const GPIOConfigData& data) {
-    deleteFile(Config::GPIO_CONFIG_FILE);
-
-    File file = LittleFS.open(Config::GPIO_CONFIG_FILE, "w");
-    if (!file) {
-        Utils::printSerial(F("Failed to open GPIO config for write."));
-        return false;
-    }
-
-    bool ok = (file.write(reinterpret_cast<const uint8_t*>(&data), sizeof(GPIOConfigData)) == sizeof(GPIOConfigData));
-    file.close();
-
-    if (ok) {
-        Utils::printSerial(F("GPIO config saved."));
-    } else {
-        Utils::printSerial(F("GPIO config write failed."));
-    }
+    bool ok = RecordStore::write(RecordType::GPIO_CONFIG, &data, sizeof(GPIOConfigData));
+    Utils::printSerial(ok ? F("GPIO config saved.") : F("GPIO config write failed."));
     return ok;
 }
 
 bool StorageManager::loadSleepEnabled(bool& enabled) {
-    File file = LittleFS.open(Config::SLEEP_CONFIG_FILE, "r");
-    if (!file) {
-        Utils::printSerial(F("No sleep config file — defaulting to disabled."));
+    uint8_t val = 0;
+    if (!RecordStore::read(RecordType::SLEEP_ENABLED, &val, 1)) {
+        Utils::printSerial(F("No sleep config record — defaulting to disabled."));
         return false;
     }
 
-    uint8_t val = 0;
-    bool ok = (file.read(&val, 1) == 1);
-    file.close();
-
-    if (ok) {
-        enabled = (val != 0);
-        Utils::printSerial(F("Sleep config loaded."));
-    } else {
-        Utils::printSerial(F("Sleep config read failed."));
-    }
-    return ok;
+    enabled = (val != 0);
+    Utils::printSerial(F("Sleep config loaded."));
+    return true;
 }
 
 bool StorageManager::saveSleepEnabled(bool enabled) {
-    deleteFile(Config::SLEEP_CONFIG_FILE);
-
-    File file = LittleFS.open(Config::SLEEP_CONFIG_FILE, "w");
-    if (!file) {
-        Utils::printSerial(F("Failed to open sleep config for write."));
-        return false;
-    }
-
     uint8_t val = enabled ? 1 : 0;
-    bool ok = (file.write(&val, 1) == 1);
-    file.close();
-
-    if (ok) {
-        Utils::printSerial(F("Sleep config saved."));
-    } else {
-        Utils::printSerial(F("Sleep config write failed."));
-    }
+    bool ok = RecordStore::write(RecordType::SLEEP_ENABLED, &val, 1);
+    Utils::printSerial(ok ? F("Sleep config saved.") : F("Sleep config write failed."));
     return ok;
 }
@@ -9,13 +9,25 @@
 class StorageManager {
 public:
     /**
-     * @brief Initialize LittleFS file system
+     * @brief Mount LittleFS, open the config record log and migrate any
+     *        legacy per-setting files into it
      * @return true if successful, false otherwise
      */
     static bool begin();
+
+    /**
+     * @brief Run deferred storage work (config log compaction). Call from loop().
+     */
+    static void tick();
+
+    /**
+     * @brief Release the config copies kept in RAM for boot. Call at the end
+     *        of setup(), after every manager has loaded its settings.
+     */
+    static void endBoot();
     
     /**
-     * @brief Read JSON document from file
+     * @brief Read JSON document from file (parsed in Config::FILE_CHUNK_BYTES blocks)
      * @param filePath Path to the file
      * @param doc JsonDocument to store the result
      * @return true if successful, false otherwise
@@ -23,20 +35,13 @@ public:
     static bool readJson(const char* filePath, JsonDocument& doc);
     
     /**
-     * @brief Write JSON document to file
+     * @brief Write JSON document to file (serialized through a block buffer)
      * @param filePath Path to the file
      * @param doc JsonDocument to write
      * @return true if successful, false otherwise
      */
     static bool writeJson(const char* filePath, const JsonDocument& doc);
     
-    /**
-     * @brief Read entire file as string
-     * @param filePath Path to the file
-     * @return File contents as String, empty String if failed
-     */
-    static String readFile(const char* filePath);
-
     /**
      * @brief Write a C-string to a file (creates or overwrites)
      * @param filePath Path to the file
@@ -66,42 +71,86 @@ public:
     static bool format();
     
     /**
-     * @brief Load wireless configuration from file
+     * @brief Load wireless configuration from the config log
      * @param config WirelessConfig struct to populate
      * @return true if successful, false otherwise
      */
     static bool loadWirelessConfig(WirelessConfig& config);
     
     /**
-     * @brief Save wireless configuration to file
+     * @brief Save wireless configuration to the config log
      * @param config WirelessConfig struct to save
      * @return true if successful, false otherwise
      */
     static bool saveWirelessConfig(const WirelessConfig& config);
 
     /**
-     * @brief Load bound token data from binary file
+     * @brief Load bound token data from the config log
      * @param data BoundTokenData struct to populate
      * @return true if successful, false otherwise
      */
     static bool loadBoundToken(BoundTokenData& data);
 
     /**
-     * @brief Save bound token data to binary file
+     * @brief Save bound token data to the config log
      * @param data BoundTokenData struct to save
      * @return true if successful, false otherwise
      */
     static bool saveBoundToken(const BoundTokenData& data);
 
     /**
-     * @brief Load GPIO configuration from binary file
+     * @brief Load the integrity tag stored alongside the bound token
+     * @param tag Output buffer of Hmac::SHA256_LEN (32) bytes
+     * @return true if a tag of the right size was read
+     */
+    static bool loadBoundTokenTag(uint8_t* tag);
+
+    /**
+     * @brief Save the bound-token integrity tag (32 bytes)
+     * @return true if successful, false otherwise
+     */
+    static bool saveBoundTokenTag(const uint8_t* tag);
+
+    /** @return true if a per-device secret is persisted */
+    static bool hasDeviceSecret();
+
+    /**
+     * @brief Load the persisted per-device secret
+     * @param secret Output buffer of Config::DEVICE_SECRET_BYTES
+     * @return true if a secret of the right size was read
+     */
+    static bool loadDeviceSecret(uint8_t* secret);
+
+    /**
+     * @brief Save the per-device secret (Config::DEVICE_SECRET_BYTES)
+     * @return true if successful, false otherwise
+     */
+    static bool saveDeviceSecret(const uint8_t* secret);
+
+    /**
+     * @brief Load runtime-added JWT verification keys
+     * @param data JwtKeyStoreData struct to populate
+     * @return true if successful, false otherwise
+     */
+    static bool loadJwtKeys(JwtKeyStoreData& data);
+
+    /**
+     * @brief Save runtime-added JWT verification keys (an empty table
+     *        erases the record)
+     * @param data JwtKeyStoreData struct to save
+     * @return true if successful, false otherwise
+     */
+    static bool saveJwtKeys(const JwtKeyStoreData& data);
+
+    /**
+     * @brief Load GPIO configuration from the config log
      * @param data GPIOConfigData struct to populate
      * @return true if successful, false otherwise
      */
     static bool loadGPIOConfig(GPIOConfigData& data);
 
     /**
-     * @brief Save GPIO configuration to binary file
+     * @brief Save GPIO configuration to the config log
      * @param data GPIOConfigData struct to save
      * @return true if successful, false otherwise
      */
@@ -110,7 +159,7 @@ public:
     /**
      * @brief Load sleep mode enabled flag from flash.
      * @param enabled  Output: true if sleep mode was previously enabled.
-     * @return true if a persisted value was found, false if no file exists.
+     * @return true if a persisted value was found, false if no record exists.
      */
     static bool loadSleepEnabled(bool& enabled);
 
@@ -120,6 +169,10 @@ public:
      * @return true if successful, false otherwise.
      */
     static bool saveSleepEnabled(bool enabled);
+
+private:
+    /** Fold one-file-per-setting leftovers into the record log, then delete them. */
+    static void migrateLegacyFiles();
 };
 
 #endif // STORAGE_MANAGER_H
@@ -0,0 +1,183 @@
+#include "Base64.h"
+
+namespace {
+
+constexpr char kStdChars[] =
+    "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+
+// Decode table markers — OR-ed into one accumulator per call
+constexpr uint8_t DEC_SPACE   = 0x40;  // whitespace (lenient decode skips it)
+constexpr uint8_t DEC_INVALID = 0x80;  // not part of the alphabet
+
+// Encode: every 12-bit group → its two output characters (first char in the
+// low byte), so a 3-byte block takes two lookups instead of four.  8 KB flash.
+struct PairTable { uint16_t v[4096]; };
+
+constexpr PairTable makePairTable() {
+    PairTable t{};
+    for (int i = 0; i < 4096; i++) {
+        t.v[i] = (uint16_t)((uint8_t)kStdChars[i >> 6] | ((uint8_t)kStdChars[i & 63] << 8));
+    }
+    return t;
+}
+
+struct DecodeTable { uint8_t v[256]; };
+
+constexpr DecodeTable makeDecodeTable(bool url, bool lenient) {
+    DecodeTable t{};
+    for (int c = 0; c < 256; c++) {
+        uint8_t d = DEC_INVALID;
+        if (c >= 'A' && c <= 'Z')      d = c - 'A';
+        else if (c >= 'a' && c <= 'z') d = c - 'a' + 26;
+        else if (c >= '0' && c <= '9') d = c - '0' + 52;
+        else if (c == '-' && (url || lenient))  d = 62;
+        else if (c == '_' && (url || lenient))  d = 63;
+        else if (c == '+' && (!url || lenient)) d = 62;
+        else if (c == '/' && (!url || lenient)) d = 63;
+        else if (lenient && (c == ' ' || c == '\t' || c == '\n' || c == '\r')) d = DEC_SPACE;
+        t.v[c] = d;
+    }
+    return t;
+}
+
+const PairTable   kPairs   PROGMEM = makePairTable();
+const DecodeTable kDecAny  PROGMEM = makeDecodeTable(false, true);   // both alphabets + whitespace
+const DecodeTable kDecUrl  PROGMEM = makeDecodeTable(true,  false);  // Base64URL only
+
+inline uint8_t dec(const DecodeTable& t, char c) {
+    return pgm_read_byte(&t.v[(uint8_t)c]);
+}
+
+/** Exact decoded length of @p len data characters, or SIZE_MAX if len % 4 == 1. */
+inline size_t decodedLength(size_t len) {
+    size_t rem = len % 4;
+    if (rem == 1) return SIZE_MAX;
+    return (len / 4) * 3 + (rem ? rem - 1 : 0);
+}
+
+/**
+ * Decode @p len characters in 4-char groups without per-character checks.
+ * Every table entry is OR-ed into the return value; the caller rejects or
+ * falls back if any marker bit is set.  With @p canonical, non-zero unused
+ * trailing bits also set DEC_INVALID.  @p out must hold decodedLength(len).
+ */
+uint8_t decodeGroups(const char* in, size_t len, uint8_t* out,
+                     const DecodeTable& table, bool canonical) {
+    uint8_t acc = 0;
+    size_t  i = 0, n = 0;
+
+    for (; i + 4 <= len; i += 4) {
+        uint8_t a = dec(table, in[i]),     b = dec(table, in[i + 1]);
+        uint8_t c = dec(table, in[i + 2]), d = dec(table, in[i + 3]);
+        acc |= a | b | c | d;
+        uint32_t w = ((uint32_t)a << 18) | ((uint32_t)b << 12) | ((uint32_t)c << 6) | d;
+        out[n]     = (uint8_t)(w >> 16);
+        out[n + 1] = (uint8_t)(w >> 8);
+        out[n + 2] = (uint8_t)w;
+        n += 3;
+    }
+
+    size_t rem = len - i;
+    if (rem >= 2) {
+        uint8_t a = dec(table, in[i]), b = dec(table, in[i + 1]);
+        acc |= a | b;
+        out[n] = (uint8_t)((a << 2) | ((b >> 4) & 0x03));
+        if (rem == 2) {
+            if (canonical && (b & 0x0F)) acc |= DEC_INVALID;
+        } else {
+            uint8_t c = dec(table, in[i + 2]);
+            acc |= c;
+            out[n + 1] = (uint8_t)((b << 4) | ((c >> 2) & 0x0F));
+            if (canonical && (c & 0x03)) acc |= DEC_INVALID;
+        }
+    }
+    return acc;
+}
+
+/** Character-at-a-time lenient decode — only for input containing whitespace. */
+size_t decodeSkippingSpace(const char* in, size_t len, uint8_t* out, size_t outCap) {
+    uint32_t v = 0;
+    int      bits = -8;
+    size_t   n = 0, chars = 0;
+    for (size_t i = 0; i < len; i++) {
+        uint8_t d = dec(kDecAny, in[i]);
+        if (d == DEC_SPACE) continue;
+        if (d & DEC_INVALID) return 0;
+        v = (v << 6) | d;
+        bits += 6;
+        chars++;
+        if (bits >= 0) {
+            if (n >= outCap) return 0;
+            out[n++] = (uint8_t)(v >> bits);
+            bits -= 8;
+        }
+    }
+    return (chars % 4 == 1) ? 0 : n;
+}
+
+} // namespace
+
+namespace Base64 {
+
+size_t encode(const uint8_t* src, size_t len, char* dst, Alphabet alphabet) {
+    size_t i = 0, j = 0;
+    for (; i + 3 <= len; i += 3) {
+        uint32_t w  = ((uint32_t)src[i] << 16) | ((uint32_t)src[i + 1] << 8) | src[i + 2];
+        uint16_t hi = pgm_read_word(&kPairs.v[w >> 12]);
+        uint16_t lo = pgm_read_word(&kPairs.v[w & 0xFFF]);
+        dst[j]     = (char)(hi & 0xFF);
+        dst[j + 1] = (char)(hi >> 8);
+        dst[j + 2] = (char)(lo & 0xFF);
+        dst[j + 3] = (char)(lo >> 8);
+        j += 4;
+    }
+
+    size_t rem = len - i;
+    if (rem) {
+        uint32_t w  = ((uint32_t)src[i] << 16) | (rem == 2 ? ((uint32_t)src[i + 1] << 8) : 0);
+        uint16_t hi = pgm_read_word(&kPairs.v[w >> 12]);
+        dst[j++] = (char)(hi & 0xFF);
+        dst[j++] = (char)(hi >> 8);
+        if (rem == 2) dst[j++] = (char)(pgm_read_word(&kPairs.v[((w >> 6) & 0x3F) << 6]) & 0xFF);
+        if (alphabet == Alphabet::Standard) {
+            if (rem == 1) dst[j++] = '=';
+            dst[j++] = '=';
+        }
+    }
+
+    if (alphabet == Alphabet::Url) {
+        for (size_t k = 0; k < j; k++) {
+            if (dst[k] == '+')      dst[k] = '-';
+            else if (dst[k] == '/') dst[k] = '_';
+        }
+    }
+
+    dst[j] = '\0';
+    return j;
+}
+
+size_t decode(const char* in, size_t inLen, uint8_t* out, size_t outCap) {
+    // Trailing padding and whitespace carry no data
+    while (inLen > 0 && (in[inLen - 1] == '=' || dec(kDecAny, in[inLen - 1]) == DEC_SPACE)) {
+        inLen--;
+    }
+
+    size_t outLen = decodedLength(inLen);
+    if (outLen == 0) return 0;
+    if (outLen > outCap) return decodeSkippingSpace(in, inLen, out, outCap);
+
+    uint8_t flags = decodeGroups(in, inLen, out, kDecAny, false);
+    if (flags & DEC_INVALID) return 0;
+    if (flags & DEC_SPACE)   return decodeSkippingSpace(in, inLen, out, outCap);
+    return outLen;
+}
+
+size_t decodeUrlStrict(const char* in, size_t inLen, uint8_t* out, size_t outCap) {
+    size_t outLen = decodedLength(inLen);
+    if (outLen == 0 || outLen > outCap) return 0;
+
+    uint8_t flags = decodeGroups(in, inLen, out, kDecUrl, true);
+    return (flags & DEC_INVALID) ? 0 : outLen;
+}
+
+} // namespace Base64
@@ -0,0 +1,60 @@
+#ifndef BASE64_H
+#define BASE64_H
+
+#include <Arduino.h>
+
+// ════════════════════════════════════════════════════════════════════════
+// Base64 / Base64URL codec
+//
+// Single implementation shared by the JWT verifier (decode) and the IR
+// capture SSE stream (encode).  Both directions work on whole 3-byte / 4-char
+// groups: encode emits two characters per 12-bit lookup, decode ORs every
+// table entry into one accumulator so validity is checked once at the end
+// instead of per character.  Tables live in flash.
+// ════════════════════════════════════════════════════════════════════════
+
+namespace Base64 {
+
+    enum class Alphabet : uint8_t {
+        Standard,  // A-Z a-z 0-9 + /  with '=' padding
+        Url,       // A-Z a-z 0-9 - _  without padding (RFC 4648 §5, JWT)
+    };
+
+    /** @return Encoded length of @p len bytes, excluding the NUL terminator. */
+    constexpr size_t encodedLength(size_t len, Alphabet alphabet = Alphabet::Standard) {
+        return (alphabet == Alphabet::Standard) ? ((len + 2) / 3) * 4
+                                                : (len / 3) * 4 + ((len % 3) ? (len % 3) + 1 : 0);
+    }
+
+    /**
+     * @brief Encode binary data into a caller-provided buffer.
+     * @param src       Source binary data
+     * @param len       Length of source data
+     * @param dst       Destination buffer (at least encodedLength(len) + 1 bytes)
+     * @param alphabet  Standard (padded) or Url (unpadded)
+     * @return Length of the encoded string (not including the NUL terminator)
+     */
+    size_t encode(const uint8_t* src, size_t len, char* dst,
+                  Alphabet alphabet = Alphabet::Standard);
+
+    /**
+     * @brief Lenient decode: accepts either alphabet, optional trailing '='
+     *        padding and ASCII whitespace anywhere (PEM bodies, JWT segments).
+     * @param in      Encoded characters (need not be NUL-terminated)
+     * @param inLen   Number of characters
+     * @param out     Destination buffer
+     * @param outCap  Capacity of @p out
+     * @return Decoded length, or 0 if the input is invalid or does not fit
+     */
+    size_t decode(const char* in, size_t inLen, uint8_t* out, size_t outCap);
+
+    /**
+     * @brief Strict Base64URL decode: URL alphabet only, no padding, no
+     *        whitespace, and unused trailing bits must be zero, so every
+     *        byte string has exactly one accepted encoding (JWT signatures).
+     * @return Decoded length, or 0 if the input is invalid or does not fit
+     */
+    size_t decodeUrlStrict(const char* in, size_t inLen, uint8_t* out, size_t outCap);
+}
+
+#endif // BASE64_H
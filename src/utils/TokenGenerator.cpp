@@ -0,0 +1,73 @@
+#include "TokenGenerator.h"
+
+#if defined(ARDUINO_ARCH_ESP32)
+    #include <esp_random.h>
+#endif
+
+namespace {
+
+constexpr char kHexDigits[] = "0123456789ABCDEF";
+
+// Every byte value → its two hex characters (first char in the low byte)
+struct HexTable { uint16_t v[256]; };
+
+constexpr HexTable makeHexTable() {
+    HexTable t{};
+    for (int i = 0; i < 256; i++) {
+        t.v[i] = (uint16_t)((uint8_t)kHexDigits[i >> 4] | ((uint8_t)kHexDigits[i & 0x0F] << 8));
+    }
+    return t;
+}
+
+const HexTable kHex PROGMEM = makeHexTable();
+
+const char kAlphanumeric[] PROGMEM =
+    "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789";
+constexpr uint8_t kAlphanumericLen = sizeof(kAlphanumeric) - 1;  // 62
+// Largest multiple of 62 that fits in a byte — bytes at or above are redrawn
+constexpr uint8_t kAlphanumericLimit = (256 / kAlphanumericLen) * kAlphanumericLen;  // 248
+
+} // namespace
+
+namespace TokenGenerator {
+
+void fillRandom(uint8_t* buf, size_t len) {
+#if defined(ARDUINO_ARCH_ESP8266)
+    ESP.random(buf, len);
+#elif defined(ARDUINO_ARCH_ESP32)
+    esp_fill_random(buf, len);
+#else
+    static uint32_t state = 0x9E3779B9u;
+    for (size_t i = 0; i < len; i++) {
+        state ^= state << 13;
+        state ^= state >> 17;
+        state ^= state << 5;
+        buf[i] = (uint8_t)state;
+    }
+#endif
+}
+
+void fillAlphanumeric(char* out, size_t len) {
+    uint8_t pool[16];
+    size_t  avail = 0, n = 0;
+    while (n < len) {
+        if (avail == 0) {
+            fillRandom(pool, sizeof(pool));
+            avail = sizeof(pool);
+        }
+        uint8_t b = pool[--avail];
+        if (b >= kAlphanumericLimit) continue;
+        out[n++] = (char)pgm_read_byte(&kAlphanumeric[b % kAlphanumericLen]);
+    }
+}
+
+void toHex(const uint8_t* data, size_t len, char* out) {
+    for (size_t i = 0; i < len; i++) {
+        uint16_t pair = pgm_read_word(&kHex.v[data[i]]);
+        out[2 * i]     = (char)(pair & 0xFF);
+        out[2 * i + 1] = (char)(pair >> 8);
+    }
+    out[2 * len] = '\0';
+}
+
+} // namespace TokenGenerator
@@ -0,0 +1,35 @@
+#ifndef TOKEN_GENERATOR_H
+#define TOKEN_GENERATOR_H
+
+#include <Arduino.h>
+
+// ════════════════════════════════════════════════════════════════════════
+// Random token generation
+//
+// Session tokens, challenge nonces and device secrets all come from here.
+// Bytes are drawn in bulk from the hardware RNG (os_random / esp_fill_random)
+// rather than one random() call per byte, and hex output goes through a
+// byte → two-character table in flash.
+// ════════════════════════════════════════════════════════════════════════
+
+namespace TokenGenerator {
+
+    /**
+     * @brief Fill @p buf with @p len bytes from the hardware RNG.
+     *        Off-target builds use a fixed-seed xorshift so results repeat.
+     */
+    void fillRandom(uint8_t* buf, size_t len);
+
+    /**
+     * @brief Write @p len random characters from [A-Za-z0-9] to @p out
+     *        (no NUL).  Rejection sampling keeps the distribution uniform.
+     */
+    void fillAlphanumeric(char* out, size_t len);
+
+    /**
+     * @brief Encode @p len bytes as uppercase hex into @p out (2×len chars + NUL).
+     */
+    void toHex(const uint8_t* data, size_t len, char* out);
+}
+
+#endif // TOKEN_GENERATOR_H
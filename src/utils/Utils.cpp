@@ -14,17 +14,17 @@ namespace Utils {
         printSerial(F("."));
     }
     
-    uint64_t getUInt64FromHex(const char* hex) {
+    uint64_t getUInt64FromHex(const char* hex, size_t len) {
         uint64_t result = 0;
-        uint16_t offset = 0;
+        size_t   offset = 0;
         
         // Skip 0x or 0X prefix if present
-        if (hex[0] == '0' && (hex[1] == 'x' || hex[1] == 'X')) {
+        if (len >= 2 && hex[0] == '0' && (hex[1] == 'x' || hex[1] == 'X')) {
             offset = 2;
         }
         
         // Convert hex string to uint64
-        while (isxdigit((unsigned char)hex[offset])) {
+        while (offset < len && isxdigit((unsigned char)hex[offset])) {
             char c = hex[offset];
             result <<= 4; // Faster than multiply by 16
             
@@ -39,6 +39,40 @@ namespace Utils {
         return result;
     }
     
+    bool hexToBytes(const char* hex, uint8_t* out, size_t outLen) {
+        for (size_t i = 0; i < outLen; i++) {
+            uint8_t hi = hexNibble(hex[2 * i]);
+            uint8_t lo = hexNibble(hex[2 * i + 1]);
+            if ((hi | lo) & 0xF0) return false;
+            out[i] = (uint8_t)((hi << 4) | lo);
+        }
+        return true;
+    }
+
+    bool constantTimeEquals(const uint8_t* a, const uint8_t* b, size_t len) {
+        uint8_t diff = 0;
+        for (size_t i = 0; i < len; i++) diff |= a[i] ^ b[i];
+        return diff == 0;
+    }
+    
+    uint32_t crc32(const void* data, size_t len, uint32_t seed) {
+        // Nibble-wise table: 64 bytes of flash instead of 1 KB
+        static const uint32_t kTable[16] = {
+            0x00000000, 0x1DB71064, 0x3B6E20C8, 0x26D930AC,
+            0x76DC4190, 0x6B6B51F4, 0x4DB26158, 0x5005713C,
+            0xEDB88320, 0xF00F9344, 0xD6D6A3E8, 0xCB61B38C,
+            0x9B64C2B0, 0x86D3D2D4, 0xA00AE278, 0xBDBDF21C,
+        };
+        const uint8_t* p = static_cast<const uint8_t*>(data);
+        uint32_t crc = ~seed;
+        for (size_t i = 0; i < len; i++) {
+            crc ^= p[i];
+            crc = (crc >> 4) ^ kTable[crc & 0x0F];
+            crc = (crc >> 4) ^ kTable[crc & 0x0F];
+        }
+        return ~crc;
+    }
+    
     uint64_t getDeviceID() {
         #if defined(ARDUINO_ARCH_ESP8266)
             // ESP8266 chip ID is a 32-bit value derived from the MAC address
@@ -29,9 +29,41 @@ namespace Utils {
     /**
      * @brief Convert hex string to uint64_t
      * @param hex Hex string to convert (with or without 0x prefix)
+     * @param len Characters available at @p hex (parsing also stops at the
+     *            first non-hex character, so NUL-terminated input needs none)
      * @return Converted uint64_t value
      */
-    uint64_t getUInt64FromHex(const char* hex);
+    uint64_t getUInt64FromHex(const char* hex, size_t len = SIZE_MAX);
+    
+    /**
+     * @brief Value of one ASCII hex digit (either case)
+     * @return 0..15, or 0xFF if @p c is not a hex digit
+     */
+    inline uint8_t hexNibble(char c) {
+        if (c >= '0' && c <= '9') return (uint8_t)(c - '0');
+        c |= 0x20;  // fold to lowercase
+        if (c >= 'a' && c <= 'f') return (uint8_t)(c - 'a' + 10);
+        return 0xFF;
+    }
+
+    /**
+     * @brief Decode exactly @p outLen bytes from 2×@p outLen hex characters
+     *        (either case).  No prefix, no separators.
+     * @return false if any character is not a hex digit
+     */
+    bool hexToBytes(const char* hex, uint8_t* out, size_t outLen);
+
+    /**
+     * @brief Compare two buffers in time independent of where they differ.
+     *        Use for secrets (session tokens, MACs) instead of memcmp/strcmp.
+     */
+    bool constantTimeEquals(const uint8_t* a, const uint8_t* b, size_t len);
+    
+    /**
+     * @brief CRC-32 (IEEE 802.3, reflected) of @p len bytes.
+     * @param seed Previous result to continue a running CRC, 0 to start
+     */
+    uint32_t crc32(const void* data, size_t len, uint32_t seed = 0);
     
     /**
      * @brief Initialize LED pin
@@ -0,0 +1,175 @@
+#ifndef HOST_HARNESS_H
+#define HOST_HARNESS_H
+
+// Helpers shared by the host harnesses: drive the real sketch through the
+// loopback WebServer, build binary request bodies and sign owner JWTs with
+// the host test keys.
+
+#include <Arduino.h>
+#include <ESP8266WebServer.h>
+#include <bearssl/bearssl_ec.h>
+#include <bearssl/bearssl_hash.h>
+#include "HostShim.h"
+
+#include "src/platform/Platform.h"
+#include "src/config/Config.h"
+#include "src/protocol/BinaryProtocol.h"
+#include "src/utils/Base64.h"
+
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+
+extern WebServerType httpServer;
+void setup();
+void loop();
+
+#define CHECK(cond) do { \
+    if (!(cond)) { \
+        fprintf(stderr, "%s:%d: CHECK failed: %s\n", __FILE__, __LINE__, #cond); \
+        exit(1); \
+    } \
+} while (0)
+
+namespace HostHarness {
+
+struct Reply {
+    int         code = 0;
+    std::string body;
+    uint64_t    handlerNs = 0;  // dispatch through one loop() pass
+    uint64_t    ttlbNs    = 0;  // dispatch until the last response byte was written
+    std::shared_ptr<HostConnection> conn;
+};
+
+const uint32_t CLIENT_IP = 0x0A01A8C0;  // 192.168.1.10
+
+template<typename T>
+std::string bytes(const T& value) {
+    return std::string(reinterpret_cast<const char*>(&value), sizeof(value));
+}
+
+template<typename T>
+T bodyAs(const Reply& r) {
+    T value;
+    memset(&value, 0, sizeof(value));
+    memcpy(&value, r.body.data(), std::min(sizeof(value), r.body.size()));
+    return value;
+}
+
+inline void parseReply(const std::string& wire, Reply& r) {
+    r.code = 0;
+    if (wire.compare(0, 9, "HTTP/1.1 ") == 0) r.code = atoi(wire.c_str() + 9);
+    size_t split = wire.find("\r\n\r\n");
+    r.body = (split == std::string::npos) ? std::string() : wire.substr(split + 4);
+}
+
+inline Reply request(HTTPMethod method, const std::string& uri, const std::string& body = std::string(),
+                     const std::string& auth = std::string(), uint32_t ip = CLIENT_IP) {
+    HostRequest req;
+    req.method   = method;
+    req.uri      = uri;
+    req.body     = body;
+    req.remoteIp = ip;
+    if (!auth.empty()) req.headers.push_back({ "Authorization", auth });
+
+    Reply r;
+    r.conn = httpServer.enqueue(req);
+    uint64_t start = HostShim::hostNanos();
+    loop();
+    r.handlerNs = HostShim::hostNanos() - start;
+    r.ttlbNs    = r.conn->lastByteNs > start ? r.conn->lastByteNs - start : 0;
+    parseReply(r.conn->out, r);
+    return r;
+}
+
+inline std::string base64Url(const std::string& raw) {
+    std::string out(Base64::encodedLength(raw.size()) + 1, '\0');
+    size_t n = Base64::encode(reinterpret_cast<const uint8_t*>(raw.data()), raw.size(), &out[0],
+                              Base64::Alphabet::Url);
+    out.resize(n);
+    return out;
+}
+
+/** A P-256 signing key of the host build. */
+struct HostKey {
+    uint8_t d[32];  // private scalar
+    uint8_t q[65];  // public point, uncompressed
+};
+
+inline HostKey hostKeyFromHex(const char* hex) {
+    HostKey k;
+    for (int i = 0; i < 32; i++) k.d[i] = (uint8_t)strtoul(std::string(hex + 2 * i, 2).c_str(), nullptr, 16);
+    host_ec_public(k.d, k.q);
+    return k;
+}
+
+/** Private half of the compiled-in key (host_jwt_key.h). */
+inline const HostKey& builtinKey() {
+    static const HostKey k = hostKeyFromHex("452e4311155ae90ce97ab496f52a827ca55154b8694dc18cc98ae1334da31804");
+    return k;
+}
+
+/** Two more keys for /api/keys and "kid" selection. */
+inline const HostKey& otherKey(int i) {
+    static const HostKey k[2] = {
+        hostKeyFromHex("ef026bb8af53edaa4eb6a0fa696beb29341061cbd8bf797db1c222903852b915"),
+        hostKeyFromHex("fa7bfe3e85fb1f84663fe9141d1f15729fc6d6f8be001e5965a044fe45ad1230"),
+    };
+    return k[i];
+}
+
+/** Q of the compiled-in key: the last 65 bytes of the SubjectPublicKeyInfo. */
+inline void builtinPoint(uint8_t q[65]) {
+    const char* begin = strchr(Config::JWT_PUB_KEY, '\n') + 1;
+    const char* end   = strstr(begin, "-----END");
+    uint8_t der[128];
+    size_t len = Base64::decode(begin, end - begin, der, sizeof(der));
+    CHECK(len >= 65);
+    memcpy(q, der + len - 65, 65);
+}
+
+/** Fetch a fresh login challenge for @p ip from /ping. */
+inline std::string challenge(uint32_t ip = CLIENT_IP) {
+    Reply r = request(HTTP_GET, "/ping", std::string(), std::string(), ip);
+    CHECK(r.code == 200);
+    BinPingResponse ping = bodyAs<BinPingResponse>(r);
+    return std::string(ping.challenge, strnlen(ping.challenge, sizeof(ping.challenge)));
+}
+
+/** ES256 token for @p sub over @p nonce, signed with @p key. */
+inline std::string makeJwt(const char* sub, const std::string& nonce, const HostKey& key,
+                           const char* kid = nullptr) {
+    std::string header = kid ? std::string("{\"alg\":\"ES256\",\"typ\":\"JWT\",\"kid\":\"") + kid + "\"}"
+                             : std::string("{\"alg\":\"ES256\",\"typ\":\"JWT\"}");
+    std::string payload = std::string("{\"sub\":\"") + sub + "\",\"family\":\"host\",\"challenge\":\"" +
+                          nonce + "\"}";
+    std::string signingInput = base64Url(header) + "." + base64Url(payload);
+
+    br_sha256_context ctx;
+    uint8_t hash[32];
+    br_sha256_init(&ctx);
+    br_sha256_update(&ctx, signingInput.data(), signingInput.size());
+    br_sha256_out(&ctx, hash);
+
+    uint8_t sig[64];
+    host_ecdsa_sign(key.d, hash, sig);
+    return signingInput + "." + base64Url(std::string(reinterpret_cast<char*>(sig), sizeof(sig)));
+}
+
+/** Log in as @p sub and return "Session <token>" for the Authorization header. */
+inline std::string login(const char* sub, uint32_t ip = CLIENT_IP) {
+    BinAuthRequest req;
+    memset(&req, 0, sizeof(req));
+    std::string jwt = makeJwt(sub, challenge(ip), builtinKey());
+    CHECK(jwt.size() < sizeof(req.token));
+    memcpy(req.token, jwt.data(), jwt.size());
+
+    Reply r = request(HTTP_POST, "/api/auth", bytes(req), std::string(), ip);
+    CHECK(r.code == 200);
+    BinAuthResponse resp = bodyAs<BinAuthResponse>(r);
+    return std::string("Session ") + resp.sessionToken;
+}
+
+} // namespace HostHarness
+
+#endif // HOST_HARNESS_H
@@ -0,0 +1,87 @@
+// ES256 login path: time /api/auth for an accepted and a rejected token and
+// record the heap it peaks at, with real P-256 signatures.  Built twice:
+// `auth_bench` verifies with the per-key comb table, `auth_bench_no_key_table`
+// with the generic BearSSL m15 path (FEATURE_JWT_KEY_TABLE_ENABLED=0).  The
+// host m15 follows BearSSL's algorithms over the firmware's field code (see
+// shim/bearssl/bearssl_ec.h), so the ratio carries over, not the microseconds.
+//
+//   auth_bench [logins]
+
+#include "HostHarness.h"
+#include "src/auth/P256.h"
+
+#include <algorithm>
+#include <vector>
+
+using namespace HostHarness;
+
+namespace {
+
+void refill() {
+    HostShim::advanceMicros(Config::RATE_LIMIT_BUCKET_CAPACITY * 1000000ULL / Config::RATE_LIMIT_REFILL_PER_SEC);
+}
+
+struct Sample {
+    int      code;
+    uint64_t ns;
+    size_t   heapPeak;
+};
+
+Sample authOnce(bool validSignature) {
+    refill();
+    std::string jwt = makeJwt("bench-owner", challenge(), builtinKey());
+    if (!validSignature) jwt[jwt.size() - 2] = jwt[jwt.size() - 2] == 'A' ? 'B' : 'A';
+
+    BinAuthRequest req;
+    memset(&req, 0, sizeof(req));
+    CHECK(jwt.size() < sizeof(req.token));
+    memcpy(req.token, jwt.data(), jwt.size());
+
+    size_t before = HostShim::heapInUse();
+    HostShim::resetHeapHighWater();
+    Reply r = request(HTTP_POST, "/api/auth", bytes(req));
+    return { r.code, r.handlerNs, HostShim::heapHighWater() - before };
+}
+
+void bench(const char* label, bool validSignature, uint32_t logins) {
+    std::vector<uint64_t> ns;
+    size_t peak = 0;
+    for (uint32_t i = 0; i < logins; i++) {
+        Sample s = authOnce(validSignature);
+        CHECK(s.code == (validSignature ? 200 : 401));
+        ns.push_back(s.ns);
+        peak = std::max(peak, s.heapPeak);
+    }
+    std::sort(ns.begin(), ns.end());
+    printf("%-8s p50 %8.1f us  max %8.1f us  heap peak %zu B\n", label,
+           ns[ns.size() / 2] / 1e3, ns.back() / 1e3, peak);
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    uint32_t logins = argc > 1 ? (uint32_t)atoi(argv[1]) : 1000;
+    CHECK(logins > 0);
+
+    uint8_t q[65];
+    builtinPoint(q);
+    CHECK(memcmp(q, builtinKey().q, sizeof(q)) == 0);
+
+    size_t heapBefore = HostShim::heapInUse();
+    setup();
+    HostShim::freezeClock(true);
+
+    printf("verify path: %s\n", FEATURE_JWT_KEY_TABLE_ENABLED ? "comb table of Q" : "generic m15");
+    printf("heap after boot: %zu B (table %zu B per loaded key)\n", HostShim::heapInUse() - heapBefore,
+           FEATURE_JWT_KEY_TABLE_ENABLED ? sizeof(P256::Table) : (size_t)0);
+    if (FEATURE_JWT_KEY_TABLE_ENABLED) {
+        P256::Table table;
+        uint64_t start = HostShim::hostNanos();
+        for (int i = 0; i < 20; i++) CHECK(P256::buildTable(table, q, sizeof(q)));
+        printf("table build: %.1f us per key load\n", (HostShim::hostNanos() - start) / 20 / 1e3);
+    }
+
+    bench("accept", true, logins);
+    bench("reject", false, logins);
+    return 0;
+}
@@ -0,0 +1,128 @@
+// Base64 codec: random round trips in both alphabets checked against a
+// bit-at-a-time reference, the strict decoder's canonical-form rules, and
+// throughput of the table-driven paths next to the reference.
+//
+//   base64 [buffers]
+
+#include "HostHarness.h"
+
+#include <random>
+#include <vector>
+
+namespace {
+
+const char kStd[] = "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+const char kUrl[] = "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789-_";
+
+std::string referenceEncode(const std::vector<uint8_t>& in, bool url) {
+    const char* chars = url ? kUrl : kStd;
+    std::string out;
+    uint32_t v = 0;
+    int bits = 0;
+    for (uint8_t b : in) {
+        v = (v << 8) | b;
+        bits += 8;
+        while (bits >= 6) {
+            bits -= 6;
+            out += chars[(v >> bits) & 0x3F];
+        }
+    }
+    if (bits) out += chars[(v << (6 - bits)) & 0x3F];
+    if (!url) while (out.size() % 4) out += '=';
+    return out;
+}
+
+std::string encode(const std::vector<uint8_t>& in, Base64::Alphabet alphabet) {
+    std::string out(Base64::encodedLength(in.size(), alphabet) + 1, '\0');
+    size_t n = Base64::encode(in.data(), in.size(), &out[0], alphabet);
+    CHECK(n == Base64::encodedLength(in.size(), alphabet));
+    CHECK(out[n] == '\0');
+    out.resize(n);
+    return out;
+}
+
+size_t strict(const std::string& s, uint8_t* out, size_t cap) {
+    return Base64::decodeUrlStrict(s.data(), s.size(), out, cap);
+}
+
+void roundTrips(uint32_t buffers, std::mt19937& rng) {
+    uint8_t back[300];
+    for (uint32_t i = 0; i < buffers; i++) {
+        std::vector<uint8_t> raw(1 + rng() % 256);
+        for (uint8_t& b : raw) b = (uint8_t)rng();
+
+        std::string std64 = encode(raw, Base64::Alphabet::Standard);
+        std::string url64 = encode(raw, Base64::Alphabet::Url);
+        CHECK(std64 == referenceEncode(raw, false));
+        CHECK(url64 == referenceEncode(raw, true));
+
+        CHECK(Base64::decode(std64.data(), std64.size(), back, sizeof(back)) == raw.size());
+        CHECK(memcmp(back, raw.data(), raw.size()) == 0);
+        CHECK(strict(url64, back, sizeof(back)) == raw.size());
+        CHECK(memcmp(back, raw.data(), raw.size()) == 0);
+
+        // Lenient decode skips whitespace anywhere (PEM line breaks)
+        std::string wrapped = std64;
+        for (size_t at = 64; at < wrapped.size(); at += 65) wrapped.insert(at, "\n");
+        CHECK(Base64::decode(wrapped.data(), wrapped.size(), back, sizeof(back)) == raw.size());
+        CHECK(memcmp(back, raw.data(), raw.size()) == 0);
+
+        // Too small a buffer is a failure, not a truncation
+        CHECK(Base64::decode(std64.data(), std64.size(), back, raw.size() - 1) == 0);
+        CHECK(strict(url64, back, raw.size() - 1) == 0);
+    }
+}
+
+void strictRules() {
+    uint8_t out[8];
+    CHECK(strict("QQ", out, sizeof(out)) == 1 && out[0] == 'A');
+    CHECK(strict("QR", out, sizeof(out)) == 0);    // unused bits set
+    CHECK(strict("QQ==", out, sizeof(out)) == 0);  // padding
+    CHECK(strict("Q", out, sizeof(out)) == 0);     // len % 4 == 1
+    CHECK(strict("+/8", out, sizeof(out)) == 0);   // standard alphabet
+    CHECK(strict("-_8", out, sizeof(out)) == 2);
+    CHECK(strict("QU E", out, sizeof(out)) == 0);  // whitespace
+    CHECK(Base64::decode("-_8=", 4, out, sizeof(out)) == 2);
+    CHECK(Base64::decode("QU*B", 4, out, sizeof(out)) == 0);
+}
+
+template<typename F>
+double mbPerSec(size_t bytesPerCall, uint32_t calls, F fn) {
+    uint64_t start = HostShim::hostNanos();
+    for (uint32_t i = 0; i < calls; i++) fn();
+    return bytesPerCall * (double)calls / ((HostShim::hostNanos() - start) / 1e9) / 1e6;
+}
+
+void bench() {
+    // A JWT signature and a 1 KB raw IR capture, the two hot callers
+    for (size_t size : { (size_t)64, (size_t)1024 }) {
+        std::vector<uint8_t> raw(size);
+        for (size_t i = 0; i < size; i++) raw[i] = (uint8_t)(i * 131 + 7);
+        std::string url64 = encode(raw, Base64::Alphabet::Url);
+        std::vector<char> enc(Base64::encodedLength(size) + 1);
+        std::vector<uint8_t> dec(size);
+        volatile size_t sink = 0;
+
+        const uint32_t calls = 200000 / (uint32_t)(size / 64);
+        double table = mbPerSec(size, calls, [&] { sink += Base64::encode(raw.data(), size, enc.data()); });
+        double ref   = mbPerSec(size, calls, [&] { sink += referenceEncode(raw, false).size(); });
+        double dStr  = mbPerSec(size, calls, [&] { sink += strict(url64, dec.data(), size); });
+        double dLen  = mbPerSec(size, calls, [&] { sink += Base64::decode(url64.data(), url64.size(), dec.data(), size); });
+        printf("%4zu B: encode %7.0f MB/s (reference %5.0f)  decode strict %7.0f MB/s  lenient %7.0f MB/s\n",
+               size, table, ref, dStr, dLen);
+    }
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    uint32_t buffers = argc > 1 ? (uint32_t)atoi(argv[1]) : 200000;
+
+    std::mt19937 rng(2024);
+    roundTrips(buffers, rng);
+    strictRules();
+    printf("round trips: %u buffers OK\n", buffers);
+
+    bench();
+    return 0;
+}
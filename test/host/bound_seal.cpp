@@ -0,0 +1,42 @@
+// Bound-JWT seal: when the ECDSA check of a restored bound JWT runs on a
+// request path it must not write flash; the tag write waits for tick().
+
+#include "HostHarness.h"
+#include "src/auth/AuthManager.h"
+#include "src/auth/Hmac.h"
+
+int main() {
+    setup();
+    HostShim::freezeClock(true);
+
+    // First login binds and seals the owner
+    HostHarness::login("owner");
+    CHECK(SessionManager::hasBoundSub());
+
+    // Reboot with a tag that no longer matches: the sub comes back unverified
+    uint8_t stale[Hmac::SHA256_LEN] = {};
+    CHECK(StorageManager::saveBoundTokenTag(stale));
+    AuthManager::begin();
+    CHECK(SessionManager::hasBoundSub());
+
+    // What the /api/auth, /api/reset and WiFi handlers call first
+    uint64_t written = HostShim::flashBytesWritten();
+    AuthManager::ensureBoundVerified();
+    CHECK(HostShim::flashBytesWritten() == written);
+    CHECK(SessionManager::hasBoundSub());
+
+    // loop() context writes the fresh tag
+    AuthManager::tick();
+    CHECK(HostShim::flashBytesWritten() > written);
+    uint8_t tag[Hmac::SHA256_LEN];
+    CHECK(StorageManager::loadBoundTokenTag(tag));
+    CHECK(memcmp(tag, stale, sizeof(tag)) != 0);
+
+    // Nothing left to do on the next pass
+    written = HostShim::flashBytesWritten();
+    AuthManager::tick();
+    CHECK(HostShim::flashBytesWritten() == written);
+
+    printf("bound seal: OK\n");
+    return 0;
+}
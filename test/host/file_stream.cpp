@@ -0,0 +1,85 @@
+// Block-buffered JSON file I/O: readJson / writeJson round-trip documents of
+// every length around the Config::FILE_CHUNK_BYTES block edges byte for byte,
+// and writeJson reports a write that runs out of flash at any point.
+
+#include "HostHarness.h"
+#include "src/storage/StorageManager.h"
+#include "src/storage/FileStream.h"
+
+#include <ArduinoJson.h>
+
+namespace {
+
+const char kPath[] = "/stream.json";
+
+/** A JSON array of exactly @p len bytes (len >= 2): [], [0], then ["abc..."]. */
+std::string documentOf(size_t len) {
+    if (len == 2) return "[]";
+    if (len == 3) return "[0]";
+    std::string text = "[\"";
+    while (text.size() < len - 2) text += (char)('a' + text.size() % 26);
+    return text + "\"]";
+}
+
+std::string fileText(const char* path) {
+    File f = LittleFS.open(path, "r");
+    CHECK(f);
+    std::string text(f.size(), '\0');
+    CHECK(f.read(reinterpret_cast<uint8_t*>(&text[0]), text.size()) == text.size());
+    return text;
+}
+
+void roundTrips() {
+    const size_t block = Config::FILE_CHUNK_BYTES;
+    for (size_t len = 2; len <= 3 * block + 2; len++) {
+        JsonDocument out(documentOf(len));
+        CHECK(out.text().size() == len);
+        CHECK(StorageManager::writeJson(kPath, out));
+        CHECK(fileText(kPath) == out.text());
+
+        JsonDocument in;
+        CHECK(StorageManager::readJson(kPath, in));
+        CHECK(in.text() == out.text());
+    }
+
+    JsonDocument missing;
+    CHECK(!StorageManager::readJson("/missing.json", missing));
+}
+
+void shortWrites() {
+    JsonDocument doc(documentOf(2 * Config::FILE_CHUNK_BYTES + 17));
+    for (long budget = 0; budget < (long)doc.text().size(); budget += 7) {
+        HostShim::failWritesAfter(budget);
+        CHECK(!StorageManager::writeJson(kPath, doc));
+        HostShim::failWritesAfter(-1);
+    }
+    CHECK(StorageManager::writeJson(kPath, doc));
+}
+
+void singleBytes() {
+    // The per-character paths ArduinoJson also uses
+    File w = LittleFS.open(kPath, "w");
+    {
+        FileChunkWriter writer(w);
+        for (int i = 0; i < 300; i++) CHECK(writer.write((uint8_t)i) == 1);
+        CHECK(writer.flush());
+    }
+    w.close();
+
+    File r = LittleFS.open(kPath, "r");
+    FileChunkReader reader(r);
+    for (int i = 0; i < 300; i++) CHECK(reader.read() == (uint8_t)i);
+    CHECK(reader.read() == -1);
+}
+
+} // namespace
+
+int main() {
+    setup();
+
+    roundTrips();
+    shortWrites();
+    singleBytes();
+    printf("file stream: OK\n");
+    return 0;
+}
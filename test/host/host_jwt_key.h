@@ -0,0 +1,7 @@
+// Built-in JWT key of the host build (see JWT_PUB_KEY_HEADER in Config.cpp).
+// Its private scalar is HostHarness::builtinKey(); never use it on a device.
+const char JWT_PUB_KEY[] =
+    "-----BEGIN PUBLIC KEY-----\n"
+    "MFkwEwYHKoZIzj0CAQYIKoZIzj0DAQcDQgAEDEYjKoG+GRIBzgAt5BSoZaibszi/\n"
+    "WV25wXKrhyrME9Z+vOkegf1DZOVhbTRq5+Vll8gRjZkgb+nfDdeTITkUSg==\n"
+    "-----END PUBLIC KEY-----";
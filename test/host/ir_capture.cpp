@@ -0,0 +1,153 @@
+// Compact raw IR capture events: random tick arrays round-trip through
+// IRManager::encodeRawCapture and a decoder written from the wire format in
+// BinaryProtocol.h, and a corpus of protocol-shaped captures compares the
+// compact event with the "[9000,4500,...]" text event in size and encode time.
+//
+//   ir_capture [random-captures]
+
+#include "HostHarness.h"
+#include "src/hardware/infrared/IRManager.h"
+
+#include <random>
+#include <vector>
+
+namespace {
+
+std::vector<uint16_t> decodeRaw(const uint8_t* event, size_t len) {
+    BinIrRawCaptureEventHeader hdr;
+    CHECK(len >= sizeof(hdr));
+    memcpy(&hdr, event, sizeof(hdr));
+    CHECK(hdr.eventType == BIN_IR_EVENT_CAPTURE_RAW);
+    CHECK(hdr.tickUs == kRawTick);
+    CHECK(sizeof(hdr) + hdr.dataLen == len);
+
+    std::vector<uint16_t> ticks;
+    const uint8_t* p   = event + sizeof(hdr);
+    const uint8_t* end = p + hdr.dataLen;
+    int32_t prev[2] = { 0, 0 };
+    while (p < end) {
+        uint32_t v = 0;
+        int shift = 0;
+        uint8_t b;
+        do {
+            CHECK(p < end && shift < 35);
+            b = *p++;
+            v |= (uint32_t)(b & 0x7F) << shift;
+            shift += 7;
+        } while (b & 0x80);
+        int32_t d = (int32_t)(v >> 1) ^ -(int32_t)(v & 1);
+        int32_t& last = prev[ticks.size() & 1];
+        last += d;
+        CHECK(last >= 0 && last <= UINT16_MAX);
+        ticks.push_back((uint16_t)last);
+    }
+    CHECK(ticks.size() == hdr.count);
+    return ticks;
+}
+
+/** rawbuf layout: [0] is the leading gap, timings follow. */
+decode_results rawResults(std::vector<uint16_t>& rawbuf) {
+    decode_results r;
+    memset(&r, 0, sizeof(r));
+    r.decode_type = UNKNOWN;
+    r.rawbuf      = rawbuf.data();
+    r.rawlen      = (uint16_t)rawbuf.size();
+    return r;
+}
+
+void randomRoundTrips(uint32_t captures) {
+    static uint8_t event[sizeof(BinIrRawCaptureEventHeader) + 3 * Config::CAPTURE_BUFFER_SIZE];
+    std::mt19937 rng(7);
+    for (uint32_t c = 0; c < captures; c++) {
+        std::vector<uint16_t> rawbuf(1 + rng() % Config::CAPTURE_BUFFER_SIZE);
+        uint16_t span = (c % 3 == 0) ? UINT16_MAX : (c % 3 == 1) ? 4000 : 50;
+        for (uint16_t& t : rawbuf) t = (uint16_t)(rng() % (span + 1u));
+        decode_results r = rawResults(rawbuf);
+
+        size_t len = IRManager::encodeRawCapture(&r, event, sizeof(event));
+        CHECK(len > 0 && len <= sizeof(BinIrRawCaptureEventHeader) + 3 * (rawbuf.size() - 1));
+        std::vector<uint16_t> back = decodeRaw(event, len);
+        CHECK(std::equal(back.begin(), back.end(), rawbuf.begin() + 1, rawbuf.end()));
+
+        // One byte short of the data is a failure, not a truncated event
+        CHECK(IRManager::encodeRawCapture(&r, event, len - 1) == 0);
+    }
+}
+
+// ── Corpus: synthetic captures shaped like common remotes, with jitter ──
+
+struct Shape {
+    const char* name;
+    uint16_t    hdrMark, hdrSpace, bitMark, zeroSpace, oneSpace;
+    uint16_t    bytes, frames, gap;  // µs
+};
+
+const Shape kCorpus[] = {
+    { "NEC",          9000, 4500, 560,  560, 1690,  4, 1,     0 },
+    { "SAMSUNG",      4500, 4500, 560,  560, 1690,  4, 1,     0 },
+    { "SONY x3",      2400,  600, 600,  600, 1200,  2, 3, 25000 },
+    { "MITSUBISHI_AC",3400, 1750, 450,  420, 1300, 18, 2, 17100 },
+    { "DAIKIN",       3650, 1623, 428,  428, 1280, 35, 1,     0 },
+    { "DAIKIN x3",    3650, 1623, 428,  428, 1280, 19, 3, 29000 },
+};
+
+std::vector<uint16_t> synthesize(const Shape& s, std::mt19937& rng) {
+    auto jitter = [&](uint16_t us) { return (uint16_t)((us + (int)(rng() % 101) - 50) / kRawTick); };
+    std::vector<uint16_t> raw = { 0 };
+    for (uint16_t f = 0; f < s.frames; f++) {
+        if (f) raw.push_back(jitter(s.gap));
+        raw.push_back(jitter(s.hdrMark));
+        raw.push_back(jitter(s.hdrSpace));
+        for (uint16_t bit = 0; bit < s.bytes * 8; bit++) {
+            raw.push_back(jitter(s.bitMark));
+            raw.push_back(jitter((rng() & 1) ? s.oneSpace : s.zeroSpace));
+        }
+        raw.push_back(jitter(s.bitMark));
+    }
+    CHECK(raw.size() <= Config::CAPTURE_BUFFER_SIZE);
+    return raw;
+}
+
+void corpus() {
+    static uint8_t text[32768];
+    static uint8_t compact[sizeof(BinIrRawCaptureEventHeader) + 3 * Config::CAPTURE_BUFFER_SIZE];
+    const uint32_t rounds = 2000;
+    std::mt19937 rng(11);
+
+    printf("\n%-14s %7s %9s %9s %9s %10s %10s\n", "capture", "timings", "text B", "compact B",
+           "ratio", "text us", "compact us");
+    for (const Shape& s : kCorpus) {
+        std::vector<uint16_t> raw = synthesize(s, rng);
+        decode_results r = rawResults(raw);
+
+        size_t textLen = IRManager::generateIRResult(&r, text, sizeof(text), false);
+        size_t compactLen = IRManager::generateIRResult(&r, compact, sizeof(compact), true);
+        CHECK(textLen > 0 && compactLen > 0);
+        std::vector<uint16_t> back = decodeRaw(compact, compactLen);
+        CHECK(std::equal(back.begin(), back.end(), raw.begin() + 1, raw.end()));
+
+        uint64_t start = HostShim::hostNanos();
+        for (uint32_t i = 0; i < rounds; i++) IRManager::generateIRResult(&r, text, sizeof(text), false);
+        double textUs = (HostShim::hostNanos() - start) / 1e3 / rounds;
+        start = HostShim::hostNanos();
+        for (uint32_t i = 0; i < rounds; i++) IRManager::generateIRResult(&r, compact, sizeof(compact), true);
+        double compactUs = (HostShim::hostNanos() - start) / 1e3 / rounds;
+
+        // Sizes as sent: base64 of the whole event
+        size_t text64 = Base64::encodedLength(textLen), compact64 = Base64::encodedLength(compactLen);
+        printf("%-14s %7zu %9zu %9zu %8.2fx %10.2f %10.2f\n", s.name, raw.size() - 1, text64, compact64,
+               (double)text64 / compact64, textUs, compactUs);
+    }
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    uint32_t captures = argc > 1 ? (uint32_t)atoi(argv[1]) : 5000;
+
+    setup();
+    randomRoundTrips(captures);
+    printf("round trips: %u random captures OK\n", captures);
+    corpus();
+    return 0;
+}
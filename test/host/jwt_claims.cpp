@@ -0,0 +1,110 @@
+// JWT claim scanner: replay the seed corpus, fuzz it with random byte
+// mutations and time a typical login payload.  A mutant the scanner accepts
+// must also pass the ArduinoJson shim's bracket/quote balance check, and
+// every out buffer must stay NUL-terminated inside its capacity.
+//
+//   jwt_claims corpus-file [mutations]
+
+#include "HostHarness.h"
+#include "src/auth/JwtClaims.h"
+
+#include <ArduinoJson.h>
+
+#include <fstream>
+#include <random>
+#include <vector>
+
+namespace {
+
+struct Outputs {
+    char sub[64];
+    char family[64];
+    char challenge[32];
+};
+
+bool scan(const std::string& doc, Outputs& o) {
+    memset(&o, 0x5A, sizeof(o));
+    JwtClaims::Claim claims[] = {
+        { "sub",       o.sub,       sizeof(o.sub),       false },
+        { "family",    o.family,    sizeof(o.family),    false },
+        { "challenge", o.challenge, sizeof(o.challenge), false },
+    };
+    // Exact-size copy so a read past the end shows up under a sanitizer
+    std::vector<uint8_t> buf(doc.begin(), doc.end());
+    bool ok = JwtClaims::scan(buf.data(), buf.size(), claims, 3);
+    if (ok) {
+        CHECK(memchr(o.sub, '\0', sizeof(o.sub)));
+        CHECK(memchr(o.family, '\0', sizeof(o.family)));
+        CHECK(memchr(o.challenge, '\0', sizeof(o.challenge)));
+    }
+    return ok;
+}
+
+std::vector<std::pair<bool, std::string>> loadCorpus(const char* path) {
+    std::vector<std::pair<bool, std::string>> corpus;
+    std::ifstream in(path);
+    CHECK(in.good());
+    std::string line;
+    while (std::getline(in, line)) {
+        if (line.size() < 2 || line[0] == '#') continue;
+        CHECK(line[0] == '+' || line[0] == '-');
+        corpus.push_back({ line[0] == '+', line.substr(2) });
+    }
+    return corpus;
+}
+
+std::string mutate(std::string doc, std::mt19937& rng) {
+    static const char kAlphabet[] = "{}[]\",:\\u0123456789abcdefnull ";
+    int edits = 1 + rng() % 4;
+    for (int i = 0; i < edits; i++) {
+        size_t at = doc.empty() ? 0 : rng() % (doc.size() + 1);
+        char c = (rng() % 4) ? kAlphabet[rng() % (sizeof(kAlphabet) - 1)] : (char)rng();
+        switch (rng() % 3) {
+            case 0: doc.insert(doc.begin() + at, c); break;
+            case 1: if (at < doc.size()) doc.erase(at, 1); break;
+            case 2: if (at < doc.size()) doc[at] = c; break;
+        }
+    }
+    return doc;
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    CHECK(argc > 1);
+    uint32_t mutations = argc > 2 ? (uint32_t)atoi(argv[2]) : 200000;
+
+    auto corpus = loadCorpus(argv[1]);
+    Outputs o;
+    for (const auto& entry : corpus) {
+        if (scan(entry.second, o) != entry.first) {
+            fprintf(stderr, "corpus: expected %s: %s\n", entry.first ? "accept" : "reject", entry.second.c_str());
+            return 1;
+        }
+    }
+    CHECK(scan("{\"sub\":\"caf\\u00e9\",\"family\":\"f\"}", o));
+    CHECK(strcmp(o.sub, "caf\xC3\xA9") == 0 && strcmp(o.family, "f") == 0 && o.challenge[0] == '\0');
+    printf("corpus: %zu documents OK\n", corpus.size());
+
+    std::mt19937 rng(12345);
+    uint32_t accepted = 0;
+    for (uint32_t i = 0; i < mutations; i++) {
+        std::string doc = mutate(corpus[rng() % corpus.size()].second, rng);
+        if (!scan(doc, o)) continue;
+        accepted++;
+        if (ArduinoJsonShim::check(doc) != DeserializationError::Ok) {
+            fprintf(stderr, "fuzz: accepted an unbalanced document: %s\n", doc.c_str());
+            return 1;
+        }
+    }
+    printf("fuzz: %u mutations, %u accepted\n", mutations, accepted);
+
+    const std::string payload =
+        "{\"sub\":\"user-7f3a9c\",\"family\":\"home-42\",\"challenge\":\"k3Z9qA7w\","
+        "\"iat\":1700000000,\"aud\":[\"aetherpulse\",\"devices\"],\"meta\":{\"app\":\"android\",\"v\":3}}";
+    const uint32_t rounds = 100000;
+    uint64_t start = HostShim::hostNanos();
+    for (uint32_t i = 0; i < rounds; i++) CHECK(scan(payload, o));
+    printf("scan: %zu B payload, %.0f ns/scan\n", payload.size(), (HostShim::hostNanos() - start) / (double)rounds);
+    return 0;
+}
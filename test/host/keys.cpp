@@ -0,0 +1,92 @@
+// Verification key table: a key is only used once it is on flash, and a
+// failed save leaves both RAM and flash as they were.
+
+#include "HostHarness.h"
+#include "src/auth/AuthManager.h"
+
+namespace {
+
+bool hasKid(const char* kid) {
+    char kids[Config::JWT_KEY_SLOTS][Config::JWT_KID_LEN];
+    uint8_t n = AuthManager::getKeyIds(kids, Config::JWT_KEY_SLOTS);
+    for (uint8_t i = 0; i < n; i++) {
+        if (strcmp(kids[i], kid) == 0) return true;
+    }
+    return false;
+}
+
+/** POST /api/auth with a token that names @p kid and is signed with @p key. */
+int loginWith(const char* kid, const HostHarness::HostKey& key) {
+    HostShim::advanceMicros(Config::RATE_LIMIT_BUCKET_CAPACITY * 1000000ULL / Config::RATE_LIMIT_REFILL_PER_SEC);
+    BinAuthRequest req;
+    memset(&req, 0, sizeof(req));
+    std::string jwt = HostHarness::makeJwt("owner", HostHarness::challenge(), key, kid);
+    memcpy(req.token, jwt.data(), jwt.size());
+    return HostHarness::request(HTTP_POST, "/api/auth", HostHarness::bytes(req)).code;
+}
+
+void reboot() {
+    AuthManager::resetKeys();
+    AuthManager::begin();
+}
+
+} // namespace
+
+int main() {
+    setup();
+
+    const HostHarness::HostKey& k1 = HostHarness::otherKey(0);
+    const HostHarness::HostKey& k2 = HostHarness::otherKey(1);
+    const uint8_t* q1 = k1.q;
+    const uint8_t* q2 = k2.q;
+
+    // Save fails: not loaded, and still absent after a reboot
+    HostShim::failWritesAfter(0);
+    CHECK(!AuthManager::addKey("ops", q1));
+    CHECK(!hasKid("ops"));
+    HostShim::failWritesAfter(-1);
+    reboot();
+    CHECK(!hasKid("ops"));
+
+    CHECK(AuthManager::addKey("ops", q1));
+    CHECK(hasKid("ops"));
+    reboot();
+    CHECK(hasKid("ops"));
+
+    // Invalid point: rejected before anything is written
+    uint64_t written = HostShim::flashBytesWritten();
+    uint8_t bad[65] = { 0x04 };
+    CHECK(!AuthManager::addKey("bad", bad));
+    CHECK(HostShim::flashBytesWritten() == written);
+
+    // Remove fails: the key stays in RAM and on flash
+    HostShim::failWritesAfter(0);
+    CHECK(!AuthManager::removeKey("ops"));
+    CHECK(hasKid("ops"));
+    HostShim::failWritesAfter(-1);
+    reboot();
+    CHECK(hasKid("ops"));
+
+    CHECK(AuthManager::removeKey("ops"));
+    CHECK(!hasKid("ops"));
+    reboot();
+    CHECK(!hasKid("ops"));
+
+    // Replacing a kid whose save fails keeps the old point
+    CHECK(AuthManager::addKey("ops", q1));
+    HostShim::failWritesAfter(0);
+    CHECK(!AuthManager::addKey("ops", q2));
+    HostShim::failWritesAfter(-1);
+    CHECK(hasKid("ops"));
+    CHECK(loginWith("ops", k1) == 200);
+    CHECK(loginWith("ops", k2) == 401);
+
+    // Off-curve point: one flipped bit of a valid Y
+    uint8_t offCurve[65];
+    memcpy(offCurve, q1, sizeof(offCurve));
+    offCurve[64] ^= 1;
+    CHECK(!AuthManager::addKey("bad", offCurve));
+
+    printf("keys: OK\n");
+    return 0;
+}
@@ -0,0 +1,112 @@
+// P256 comb table against OpenSSL: k·Q from mulTable() for random keys and
+// scalars (plus the edge scalars), point decoding, and ECDSA signatures from
+// the host signer through br_ecdsa_i15_vrfy_raw().
+//
+//   p256 [keys]
+
+#include "HostHarness.h"
+#include "src/auth/P256.h"
+
+#include <openssl/bn.h>
+#include <openssl/ec.h>
+#include <openssl/obj_mac.h>
+#include <openssl/rand.h>
+
+namespace {
+
+EC_GROUP* g_group = nullptr;
+
+/** OpenSSL's k·Q, encoded; false at infinity. */
+bool referenceMul(const uint8_t q[65], const uint8_t* k, size_t klen, uint8_t out[65]) {
+    EC_POINT* Q = EC_POINT_new(g_group);
+    EC_POINT* R = EC_POINT_new(g_group);
+    BIGNUM*   s = BN_bin2bn(k, (int)klen, nullptr);
+    CHECK(EC_POINT_oct2point(g_group, Q, q, 65, nullptr) == 1);
+    CHECK(EC_POINT_mul(g_group, R, nullptr, Q, s, nullptr) == 1);
+    bool finite = !EC_POINT_is_at_infinity(g_group, R);
+    if (finite) CHECK(EC_POINT_point2oct(g_group, R, POINT_CONVERSION_UNCOMPRESSED, out, 65, nullptr) == 65);
+    BN_free(s);
+    EC_POINT_free(R);
+    EC_POINT_free(Q);
+    return finite;
+}
+
+void checkMul(const P256::Table& table, const uint8_t q[65], const uint8_t* k, size_t klen) {
+    P256::Jacobian r;
+    P256::mulTable(r, table, k, klen);
+    uint8_t got[65], want[65];
+    bool finite = referenceMul(q, k, klen, want);
+    CHECK(P256::encode(got, r) == finite);
+    if (finite) CHECK(memcmp(got, want, sizeof(got)) == 0);
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    int keys = argc > 1 ? atoi(argv[1]) : 100;
+    CHECK(keys > 0);
+    g_group = EC_GROUP_new_by_curve_name(NID_X9_62_prime256v1);
+
+    size_t nLen;
+    const uint8_t* n = br_ec_p256_m15.order(BR_EC_secp256r1, &nLen);
+    CHECK(nLen == 32);
+
+    for (int i = 0; i < keys; i++) {
+        HostHarness::HostKey key;
+        do {
+            RAND_bytes(key.d, sizeof(key.d));
+        } while (memcmp(key.d, n, 32) >= 0);
+        host_ec_public(key.d, key.q);
+
+        P256::Table table;
+        CHECK(P256::buildTable(table, key.q, sizeof(key.q)));
+
+        uint8_t k[32];
+        RAND_bytes(k, sizeof(k));
+        checkMul(table, key.q, k, sizeof(k));
+        checkMul(table, key.q, k, 1 + k[0] % 32);  // short scalars are left-padded
+
+        if (i == 0) {
+            // 0 → infinity, 1 → Q, n-1 → -Q, n → infinity, 2^256-1
+            const uint8_t zero[32] = {}, one = 1;
+            uint8_t nm1[32], ones[32];
+            memcpy(nm1, n, 32);
+            nm1[31] -= 1;
+            memset(ones, 0xFF, sizeof(ones));
+            checkMul(table, key.q, zero, sizeof(zero));
+            checkMul(table, key.q, &one, 1);
+            checkMul(table, key.q, nm1, sizeof(nm1));
+            checkMul(table, key.q, n, 32);
+            checkMul(table, key.q, ones, sizeof(ones));
+        }
+
+        // Signatures from the host signer verify; a flipped bit does not
+        uint8_t hash[32], sig[64];
+        RAND_bytes(hash, sizeof(hash));
+        host_ecdsa_sign(key.d, hash, sig);
+        br_ec_public_key pk = { BR_EC_secp256r1, key.q, sizeof(key.q) };
+        CHECK(br_ecdsa_i15_vrfy_raw(&br_ec_p256_m15, hash, 32, &pk, sig, 64) == 1);
+        hash[k[1] % 32] ^= (uint8_t)(1 << (k[2] % 8));
+        CHECK(br_ecdsa_i15_vrfy_raw(&br_ec_p256_m15, hash, 32, &pk, sig, 64) == 0);
+
+        // Decoding: off-curve, wrong prefix, coordinate ≥ p, wrong length
+        P256::Affine a;
+        uint8_t bad[65];
+        memcpy(bad, key.q, sizeof(bad));
+        bad[64] ^= 1;
+        CHECK(!P256::decode(a, bad, sizeof(bad)));
+        CHECK(!P256::buildTable(table, bad, sizeof(bad)));
+        memcpy(bad, key.q, sizeof(bad));
+        bad[0] = 0x02;
+        CHECK(!P256::decode(a, bad, sizeof(bad)));
+        memset(bad + 1, 0xFF, 32);
+        bad[0] = 0x04;
+        CHECK(!P256::decode(a, bad, sizeof(bad)));
+        CHECK(!P256::decode(a, key.q, 64));
+        CHECK(P256::decode(a, key.q, sizeof(key.q)));
+    }
+
+    EC_GROUP_free(g_group);
+    printf("p256: %d keys OK\n", keys);
+    return 0;
+}
@@ -0,0 +1,81 @@
+// Per-client rate limiting: table eviction must not hand a throttled client a
+// fresh bucket, and a flood from many addresses must not push tracked clients
+// out.  Also times the limiter with a few and with many distinct clients.
+//
+//   rate_limit [requests]
+
+#include "HostHarness.h"
+
+using namespace HostHarness;
+
+namespace {
+
+int ping(uint32_t ip) {
+    return request(HTTP_GET, "/ping", std::string(), std::string(), ip).code;
+}
+
+uint32_t clientIp(uint32_t n) {
+    return 0x0000A8C0 | (n << 24) | ((n >> 8) << 16);  // 192.168.x.y
+}
+
+void waitForFullRefill() {
+    HostShim::advanceMicros(Config::RATE_LIMIT_BUCKET_CAPACITY * 1000000ULL / Config::RATE_LIMIT_REFILL_PER_SEC);
+}
+
+void checkEviction() {
+    const uint32_t tracked = Config::RATE_LIMIT_CLIENTS;
+    const uint32_t spent   = 3;
+
+    // Fill the table with clients that each owe a few tokens
+    for (uint32_t c = 1; c <= tracked; c++) {
+        for (uint32_t i = 0; i < spent; i++) CHECK(ping(clientIp(c)) == 200);
+    }
+
+    // A flood from fresh addresses drains the shared overflow bucket only
+    uint32_t admitted = 0;
+    for (uint32_t c = 100; c < 200; c++) {
+        if (ping(clientIp(c)) == 200) admitted++;
+    }
+    CHECK(admitted == Config::RATE_LIMIT_BUCKET_CAPACITY);
+
+    // Tracked clients kept their buckets: exactly the remaining tokens, then 429
+    for (uint32_t c = 1; c <= tracked; c++) {
+        for (uint32_t i = spent; i < Config::RATE_LIMIT_BUCKET_CAPACITY; i++) CHECK(ping(clientIp(c)) == 200);
+        CHECK(ping(clientIp(c)) == 429);
+    }
+
+    // Once a bucket has refilled it can be recycled for a newcomer
+    waitForFullRefill();
+    CHECK(ping(clientIp(300)) == 200);
+    for (uint32_t i = 1; i < Config::RATE_LIMIT_BUCKET_CAPACITY; i++) CHECK(ping(clientIp(300)) == 200);
+    CHECK(ping(clientIp(300)) == 429);
+}
+
+void bench(uint32_t clients, uint32_t requests) {
+    waitForFullRefill();
+    uint32_t ok = 0;
+    uint64_t start = HostShim::hostNanos();
+    for (uint32_t i = 0; i < requests; i++) {
+        if (ping(clientIp(1000 + i % clients)) == 200) ok++;
+        if (i % clients == clients - 1) HostShim::advanceMicros(250000);  // 4 tokens/s → one per client
+    }
+    double secs = (HostShim::hostNanos() - start) / 1e9;
+    printf("%3u clients: %.0f req/s, %u of %u admitted\n", clients, requests / secs, ok, requests);
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    uint32_t requests = argc > 1 ? (uint32_t)atoi(argv[1]) : 20000;
+
+    setup();
+    HostShim::freezeClock(true);
+
+    checkEviction();
+    printf("eviction: OK\n");
+
+    bench(4, requests);
+    bench(Config::RATE_LIMIT_CLIENTS, requests);
+    bench(64, requests);
+    return 0;
+}
@@ -0,0 +1,174 @@
+// Config record log against the in-memory LittleFS: every torn append and a
+// failed compaction leave the previous value readable after a remount,
+// tombstones survive a remount, compaction keeps the live records, and a
+// legacy file is only deleted once its record is in the log.
+
+#include "HostHarness.h"
+#include "src/storage/RecordStore.h"
+#include "src/storage/StorageManager.h"
+
+namespace {
+
+struct Payload {
+    uint8_t  bytes[24];
+    explicit Payload(uint8_t seed) { for (uint8_t i = 0; i < sizeof(bytes); i++) bytes[i] = seed + i; }
+};
+
+const RecordType A = RecordType::GPIO_CONFIG;
+const RecordType B = RecordType::WIRELESS_CONFIG;
+
+bool holds(RecordType type, uint8_t seed) {
+    Payload expect(seed), got(0);
+    return RecordStore::read(type, &got, sizeof(got)) && memcmp(&got, &expect, sizeof(got)) == 0;
+}
+
+bool put(RecordType type, uint8_t seed) {
+    Payload p(seed);
+    return RecordStore::write(type, &p, sizeof(p));
+}
+
+size_t logSize() {
+    File f = LittleFS.open(Config::RECORD_STORE_FILE, "r");
+    return f ? f.size() : 0;
+}
+
+void remount() {
+    CHECK(RecordStore::begin());
+}
+
+void fresh() {
+    HostShim::failWritesAfter(-1);
+    HostShim::eraseFlash();
+    remount();
+}
+
+void tornAppends() {
+    const long recordBytes = 8 + sizeof(Payload);
+    for (long budget = 0; budget < recordBytes; budget++) {
+        fresh();
+        CHECK(put(A, 1) && put(B, 50));
+
+        HostShim::failWritesAfter(budget);
+        CHECK(!put(A, 2));
+        HostShim::failWritesAfter(-1);
+        CHECK(holds(A, 1));
+
+        // Power loss now: the torn tail is dropped at mount
+        remount();
+        CHECK(holds(A, 1) && holds(B, 50));
+
+        // The next append lands cleanly and survives another mount
+        CHECK(put(A, 3));
+        remount();
+        CHECK(holds(A, 3) && holds(B, 50));
+    }
+
+    // Torn append followed directly by another write, no remount between
+    fresh();
+    CHECK(put(A, 1));
+    HostShim::failWritesAfter(5);
+    CHECK(!put(A, 2));
+    HostShim::failWritesAfter(-1);
+    CHECK(put(B, 60));
+    remount();
+    CHECK(holds(A, 1) && holds(B, 60));
+}
+
+void unchangedWrites() {
+    fresh();
+    CHECK(put(A, 7));
+    uint64_t written = HostShim::flashBytesWritten();
+    CHECK(put(A, 7));
+    CHECK(HostShim::flashBytesWritten() == written);
+}
+
+void tombstones() {
+    fresh();
+    CHECK(put(A, 1) && put(B, 2));
+    CHECK(RecordStore::erase(A));
+    CHECK(!RecordStore::exists(A) && RecordStore::exists(B));
+    remount();
+    CHECK(!RecordStore::exists(A) && holds(B, 2));
+    CHECK(put(A, 4));
+    remount();
+    CHECK(holds(A, 4));
+
+    // Removing the last runtime key leaves no keys record
+    JwtKeyStoreData keys;
+    keys.count = 1;
+    memset(&keys.keys[0], 0, sizeof(keys.keys[0]));
+    keys.keys[0].kid[0] = 'k';
+    CHECK(StorageManager::saveJwtKeys(keys));
+    CHECK(RecordStore::exists(RecordType::JWT_KEYS));
+    keys.count = 0;
+    CHECK(StorageManager::saveJwtKeys(keys));
+    remount();
+    CHECK(!RecordStore::exists(RecordType::JWT_KEYS));
+}
+
+void compaction() {
+    fresh();
+    CHECK(put(B, 200));
+    uint8_t seed = 0;
+    while (logSize() < Config::RECORD_COMPACT_BYTES + 2 * sizeof(Payload)) CHECK(put(A, ++seed));
+
+    // Not while writes are still coming in
+    size_t before = logSize();
+    RecordStore::tick();
+    CHECK(logSize() == before);
+
+    // A failed rewrite keeps the old log
+    HostShim::advanceMicros(Config::RECORD_COMPACT_IDLE_MS * 1000ULL);
+    HostShim::failWritesAfter(10);
+    RecordStore::tick();
+    HostShim::failWritesAfter(-1);
+    CHECK(logSize() == before);
+    remount();
+    CHECK(holds(A, seed) && holds(B, 200));
+
+    HostShim::advanceMicros(Config::RECORD_COMPACT_IDLE_MS * 1000ULL);
+    RecordStore::tick();
+    CHECK(logSize() == 2 * (8 + sizeof(Payload)));
+    CHECK(holds(A, seed) && holds(B, 200));
+    remount();
+    CHECK(holds(A, seed) && holds(B, 200));
+}
+
+void migration() {
+    HostShim::failWritesAfter(-1);
+    HostShim::eraseFlash();
+    const uint8_t sleep = 1;
+    File legacy = LittleFS.open(Config::SLEEP_CONFIG_FILE, "w");
+    CHECK(legacy.write(&sleep, 1) == 1);
+    legacy.close();
+
+    CHECK(StorageManager::begin());
+    CHECK(!LittleFS.exists(Config::SLEEP_CONFIG_FILE));
+    bool enabled = false;
+    CHECK(StorageManager::loadSleepEnabled(enabled) && enabled);
+
+    // A failed write keeps the file for the next boot
+    legacy = LittleFS.open(Config::GPIO_CONFIG_FILE, "w");
+    Payload p(9);
+    CHECK(legacy.write(p.bytes, sizeof(p.bytes)) == sizeof(p.bytes));
+    legacy.close();
+    HostShim::failWritesAfter(0);
+    CHECK(StorageManager::begin());
+    HostShim::failWritesAfter(-1);
+    CHECK(LittleFS.exists(Config::GPIO_CONFIG_FILE));
+}
+
+} // namespace
+
+int main() {
+    setup();
+    HostShim::freezeClock(true);
+
+    tornAppends();
+    unchangedWrites();
+    tombstones();
+    compaction();
+    migration();
+    printf("record store: OK\n");
+    return 0;
+}
@@ -0,0 +1,282 @@
+// Replays a scripted session against every HTTP route of the real sketch and
+// reports throughput, per-route handler latency, time to the last response
+// byte, socket writes per response and the heap high-water mark.  Built twice:
+// `replay` with the single-write response path and `replay_split_write` with
+// the old sendHeader()/send()/sendContent() writer, for before/after TTLB.
+//
+//   replay [iterations]      (HOST_SERIAL=1 echoes the firmware's serial log)
+//
+// Each iteration logs in (binding the device on the first pass), exercises
+// every route with a well-formed binary request, and finishes with a factory
+// reset so the next iteration starts from an unbound device.  A status code
+// that differs from the expected one fails the run.
+
+#include "HostHarness.h"
+#include <IRrecv.h>
+#include <IRsend.h>
+
+#include <algorithm>
+#include <map>
+#include <vector>
+
+using namespace HostHarness;
+
+namespace {
+
+struct RouteStats {
+    std::vector<uint64_t> handlerNs;
+    std::vector<uint64_t> ttlbNs;
+    uint32_t              writes   = 0;  // most socket writes for one response
+    size_t                heapPeak = 0;  // largest transient heap use during one request
+};
+
+std::map<std::string, RouteStats> g_stats;
+uint32_t g_requests = 0;
+size_t   g_heapHighWater = 0;  // most heap in use at any point of the run
+
+const char* methodName(HTTPMethod m) {
+    switch (m) {
+        case HTTP_GET:     return "GET";
+        case HTTP_POST:    return "POST";
+        case HTTP_PUT:     return "PUT";
+        case HTTP_DELETE:  return "DELETE";
+        case HTTP_OPTIONS: return "OPTIONS";
+        default:           return "ANY";
+    }
+}
+
+/** Let the client's rate-limit bucket refill completely. */
+void refill() {
+    HostShim::advanceMicros(Config::RATE_LIMIT_BUCKET_CAPACITY * 1000000ULL / Config::RATE_LIMIT_REFILL_PER_SEC);
+}
+
+/** Send one request, check its status and fold it into the route table. */
+Reply expect(int code, HTTPMethod method, const std::string& uri,
+             const std::string& body = std::string(), const std::string& auth = std::string()) {
+    refill();  // keep the rate limiter out of the way
+
+    size_t heapBefore = HostShim::heapInUse();
+    HostShim::resetHeapHighWater();
+    Reply r = request(method, uri, body, auth);
+    size_t heapPeak = HostShim::heapHighWater() - heapBefore;
+    g_heapHighWater = std::max(g_heapHighWater, HostShim::heapHighWater());
+
+    if (r.code != code) {
+        fprintf(stderr, "%s %s: expected %d, got %d\n", methodName(method), uri.c_str(), code, r.code);
+        exit(1);
+    }
+
+    std::string key = std::string(methodName(method)) + " " + uri.substr(0, uri.find('?'));
+    RouteStats& s = g_stats[key];
+    s.handlerNs.push_back(r.handlerNs);
+    s.ttlbNs.push_back(r.ttlbNs);
+    s.writes = std::max(s.writes, r.conn->writes);
+    s.heapPeak = std::max(s.heapPeak, heapPeak);
+    g_requests++;
+    return r;
+}
+
+std::string storedCode(uint16_t id, uint64_t value) {
+    BinIrCodeHeader hdr;
+    memset(&hdr, 0, sizeof(hdr));
+    hdr.id       = id;
+    hdr.kind     = BIN_IR_CODE_VALUE;
+    hdr.protocol = NEC;
+    hdr.bits     = 32;
+    hdr.dataLen  = sizeof(value);
+    return bytes(hdr) + bytes(value);
+}
+
+std::string batchCommand(uint8_t type, const std::string& payload) {
+    BinBatchCommandHeader cmd;
+    cmd.type       = type;
+    cmd.delayMs    = 0;
+    cmd.payloadLen = (uint16_t)payload.size();
+    return bytes(cmd) + payload;
+}
+
+std::string ownerBearer() {
+    refill();
+    return std::string("Bearer ") + makeJwt("owner", challenge(), builtinKey());
+}
+
+void runIteration() {
+    expect(204, HTTP_OPTIONS, "/api/device");
+    expect(404, HTTP_GET, "/api/nope");
+    expect(200, HTTP_GET, "/ping");
+    expect(401, HTTP_GET, "/api/device");
+
+    refill();
+    std::string session = login("owner");
+    expect(200, HTTP_GET, "/api/device", std::string(), session);
+
+    // ── Wireless ──
+    expect(200, HTTP_GET, "/api/wireless", std::string(), session);
+    BinWirelessSetRequest wifi;
+    memset(&wifi, 0, sizeof(wifi));
+    strcpy(wifi.wireless_mode, "AP");
+    strcpy(wifi.ap_ssid, "AetherPulse");
+    strcpy(wifi.ap_password, "host-password");
+    expect(200, HTTP_PUT, "/api/wireless", bytes(wifi), session);
+    expect(202, HTTP_GET, "/api/wireless/scan", std::string(), session);
+    expect(202, HTTP_GET, "/api/wireless/scan", std::string(), session);
+    expect(200, HTTP_GET, "/api/wireless/scan", std::string(), session);
+
+    // ── GPIO ──
+    BinGpioSetRequest gpio;
+    gpio.pinNumber = 5;
+    gpio.pinMode   = 1;
+    gpio.pinValue  = 1;
+    expect(200, HTTP_POST, "/api/gpio/set", bytes(gpio), session);
+    expect(200, HTTP_GET, "/api/gpio/get", std::string(), session);
+    expect(200, HTTP_GET, "/api/gpio/get?pin=5", std::string(), session);
+
+    // ── IR ──
+    const char necCode[] = "0x20DF10EF";
+    BinIrSendHeader send;
+    memset(&send, 0, sizeof(send));
+    strcpy(send.protocol, "NEC");
+    send.bitLength = 32;
+    send.irCodeLen = sizeof(necCode) - 1;
+    const std::string sendBody = bytes(send) + necCode;
+    expect(200, HTTP_POST, "/api/ir/send", sendBody, session);
+
+    BinIrCodeIdRequest codeId;
+    codeId.id = 7;
+    expect(200, HTTP_POST, "/api/ir/codes", storedCode(7, 0x20DF10EF), session);
+    expect(200, HTTP_GET, "/api/ir/codes", std::string(), session);
+    expect(200, HTTP_POST, "/api/ir/fire", bytes(codeId), session);
+    expect(200, HTTP_POST, "/api/ir/emit", storedCode(0, 0x20DF40BF), session);
+
+    BinIrCodeHeader queued;
+    memset(&queued, 0, sizeof(queued));
+    queued.id   = 7;
+    queued.kind = BIN_IR_CODE_STORED;
+    Reply q = expect(202, HTTP_POST, "/api/ir/queue", bytes(queued), session);
+    BinIrQueueResponse job = bodyAs<BinIrQueueResponse>(q);
+    Reply st = expect(200, HTTP_GET, "/api/ir/queue?job=" + std::to_string(job.jobId), std::string(), session);
+    CHECK(bodyAs<BinIrJobStatusResponse>(st).state == BIN_IR_JOB_DONE);
+
+    BinBatchHeader batch;
+    batch.count = 3;
+    expect(200, HTTP_POST, "/api/batch",
+           bytes(batch) + batchCommand(BIN_BATCH_GPIO_SET, bytes(gpio))
+                        + batchCommand(BIN_BATCH_IR_FIRE, bytes(codeId))
+                        + batchCommand(BIN_BATCH_IR_SEND, sendBody),
+           session);
+
+    // A body over one raw chunk is refused outright; so are long delay chains
+    BinBatchHeader single;
+    single.count = 1;
+    expect(413, HTTP_POST, "/api/batch",
+           bytes(single) + batchCommand(BIN_BATCH_IR_SEND, std::string(HTTP_RAW_BUFLEN, '\0')), session);
+    BinBatchCommandHeader slow;
+    slow.type       = BIN_BATCH_IR_FIRE;
+    slow.delayMs    = Config::BATCH_MAX_DELAY_MS;
+    slow.payloadLen = sizeof(codeId);
+    BinBatchHeader pair;
+    pair.count = 2;
+    expect(400, HTTP_POST, "/api/batch", bytes(pair) + bytes(slow) + bytes(codeId) + bytes(slow) + bytes(codeId),
+           session);
+
+    expect(200, HTTP_DELETE, "/api/ir/codes", bytes(codeId), session);
+    expect(404, HTTP_POST, "/api/ir/fire", bytes(codeId), session);
+
+    // Capture: the handler keeps the client and streams from loop()
+    BinIrCaptureRequest capture;
+    capture.captureMode = 0;
+    capture.flags       = BIN_IR_CAPTURE_COMPACT;
+    Reply cap = expect(200, HTTP_POST, "/api/ir/capture", bytes(capture), session);
+    static volatile uint16_t rawbuf[68];
+    rawbuf[0] = 0;
+    rawbuf[1] = 4500;
+    rawbuf[2] = 2250;
+    for (int i = 3; i < 67; i++) rawbuf[i] = (i & 1) ? 280 : ((i % 4 == 0) ? 845 : 280);
+    decode_results results;
+    memset(&results, 0, sizeof(results));
+    results.decode_type = UNKNOWN;
+    results.rawbuf      = rawbuf;
+    results.rawlen      = 67;
+    IRrecv::hostInject(results);
+    for (int i = 0; i < 10 && cap.conn->open; i++) loop();
+    CHECK(!cap.conn->open);
+
+    // ── Settings, metrics, keys ──
+    BinSleepRequest sleep;
+    sleep.enabled = 0;
+    expect(200, HTTP_PUT, "/api/sleep", bytes(sleep), session);
+    expect(200, HTTP_GET, "/api/metrics", std::string(), session);
+    expect(200, HTTP_GET, "/api/keys", std::string(), session);
+
+    BinKeyAddRequest key;
+    memset(&key, 0, sizeof(key));
+    strcpy(key.kid, "host");
+    memcpy(key.point, otherKey(0).q, sizeof(key.point));
+    expect(401, HTTP_POST, "/api/keys", bytes(key), session);
+    expect(200, HTTP_POST, "/api/keys", bytes(key), ownerBearer());
+
+    // A token signed for the added key selects it through "kid"
+    BinAuthRequest auth;
+    memset(&auth, 0, sizeof(auth));
+    refill();
+    std::string kidJwt = makeJwt("owner", challenge(), otherKey(0), "host");
+    memcpy(auth.token, kidJwt.data(), kidJwt.size());
+    Reply relogin = expect(200, HTTP_POST, "/api/auth", bytes(auth));
+    session = std::string("Session ") + bodyAs<BinAuthResponse>(relogin).sessionToken;
+
+    BinKeyRemoveRequest removeKey;
+    memset(&removeKey, 0, sizeof(removeKey));
+    strcpy(removeKey.kid, "host");
+    expect(200, HTTP_DELETE, "/api/keys", bytes(removeKey), ownerBearer());
+
+    uint32_t restarts = HostShim::restartCount();
+    expect(200, HTTP_POST, "/api/restart", std::string(), session);
+    CHECK(HostShim::restartCount() == restarts + 1);
+
+    expect(200, HTTP_POST, "/api/reset", std::string(), ownerBearer());
+    expect(401, HTTP_GET, "/api/device", std::string(), session);
+}
+
+uint64_t percentile(std::vector<uint64_t> v, unsigned pct) {
+    std::sort(v.begin(), v.end());
+    return v[(v.size() - 1) * pct / 100];
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    int iterations = argc > 1 ? atoi(argv[1]) : 50;
+    if (iterations <= 0) iterations = 1;
+    HostShim::setSerialEcho(getenv("HOST_SERIAL") != nullptr);
+
+    setup();
+
+    uint64_t start = HostShim::hostNanos();
+    for (int i = 0; i < iterations; i++) runIteration();
+    uint64_t wallNs = HostShim::hostNanos() - start;
+
+    uint64_t handlerNs = 0;
+    for (const auto& entry : g_stats) {
+        for (uint64_t ns : entry.second.handlerNs) handlerNs += ns;
+    }
+
+    printf("%u requests over %d iterations, %zu routes\n", g_requests, iterations, g_stats.size());
+    printf("throughput: %.0f req/s wall, %.0f req/s in handlers\n",
+           g_requests / (wallNs / 1e9), g_requests / (handlerNs / 1e9));
+    printf("heap high-water: %zu B in use at peak, free heap low-water %u B of %u B\n",
+           g_heapHighWater, (unsigned)(HostShim::HEAP_SIZE - g_heapHighWater),
+           (unsigned)HostShim::HEAP_SIZE);
+    printf("response writer: %s\n", FEATURE_SINGLE_WRITE_RESPONSE_ENABLED ? "single write" : "split write");
+    printf("\n%-24s %7s %10s %10s %10s %10s %10s %7s %10s\n", "route", "count", "mean us", "p50 us", "max us",
+           "ttlb p50", "ttlb max", "writes", "heap B");
+    for (const auto& entry : g_stats) {
+        const RouteStats& s = entry.second;
+        uint64_t sum = 0;
+        for (uint64_t ns : s.handlerNs) sum += ns;
+        printf("%-24s %7zu %10.1f %10.1f %10.1f %10.1f %10.1f %7u %10zu\n", entry.first.c_str(),
+               s.handlerNs.size(), sum / 1e3 / s.handlerNs.size(), percentile(s.handlerNs, 50) / 1e3,
+               percentile(s.handlerNs, 100) / 1e3, percentile(s.ttlbNs, 50) / 1e3,
+               percentile(s.ttlbNs, 100) / 1e3, (unsigned)s.writes, s.heapPeak);
+    }
+    return 0;
+}
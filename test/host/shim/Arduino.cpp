@@ -0,0 +1,178 @@
+#include <Arduino.h>
+#include <ArduinoOTA.h>
+#include <ESP8266mDNS.h>
+#include "HostShim.h"
+
+#include <chrono>
+#include <new>
+
+const String    emptyString;
+HardwareSerial  Serial;
+EspClass        ESP;
+MDNSResponder   MDNS;
+ArduinoOTAClass ArduinoOTA;
+
+// ── Heap accounting ──────────────────────────────────────────────────────────
+// Every allocation carries a 16-byte size prefix so delete can subtract it.
+
+namespace {
+size_t g_heapInUse     = 0;
+size_t g_heapHighWater = 0;
+
+void* trackedAlloc(size_t size) {
+    void* p = malloc(size + 16);
+    if (!p) throw std::bad_alloc();
+    *static_cast<size_t*>(p) = size;
+    g_heapInUse += size;
+    if (g_heapInUse > g_heapHighWater) g_heapHighWater = g_heapInUse;
+    return static_cast<uint8_t*>(p) + 16;
+}
+
+void trackedFree(void* p) {
+    if (!p) return;
+    uint8_t* base = static_cast<uint8_t*>(p) - 16;
+    g_heapInUse -= *reinterpret_cast<size_t*>(base);
+    free(base);
+}
+} // namespace
+
+void* operator new(size_t size)   { return trackedAlloc(size); }
+void* operator new[](size_t size) { return trackedAlloc(size); }
+void operator delete(void* p) noexcept           { trackedFree(p); }
+void operator delete[](void* p) noexcept         { trackedFree(p); }
+void operator delete(void* p, size_t) noexcept   { trackedFree(p); }
+void operator delete[](void* p, size_t) noexcept { trackedFree(p); }
+
+// ── Clock ────────────────────────────────────────────────────────────────────
+
+namespace {
+using HostClock = std::chrono::steady_clock;
+
+const HostClock::time_point g_clockStart = HostClock::now();
+uint64_t g_virtualUs    = 0;      // time skipped by delay() / advanceMicros()
+bool     g_clockFrozen  = false;
+uint64_t g_frozenHostUs = 0;      // host part of the clock when it was frozen
+uint64_t g_hostUsOffset = 0;      // host time spent frozen, excluded from the clock
+
+uint64_t hostUs() {
+    return HostShim::hostNanos() / 1000;
+}
+
+uint64_t nowUs() {
+    uint64_t host = g_clockFrozen ? g_frozenHostUs : hostUs() - g_hostUsOffset;
+    return host + g_virtualUs;
+}
+} // namespace
+
+unsigned long millis() { return (unsigned long)(uint32_t)(nowUs() / 1000); }
+unsigned long micros() { return (unsigned long)(uint32_t)nowUs(); }
+void delay(unsigned long ms) { g_virtualUs += (uint64_t)ms * 1000; }
+void delayMicroseconds(unsigned int us) { g_virtualUs += us; }
+void yield() {}
+
+// ── GPIO ─────────────────────────────────────────────────────────────────────
+
+namespace {
+int g_pins[64];
+}
+
+void pinMode(uint8_t, uint8_t) {}
+void digitalWrite(uint8_t pin, uint8_t value) { if (pin < 64) g_pins[pin] = value ? HIGH : LOW; }
+int  digitalRead(uint8_t pin) { return pin < 64 ? g_pins[pin] : LOW; }
+
+// ── Random (deterministic, so runs are repeatable) ───────────────────────────
+
+namespace {
+uint64_t g_rng = 0x9E3779B97F4A7C15ULL;
+
+uint32_t nextRandom() {
+    g_rng ^= g_rng << 13;
+    g_rng ^= g_rng >> 7;
+    g_rng ^= g_rng << 17;
+    return (uint32_t)(g_rng >> 16);
+}
+} // namespace
+
+long random(long max) { return max > 0 ? (long)(nextRandom() % (uint32_t)max) : 0; }
+long random(long min, long max) { return max > min ? min + random(max - min) : min; }
+void randomSeed(unsigned long seed) { g_rng = seed ? seed : 1; }
+
+extern "C" uint32_t os_random() { return nextRandom(); }
+extern "C" int os_get_random(unsigned char* buf, size_t len) {
+    for (size_t i = 0; i < len; i++) buf[i] = (unsigned char)nextRandom();
+    return 0;
+}
+
+// ── Serial ───────────────────────────────────────────────────────────────────
+
+namespace {
+bool g_serialEcho = false;
+}
+
+size_t HardwareSerial::write(uint8_t c) { return write(&c, 1); }
+
+size_t HardwareSerial::write(const uint8_t* buf, size_t len) {
+    if (g_serialEcho) fwrite(buf, 1, len, stdout);
+    return len;
+}
+
+// ── ESP ──────────────────────────────────────────────────────────────────────
+
+namespace {
+uint32_t g_restarts = 0;
+uint32_t g_rtcMemory[128];  // 512 bytes of RTC user memory
+rst_info g_resetInfo = { REASON_DEFAULT_RST };
+}
+
+void     EspClass::restart() { g_restarts++; }
+uint32_t EspClass::getChipId() { return 0x00C0FFEE; }
+uint32_t EspClass::getFreeHeap() {
+    return g_heapInUse < HostShim::HEAP_SIZE ? HostShim::HEAP_SIZE - (uint32_t)g_heapInUse : 0;
+}
+uint32_t EspClass::getMaxFreeBlockSize() { return getFreeHeap(); }
+
+bool EspClass::rtcUserMemoryRead(uint32_t offset, uint32_t* data, size_t size) {
+    if (offset * 4 + size > sizeof(g_rtcMemory)) return false;
+    memcpy(data, reinterpret_cast<uint8_t*>(g_rtcMemory) + offset * 4, size);
+    return true;
+}
+
+bool EspClass::rtcUserMemoryWrite(uint32_t offset, uint32_t* data, size_t size) {
+    if (offset * 4 + size > sizeof(g_rtcMemory)) return false;
+    memcpy(reinterpret_cast<uint8_t*>(g_rtcMemory) + offset * 4, data, size);
+    return true;
+}
+
+rst_info* EspClass::getResetInfoPtr() { return &g_resetInfo; }
+uint32_t  EspClass::random() { return nextRandom(); }
+void      EspClass::random(uint8_t* buf, size_t len) { os_get_random(buf, len); }
+
+// ── Controls ─────────────────────────────────────────────────────────────────
+
+namespace HostShim {
+    uint64_t hostNanos() {
+        return (uint64_t)std::chrono::duration_cast<std::chrono::nanoseconds>(
+            HostClock::now() - g_clockStart).count();
+    }
+
+    void freezeClock(bool frozen) {
+        if (frozen == g_clockFrozen) return;
+        if (frozen) {
+            g_frozenHostUs = hostUs() - g_hostUsOffset;
+        } else {
+            g_hostUsOffset = hostUs() - g_frozenHostUs;
+        }
+        g_clockFrozen = frozen;
+    }
+
+    void advanceMicros(uint64_t us) { g_virtualUs += us; }
+
+    void setSerialEcho(bool on) { g_serialEcho = on; }
+
+    size_t heapInUse() { return g_heapInUse; }
+    size_t heapHighWater() { return g_heapHighWater; }
+    void   resetHeapHighWater() { g_heapHighWater = g_heapInUse; }
+
+    uint32_t restartCount() { return g_restarts; }
+    int      pinValue(uint8_t pin) { return digitalRead(pin); }
+}
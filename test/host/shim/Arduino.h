@@ -0,0 +1,248 @@
+#ifndef HOST_ARDUINO_H
+#define HOST_ARDUINO_H
+
+// ════════════════════════════════════════════════════════════════════════
+// Host shim: the slice of the ESP8266 Arduino core the firmware uses
+//
+// Time is a virtual clock: millis()/micros() follow the host's monotonic
+// clock plus whatever delay() has skipped, so a handler that waits 100 ms
+// costs nothing on the host but still shows up in the device's timeline.
+// The heap counters are fed by the operator new/delete overrides in
+// Arduino.cpp.
+// ════════════════════════════════════════════════════════════════════════
+
+#include <stdint.h>
+#include <stddef.h>
+#include <string.h>
+#include <stdlib.h>
+#include <stdio.h>
+#include <stdarg.h>
+#include <ctype.h>
+#include <math.h>
+#include <algorithm>
+#include <string>
+
+#define HIGH 1
+#define LOW  0
+#define INPUT        0x00
+#define OUTPUT       0x01
+#define INPUT_PULLUP 0x02
+
+#define LED_BUILTIN 2
+
+#define SERIAL_8N1     0
+#define SERIAL_TX_ONLY 1
+
+#define PROGMEM
+#define ICACHE_RAM_ATTR
+#define IRAM_ATTR
+#define PSTR(s) (s)
+#define pgm_read_byte(p)  (*(const uint8_t*)(p))
+#define pgm_read_word(p)  (*(const uint16_t*)(p))
+#define pgm_read_dword(p) (*(const uint32_t*)(p))
+#define snprintf_P snprintf
+#define strlen_P   strlen
+#define strcmp_P   strcmp
+#define strncpy_P  strncpy
+#define memcpy_P   memcpy
+
+class __FlashStringHelper;
+#define F(s)     (reinterpret_cast<const __FlashStringHelper*>(PSTR(s)))
+#define FPSTR(s) (reinterpret_cast<const __FlashStringHelper*>(s))
+
+using std::min;
+using std::max;
+
+// ── String ───────────────────────────────────────────────────────────────────
+
+class String {
+public:
+    String(const char* s = "") : _s(s ? s : "") {}
+    String(const char* s, size_t len) : _s(s, len) {}
+    String(const __FlashStringHelper* s) : _s(reinterpret_cast<const char*>(s)) {}
+    String(const std::string& s) : _s(s) {}
+    explicit String(char c) : _s(1, c) {}
+    explicit String(int v)           : _s(std::to_string(v)) {}
+    explicit String(unsigned int v)  : _s(std::to_string(v)) {}
+    explicit String(long v)          : _s(std::to_string(v)) {}
+    explicit String(unsigned long v) : _s(std::to_string(v)) {}
+
+    const char*  c_str()  const { return _s.c_str(); }
+    unsigned int length() const { return (unsigned int)_s.size(); }
+    bool         isEmpty() const { return _s.empty(); }
+
+    bool startsWith(const char* p) const { return _s.compare(0, strlen(p), p) == 0; }
+    bool endsWith(const char* p) const {
+        size_t n = strlen(p);
+        return _s.size() >= n && _s.compare(_s.size() - n, n, p) == 0;
+    }
+    int indexOf(char c) const { size_t i = _s.find(c); return i == std::string::npos ? -1 : (int)i; }
+    String substring(unsigned int from) const { return from >= _s.size() ? String() : String(_s.substr(from)); }
+    String substring(unsigned int from, unsigned int to) const {
+        if (from >= _s.size() || to <= from) return String();
+        return String(_s.substr(from, to - from));
+    }
+    void toLowerCase() { for (char& c : _s) c = (char)tolower((unsigned char)c); }
+    void toUpperCase() { for (char& c : _s) c = (char)toupper((unsigned char)c); }
+    void remove(unsigned int index) { if (index < _s.size()) _s.erase(index); }
+    void remove(unsigned int index, unsigned int count) { if (index < _s.size()) _s.erase(index, count); }
+    void reserve(unsigned int n) { _s.reserve(n); }
+    long toInt() const { return strtol(_s.c_str(), nullptr, 10); }
+    void toCharArray(char* buf, unsigned int size) const {
+        if (!size) return;
+        size_t n = std::min<size_t>(size - 1, _s.size());
+        memcpy(buf, _s.data(), n);
+        buf[n] = '\0';
+    }
+    char operator[](unsigned int i) const { return i < _s.size() ? _s[i] : '\0'; }
+
+    String& operator+=(const String& o)              { _s += o._s; return *this; }
+    String& operator+=(const char* o)                { _s += o; return *this; }
+    String& operator+=(const __FlashStringHelper* o) { _s += reinterpret_cast<const char*>(o); return *this; }
+    String& operator+=(char c)                       { _s += c; return *this; }
+    friend String operator+(String a, const String& b) { a += b; return a; }
+    friend String operator+(String a, const char* b)   { a += b; return a; }
+
+    bool operator==(const String& o) const { return _s == o._s; }
+    bool operator==(const char* o) const   { return _s == o; }
+    bool operator!=(const String& o) const { return _s != o._s; }
+    bool operator!=(const char* o) const   { return _s != o; }
+
+    const std::string& str() const { return _s; }
+
+private:
+    std::string _s;
+};
+
+extern const String emptyString;
+
+// ── Print / Stream ───────────────────────────────────────────────────────────
+
+class Print;
+
+class Printable {
+public:
+    virtual ~Printable() {}
+    virtual size_t printTo(Print& p) const = 0;
+};
+
+class Print {
+public:
+    virtual ~Print() {}
+    virtual size_t write(uint8_t c) = 0;
+    virtual size_t write(const uint8_t* buf, size_t len) {
+        size_t n = 0;
+        while (n < len && write(buf[n])) n++;
+        return n;
+    }
+    size_t write(const char* s) { return s ? write(reinterpret_cast<const uint8_t*>(s), strlen(s)) : 0; }
+    size_t write(const char* s, size_t len) { return write(reinterpret_cast<const uint8_t*>(s), len); }
+
+    size_t print(const char* s)                { return write(s); }
+    size_t print(const __FlashStringHelper* s) { return write(reinterpret_cast<const char*>(s)); }
+    size_t print(const String& s)              { return write(s.c_str(), s.length()); }
+    size_t print(char c)                       { return write((uint8_t)c); }
+    size_t print(bool v)                       { return printNumber((unsigned long)v); }
+    size_t print(int v)                        { return printNumber((long)v); }
+    size_t print(unsigned int v)               { return printNumber((unsigned long)v); }
+    size_t print(long v)                       { return printNumber(v); }
+    size_t print(unsigned long v)              { return printNumber(v); }
+    size_t print(long long v)                  { return printf("%lld", v); }
+    size_t print(unsigned long long v)         { return printf("%llu", v); }
+    size_t print(double v)                     { return printf("%.2f", v); }
+    size_t print(const Printable& p)           { return p.printTo(*this); }
+
+    template<typename T>
+    size_t println(const T& v) { return print(v) + println(); }
+    size_t println() { return write("\r\n"); }
+
+    size_t printf(const char* fmt, ...) __attribute__((format(printf, 2, 3))) {
+        char buf[256];
+        va_list ap;
+        va_start(ap, fmt);
+        int n = vsnprintf(buf, sizeof(buf), fmt, ap);
+        va_end(ap);
+        if (n <= 0) return 0;
+        return write(buf, std::min<size_t>((size_t)n, sizeof(buf) - 1));
+    }
+    void flush() {}
+
+private:
+    size_t printNumber(long v)          { return printf("%ld", v); }
+    size_t printNumber(unsigned long v) { return printf("%lu", v); }
+};
+
+class Stream : public Print {
+public:
+    virtual int available() { return 0; }
+    virtual int read() { return -1; }
+    virtual int peek() { return -1; }
+    size_t readBytes(char* buf, size_t len) {
+        size_t n = 0;
+        int c;
+        while (n < len && (c = read()) >= 0) buf[n++] = (char)c;
+        return n;
+    }
+    size_t readBytes(uint8_t* buf, size_t len) { return readBytes(reinterpret_cast<char*>(buf), len); }
+};
+
+/** Serial port: output is discarded unless HostShim::setSerialEcho(true). */
+class HardwareSerial : public Stream {
+public:
+    void begin(unsigned long, int = 0, int = 0) {}
+    size_t write(uint8_t c) override;
+    size_t write(const uint8_t* buf, size_t len) override;
+    using Print::write;
+};
+extern HardwareSerial Serial;
+
+// ── Core functions ───────────────────────────────────────────────────────────
+
+unsigned long millis();
+unsigned long micros();
+void delay(unsigned long ms);
+void delayMicroseconds(unsigned int us);
+void yield();
+
+void pinMode(uint8_t pin, uint8_t mode);
+void digitalWrite(uint8_t pin, uint8_t value);
+int  digitalRead(uint8_t pin);
+
+long random(long max);
+long random(long min, long max);
+void randomSeed(unsigned long seed);
+
+extern "C" uint32_t os_random();
+extern "C" int      os_get_random(unsigned char* buf, size_t len);
+
+// ── ESP class ────────────────────────────────────────────────────────────────
+
+struct rst_info {
+    uint32_t reason;
+};
+
+enum rst_reason {
+    REASON_DEFAULT_RST      = 0,
+    REASON_WDT_RST          = 1,
+    REASON_EXCEPTION_RST    = 2,
+    REASON_SOFT_WDT_RST     = 3,
+    REASON_SOFT_RESTART     = 4,
+    REASON_DEEP_SLEEP_AWAKE = 5,
+    REASON_EXT_SYS_RST      = 6,
+};
+
+class EspClass {
+public:
+    void     restart();
+    uint32_t getChipId();
+    uint32_t getFreeHeap();
+    uint32_t getMaxFreeBlockSize();
+    bool     rtcUserMemoryRead(uint32_t offset, uint32_t* data, size_t size);
+    bool     rtcUserMemoryWrite(uint32_t offset, uint32_t* data, size_t size);
+    rst_info* getResetInfoPtr();
+    uint32_t random();
+    void     random(uint8_t* buf, size_t len);
+};
+extern EspClass ESP;
+
+#endif // HOST_ARDUINO_H
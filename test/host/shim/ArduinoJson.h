@@ -0,0 +1,65 @@
+#ifndef HOST_ARDUINOJSON_H
+#define HOST_ARDUINOJSON_H
+
+// Text-preserving stand-in for ArduinoJson: a JsonDocument holds its JSON
+// text.  deserializeJson() pulls from a custom reader with readBytes() and
+// checks the brackets and quotes balance; serializeJson() pushes the text to
+// a custom writer.  Enough to exercise the firmware's reader/writer
+// adapters, not a JSON library.
+
+#include <Arduino.h>
+#include <string>
+
+class DeserializationError {
+public:
+    enum Code { Ok, EmptyInput, IncompleteInput, InvalidInput, NoMemory, TooDeep };
+    DeserializationError(Code c = Ok) : _code(c) {}
+    Code code() const { return _code; }
+    explicit operator bool() const { return _code != Ok; }
+    bool operator==(Code c) const { return _code == c; }
+    bool operator!=(Code c) const { return _code != c; }
+
+private:
+    Code _code;
+};
+
+class JsonDocument {
+public:
+    JsonDocument() {}
+    explicit JsonDocument(const std::string& text) : _text(text) {}
+
+    const std::string& text() const { return _text; }
+    void set(const std::string& text) { _text = text; }
+    void clear() { _text.clear(); }
+
+private:
+    std::string _text;
+};
+
+namespace ArduinoJsonShim {
+    /** @return Ok if @p text is a bracket/quote-balanced object or array. */
+    DeserializationError::Code check(const std::string& text);
+}
+
+template<typename TReader>
+DeserializationError deserializeJson(JsonDocument& doc, TReader& reader) {
+    std::string text;
+    char block[37];  // odd size, so reads straddle the reader's block edges
+    size_t n;
+    while ((n = reader.readBytes(block, sizeof(block))) > 0) text.append(block, n);
+    DeserializationError::Code code = ArduinoJsonShim::check(text);
+    if (code == DeserializationError::Ok) doc.set(text);
+    return DeserializationError(code);
+}
+
+template<typename TWriter>
+size_t serializeJson(const JsonDocument& doc, TWriter& writer) {
+    const std::string& text = doc.text();
+    if (text.empty()) return 0;
+    // One byte first, then the rest in bulk — ArduinoJson uses both calls
+    size_t n = writer.write((uint8_t)text[0]);
+    if (n == 1) n += writer.write(reinterpret_cast<const uint8_t*>(text.data()) + 1, text.size() - 1);
+    return n;
+}
+
+#endif // HOST_ARDUINOJSON_H
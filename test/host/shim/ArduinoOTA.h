@@ -0,0 +1,33 @@
+#ifndef HOST_ARDUINOOTA_H
+#define HOST_ARDUINOOTA_H
+
+#include <Arduino.h>
+#include <functional>
+
+typedef enum {
+    OTA_AUTH_ERROR,
+    OTA_BEGIN_ERROR,
+    OTA_CONNECT_ERROR,
+    OTA_RECEIVE_ERROR,
+    OTA_END_ERROR
+} ota_error_t;
+
+class ArduinoOTAClass {
+public:
+    void onStart(std::function<void()> fn) { _onStart = fn; }
+    void onEnd(std::function<void()> fn) { _onEnd = fn; }
+    void onProgress(std::function<void(unsigned int, unsigned int)> fn) { _onProgress = fn; }
+    void onError(std::function<void(ota_error_t)> fn) { _onError = fn; }
+    void setPort(uint16_t) {}
+    void begin() {}
+    void handle() {}
+
+private:
+    std::function<void()>                         _onStart;
+    std::function<void()>                         _onEnd;
+    std::function<void(unsigned int, unsigned int)> _onProgress;
+    std::function<void(ota_error_t)>              _onError;
+};
+extern ArduinoOTAClass ArduinoOTA;
+
+#endif // HOST_ARDUINOOTA_H
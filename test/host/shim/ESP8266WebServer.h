@@ -0,0 +1,120 @@
+#ifndef HOST_ESP8266WEBSERVER_H
+#define HOST_ESP8266WEBSERVER_H
+
+// ════════════════════════════════════════════════════════════════════════
+// Loopback ESP8266WebServer
+//
+// Requests are queued with enqueue() and dispatched from handleClient(), so
+// they reach the routes through the sketch's own loop().  Dispatch follows
+// the ESP8266 core: first route whose URI and method match, raw bodies
+// delivered to routes with an upload handler in HTTP_RAW_BUFLEN chunks
+// (only the last chunk stays in raw().buf), other bodies in arg("plain"),
+// and header slot 0 reserved for Authorization.
+// ════════════════════════════════════════════════════════════════════════
+
+#include <ESP8266WiFi.h>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+enum HTTPMethod { HTTP_ANY, HTTP_GET, HTTP_HEAD, HTTP_POST, HTTP_PUT, HTTP_PATCH, HTTP_DELETE, HTTP_OPTIONS };
+
+#define HTTP_RAW_BUFLEN 1436
+#define CONTENT_LENGTH_UNKNOWN ((size_t)-1)
+
+enum HTTPRawStatus { RAW_START, RAW_WRITE, RAW_END, RAW_ABORTED };
+
+struct HTTPRaw {
+    HTTPRawStatus status;
+    size_t        totalSize;    // bytes received so far
+    size_t        currentSize;  // bytes in buf (this chunk)
+    uint8_t       buf[HTTP_RAW_BUFLEN];
+    void*         data;
+};
+
+/** One request for the loopback server. */
+struct HostRequest {
+    HTTPMethod  method = HTTP_GET;
+    std::string uri;                                          // path, optional ?query
+    std::vector<std::pair<std::string, std::string>> headers;
+    std::string body;
+    uint32_t    remoteIp = 0x0A01A8C0;                        // 192.168.1.10
+};
+
+class ESP8266WebServer {
+public:
+    typedef std::function<void(void)> THandlerFunction;
+
+    explicit ESP8266WebServer(int port = 80) : _port(port) {}
+
+    void on(const char* uri, HTTPMethod method, THandlerFunction fn);
+    void on(const char* uri, HTTPMethod method, THandlerFunction fn, THandlerFunction ufn);
+    void onNotFound(THandlerFunction fn) { _notFound = fn; }
+    void collectHeaders(const char* keys[], size_t count);
+
+    void begin() {}
+    void handleClient();
+
+    // Current request
+    HTTPMethod    method() const { return _method; }
+    const String& uri() const { return _uri; }
+    bool          hasArg(const char* name) const;
+    const String& arg(const char* name) const;
+    bool          hasHeader(const char* name) const;
+    const String& header(const char* name) const;
+    const String& header(int i) const;
+    size_t        clientContentLength() const { return _contentLength; }
+    HTTPRaw&      raw() { return _raw; }
+    WiFiClient&   client() { return _client; }
+
+    // Response
+    void sendHeader(const String& name, const String& value, bool first = false);
+    void setContentLength(size_t len) { _responseLength = len; }
+    void send(int code, const char* contentType = nullptr, const String& content = String());
+    void send(int code, const __FlashStringHelper* contentType, const String& content) {
+        send(code, reinterpret_cast<const char*>(contentType), content);
+    }
+    void sendContent(const String& content) { sendContent(content.c_str(), content.length()); }
+    void sendContent(const char* content) { sendContent(content, strlen(content)); }
+    void sendContent(const char* content, size_t len);
+
+    // ── Host side ────────────────────────────────────────────────────────
+    /** Queue @p req; its response accumulates in the returned connection. */
+    std::shared_ptr<HostConnection> enqueue(HostRequest req);
+    size_t pending() const { return _queue.size(); }
+
+private:
+    struct Route {
+        std::string      uri;
+        HTTPMethod       method;
+        THandlerFunction fn;
+        THandlerFunction ufn;
+    };
+    struct Pending {
+        HostRequest                     req;
+        std::shared_ptr<HostConnection> conn;
+    };
+
+    void dispatch(Pending& p);
+
+    int                      _port;
+    std::vector<Route>       _routes;
+    THandlerFunction         _notFound;
+    std::vector<std::string> _headerKeys { "Authorization" };
+    std::deque<Pending>      _queue;
+
+    HTTPMethod _method = HTTP_GET;
+    String     _uri;
+    std::vector<std::pair<String, String>> _args;
+    std::vector<String>      _headerValues;
+    size_t                   _contentLength = 0;
+    HTTPRaw                  _raw {};
+    WiFiClient               _client;
+    std::string              _responseHeaders;
+    size_t                   _responseLength = CONTENT_LENGTH_UNKNOWN;
+};
+
+#endif // HOST_ESP8266WEBSERVER_H
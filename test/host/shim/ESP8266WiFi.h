@@ -0,0 +1,100 @@
+#ifndef HOST_ESP8266WIFI_H
+#define HOST_ESP8266WIFI_H
+
+#include <Arduino.h>
+#include <IPAddress.h>
+#include <functional>
+#include <memory>
+#include <string>
+
+// ── Client connection ────────────────────────────────────────────────────────
+// Everything the firmware writes to a client lands in `out`; copies of a
+// WiFiClient share the connection, as on the device.
+struct HostConnection {
+    std::string out;
+    bool        open       = true;
+    bool        noDelay    = false;
+    uint32_t    remoteIp   = 0;
+    uint32_t    writes     = 0;
+    uint64_t    lastByteNs = 0;  // HostShim::hostNanos() of the last write
+};
+
+class WiFiClient : public Stream {
+public:
+    WiFiClient() {}
+    explicit WiFiClient(std::shared_ptr<HostConnection> conn) : _conn(std::move(conn)) {}
+
+    size_t write(uint8_t c) override { return write(&c, 1); }
+    size_t write(const uint8_t* buf, size_t len) override;
+    using Print::write;
+
+    uint8_t  connected() { return _conn && _conn->open; }
+    void     stop()      { if (_conn) _conn->open = false; }
+    void     setNoDelay(bool on) { if (_conn) _conn->noDelay = on; }
+    int      availableForWrite() { return 1460; }
+    IPAddress remoteIP() const { return IPAddress(_conn ? _conn->remoteIp : 0); }
+    uint16_t remotePort() const { return 40000; }
+    explicit operator bool() const { return (bool)_conn; }
+
+private:
+    std::shared_ptr<HostConnection> _conn;
+};
+
+// ── WiFi ─────────────────────────────────────────────────────────────────────
+
+typedef int WiFiMode_t;
+enum { WIFI_OFF = 0, WIFI_STA = 1, WIFI_AP = 2, WIFI_AP_STA = 3 };
+enum { WL_IDLE_STATUS = 0, WL_NO_SSID_AVAIL = 1, WL_CONNECTED = 3, WL_DISCONNECTED = 6 };
+enum WiFiSleepType_t { WIFI_NONE_SLEEP = 0, WIFI_LIGHT_SLEEP = 1, WIFI_MODEM_SLEEP = 2 };
+enum { ENC_TYPE_WEP = 5, ENC_TYPE_TKIP = 2, ENC_TYPE_CCMP = 4, ENC_TYPE_NONE = 7, ENC_TYPE_AUTO = 8 };
+
+#define WIFI_SCAN_RUNNING (-1)
+#define WIFI_SCAN_FAILED  (-2)
+
+struct WiFiEventStationModeGotIP        { IPAddress ip; };
+struct WiFiEventStationModeDisconnected { uint8_t reason; };
+
+struct WiFiEventHandlerOpaque {};
+typedef std::shared_ptr<WiFiEventHandlerOpaque> WiFiEventHandler;
+
+struct DhcpServer {
+    void setDns(IPAddress) {}
+};
+
+class ESP8266WiFiClass {
+public:
+    String    macAddress();
+    bool      mode(WiFiMode_t m) { _mode = m; return true; }
+    WiFiMode_t getMode() { return _mode; }
+    int       begin(const char* ssid, const char* psk);
+    int       status() { return WL_CONNECTED; }
+    IPAddress localIP()  { return IPAddress(192, 168, 1, 50); }
+    IPAddress softAPIP() { return IPAddress(192, 168, 4, 1); }
+    IPAddress dnsIP(int = 0) { return IPAddress(192, 168, 1, 1); }
+    bool      softAP(const char*, const char* = nullptr, int = 1, int = 0, int = 4) { return true; }
+    bool      softAPConfig(IPAddress, IPAddress, IPAddress) { return true; }
+    DhcpServer& softAPDhcpServer() { return _dhcp; }
+    bool      setSleepMode(WiFiSleepType_t type) { _sleep = type; return true; }
+
+    // Scans finish one scanComplete() poll after they start
+    int8_t    scanNetworks(bool async = false, bool showHidden = false);
+    int8_t    scanComplete();
+    void      scanDelete() { _scanState = 0; }
+    String    SSID(uint8_t i);
+    uint8_t*  BSSID(uint8_t i);
+    int32_t   RSSI(uint8_t i) { return -40 - 7 * i; }
+    uint8_t   encryptionType(uint8_t i) { return i == 0 ? ENC_TYPE_CCMP : ENC_TYPE_NONE; }
+
+    WiFiEventHandler onStationModeGotIP(std::function<void(const WiFiEventStationModeGotIP&)>);
+    WiFiEventHandler onStationModeDisconnected(std::function<void(const WiFiEventStationModeDisconnected&)>);
+
+private:
+    WiFiMode_t      _mode  = WIFI_OFF;
+    WiFiSleepType_t _sleep = WIFI_NONE_SLEEP;
+    DhcpServer      _dhcp;
+    int             _scanState = 0;  // 0 idle, 1 running, 2 done
+    uint8_t         _bssid[6]  = { 0x02, 0x00, 0x00, 0x00, 0x00, 0x00 };
+};
+extern ESP8266WiFiClass WiFi;
+
+#endif // HOST_ESP8266WIFI_H
@@ -0,0 +1,16 @@
+#ifndef HOST_ESP8266MDNS_H
+#define HOST_ESP8266MDNS_H
+
+#include <Arduino.h>
+
+class MDNSResponder {
+public:
+    bool begin(const char*) { return true; }
+    bool end() { return true; }
+    bool addService(const char*, const char*, uint16_t) { return true; }
+    void announce() {}
+    bool update() { return true; }
+};
+extern MDNSResponder MDNS;
+
+#endif // HOST_ESP8266MDNS_H
@@ -0,0 +1,44 @@
+#ifndef HOST_SHIM_H
+#define HOST_SHIM_H
+
+// ════════════════════════════════════════════════════════════════════════
+// Controls the host tests use to drive the shimmed core
+// ════════════════════════════════════════════════════════════════════════
+
+#include <stdint.h>
+#include <stddef.h>
+
+namespace HostShim {
+    // ── Clock ─────────────────────────────────────────────────────────────
+    /** Stop (or restart) the host-clock part of millis()/micros(). */
+    void freezeClock(bool frozen);
+    /** Move the virtual clock forward, as if the device had been busy. */
+    void advanceMicros(uint64_t us);
+    /** Host monotonic time in nanoseconds (for measuring the shims themselves). */
+    uint64_t hostNanos();
+
+    // ── Serial ────────────────────────────────────────────────────────────
+    void setSerialEcho(bool on);
+
+    // ── Heap accounting (operator new/delete) ─────────────────────────────
+    /** Simulated heap size behind ESP.getFreeHeap(). */
+    constexpr uint32_t HEAP_SIZE = 52 * 1024;
+    size_t heapInUse();
+    size_t heapHighWater();
+    void   resetHeapHighWater();
+
+    // ── Device state ──────────────────────────────────────────────────────
+    /** Number of ESP.restart() calls since start. */
+    uint32_t restartCount();
+    int      pinValue(uint8_t pin);
+
+    // ── Flash ─────────────────────────────────────────────────────────────
+    /** Drop every file, as if the flash were erased. */
+    void eraseFlash();
+    /** Let @p bytes more be written, then fail writes short (-1 = never fail). */
+    void failWritesAfter(long bytes);
+    /** Bytes written to flash since start. */
+    uint64_t flashBytesWritten();
+}
+
+#endif // HOST_SHIM_H
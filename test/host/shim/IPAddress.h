@@ -0,0 +1,28 @@
+#ifndef HOST_IPADDRESS_H
+#define HOST_IPADDRESS_H
+
+#include <Arduino.h>
+
+class IPAddress : public Printable {
+public:
+    IPAddress() : _addr(0) {}
+    IPAddress(uint32_t addr) : _addr(addr) {}
+    IPAddress(uint8_t a, uint8_t b, uint8_t c, uint8_t d)
+        : _addr((uint32_t)a | ((uint32_t)b << 8) | ((uint32_t)c << 16) | ((uint32_t)d << 24)) {}
+
+    operator uint32_t() const { return _addr; }
+    uint8_t operator[](int i) const { return (uint8_t)(_addr >> (8 * i)); }
+
+    String toString() const {
+        char buf[16];
+        snprintf(buf, sizeof(buf), "%u.%u.%u.%u", (*this)[0], (*this)[1], (*this)[2], (*this)[3]);
+        return String(buf);
+    }
+
+    size_t printTo(Print& p) const override { return p.print(toString()); }
+
+private:
+    uint32_t _addr;  // network order, as on the device
+};
+
+#endif // HOST_IPADDRESS_H
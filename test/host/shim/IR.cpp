@@ -0,0 +1,81 @@
+#include <IRrecv.h>
+#include <IRsend.h>
+#include <IRutils.h>
+
+std::deque<decode_results> IRrecv::_pending;
+uint32_t IRsend::_sends      = 0;
+uint32_t IRsend::_rawTimings = 0;
+
+namespace {
+struct ProtocolName {
+    decode_type_t type;
+    const char*   name;
+    bool          acState;
+};
+
+const ProtocolName kProtocols[] = {
+    { NEC,           "NEC",           false },
+    { SONY,          "SONY",          false },
+    { SAMSUNG,       "SAMSUNG",       false },
+    { DAIKIN,        "DAIKIN",        true  },
+    { MITSUBISHI_AC, "MITSUBISHI_AC", true  },
+};
+} // namespace
+
+bool IRrecv::decode(decode_results* results) {
+    if (!_enabled || _pending.empty()) return false;
+    *results = _pending.front();
+    _pending.pop_front();
+    return true;
+}
+
+void IRsend::sendRaw(const uint16_t[], const uint16_t len, const uint16_t) {
+    _sends++;
+    _rawTimings += len;
+}
+
+bool IRsend::send(const decode_type_t type, const uint64_t, const uint16_t, const uint16_t) {
+    _sends++;
+    return !hasACState(type) && type > UNUSED;
+}
+
+bool IRsend::send(const decode_type_t type, const uint8_t*, const uint16_t) {
+    _sends++;
+    return hasACState(type);
+}
+
+String typeToString(const decode_type_t protocol, const bool) {
+    for (const ProtocolName& p : kProtocols) {
+        if (p.type == protocol) return String(p.name);
+    }
+    return String("UNKNOWN");
+}
+
+decode_type_t strToDecodeType(const char* str) {
+    for (const ProtocolName& p : kProtocols) {
+        if (strcmp(p.name, str) == 0) return p.type;
+    }
+    return UNKNOWN;
+}
+
+bool hasACState(const decode_type_t protocol) {
+    for (const ProtocolName& p : kProtocols) {
+        if (p.type == protocol) return p.acState;
+    }
+    return false;
+}
+
+uint16_t getCorrectedRawLength(const decode_results* results) {
+    uint16_t extended = 0;
+    for (uint16_t i = 1; i < results->rawlen; i++) {
+        uint32_t usecs = results->rawbuf[i] * kRawTick;
+        extended += usecs / (UINT16_MAX + 1);  // each overflow adds a 65535,0 pair
+    }
+    return results->rawlen - 1 + extended * 2;
+}
+
+String uint64ToString(uint64_t input, uint8_t base) {
+    char buf[24];
+    snprintf(buf, sizeof(buf), base == 16 ? "%llX" : "%llu", (unsigned long long)input);
+    return String(buf);
+}
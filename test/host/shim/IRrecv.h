@@ -0,0 +1,41 @@
+#ifndef HOST_IRRECV_H
+#define HOST_IRRECV_H
+
+#include <Arduino.h>
+#include <IRremoteESP8266.h>
+#include <deque>
+
+const uint16_t kStateSizeMax = 53;
+
+struct decode_results {
+    decode_type_t      decode_type;
+    uint64_t           value;
+    uint32_t           address;
+    uint32_t           command;
+    uint16_t           bits;
+    volatile uint16_t* rawbuf;
+    uint16_t           rawlen;
+    bool               overflow;
+    bool               repeat;
+    uint8_t            state[kStateSizeMax];
+};
+
+/** Receiver: decode() hands out the captures queued with hostInject(). */
+class IRrecv {
+public:
+    IRrecv(uint16_t, uint16_t = 100, uint8_t = 15, bool = false) {}
+    void enableIRIn(bool = false) { _enabled = true; }
+    void disableIRIn() { _enabled = false; }
+    void resume() {}
+    void setUnknownThreshold(uint16_t) {}
+    bool decode(decode_results* results);
+
+    /** Queue a capture; its rawbuf must outlive the decode. */
+    static void hostInject(const decode_results& results) { _pending.push_back(results); }
+
+private:
+    bool _enabled = false;
+    static std::deque<decode_results> _pending;
+};
+
+#endif // HOST_IRRECV_H
@@ -0,0 +1,21 @@
+#ifndef HOST_IRREMOTEESP8266_H
+#define HOST_IRREMOTEESP8266_H
+
+#include <stdint.h>
+
+// A few protocols from IRremoteESP8266, with their library values: three
+// plain value protocols and two AC protocols that carry a state array.
+enum decode_type_t {
+    UNKNOWN       = -1,
+    UNUSED        = 0,
+    NEC           = 3,
+    SONY          = 4,
+    SAMSUNG       = 7,
+    DAIKIN        = 16,
+    MITSUBISHI_AC = 20,
+    kLastDecodeType = 127,
+};
+
+const uint16_t kRawTick = 2;  // µs per rawbuf unit
+
+#endif // HOST_IRREMOTEESP8266_H
@@ -0,0 +1,25 @@
+#ifndef HOST_IRSEND_H
+#define HOST_IRSEND_H
+
+#include <Arduino.h>
+#include <IRremoteESP8266.h>
+
+/** Transmitter: counts what would have been sent. */
+class IRsend {
+public:
+    explicit IRsend(uint16_t, bool = false, bool = true) {}
+    void begin() {}
+    void enableIROut(uint32_t, uint8_t = 50) {}
+    void sendRaw(const uint16_t buf[], const uint16_t len, const uint16_t hz);
+    bool send(const decode_type_t type, const uint64_t data, const uint16_t nbits, const uint16_t repeat = 0);
+    bool send(const decode_type_t type, const uint8_t* state, const uint16_t nbytes);
+
+    static uint32_t hostSendCount() { return _sends; }
+    static uint32_t hostRawTimings() { return _rawTimings; }
+
+private:
+    static uint32_t _sends;
+    static uint32_t _rawTimings;
+};
+
+#endif // HOST_IRSEND_H
@@ -0,0 +1,4 @@
+#ifndef HOST_IRTEXT_H
+#define HOST_IRTEXT_H
+
+#endif // HOST_IRTEXT_H
@@ -0,0 +1,13 @@
+#ifndef HOST_IRUTILS_H
+#define HOST_IRUTILS_H
+
+#include <Arduino.h>
+#include <IRrecv.h>
+
+String        typeToString(const decode_type_t protocol, const bool isRepeat = false);
+decode_type_t strToDecodeType(const char* str);
+bool          hasACState(const decode_type_t protocol);
+uint16_t      getCorrectedRawLength(const decode_results* results);
+String        uint64ToString(uint64_t input, uint8_t base = 10);
+
+#endif // HOST_IRUTILS_H
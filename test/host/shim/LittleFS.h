@@ -0,0 +1,65 @@
+#ifndef HOST_LITTLEFS_H
+#define HOST_LITTLEFS_H
+
+// In-memory LittleFS: one byte string per path.  Open files share the
+// string, so a rename or remove behaves like it does on flash for handles
+// that are already closed.
+
+#include <Arduino.h>
+#include <map>
+#include <memory>
+#include <string>
+
+enum SeekMode { SeekSet = 0, SeekCur = 1, SeekEnd = 2 };
+
+class File : public Stream {
+public:
+    File() {}
+    File(std::shared_ptr<std::string> data, bool readable, bool writable, bool append)
+        : _data(std::move(data)), _readable(readable), _writable(writable), _append(append) {}
+
+    explicit operator bool() const { return (bool)_data; }
+
+    size_t size() const { return _data ? _data->size() : 0; }
+    size_t position() const { return _pos; }
+    bool   seek(uint32_t pos, SeekMode mode = SeekSet);
+
+    int    available() override { return _data ? (int)(_data->size() - _pos) : 0; }
+    int    read() override;
+    int    peek() override;
+    size_t read(uint8_t* buf, size_t len);
+    size_t write(uint8_t c) override { return write(&c, 1); }
+    size_t write(const uint8_t* buf, size_t len) override;
+    using Print::write;
+
+    bool truncate(uint32_t size);
+    void flush() {}
+    void close() { _data.reset(); _pos = 0; }
+
+private:
+    std::shared_ptr<std::string> _data;
+    size_t _pos      = 0;
+    bool   _readable = false;
+    bool   _writable = false;
+    bool   _append   = false;
+};
+
+class FS {
+public:
+    bool begin() { return true; }
+    bool begin(bool) { return true; }
+    void end() {}
+    bool format();
+    File open(const char* path, const char* mode);
+    bool exists(const char* path) const { return _files.count(path) != 0; }
+    bool remove(const char* path) { return _files.erase(path) != 0; }
+    bool rename(const char* from, const char* to);
+
+    const std::map<std::string, std::shared_ptr<std::string>>& files() const { return _files; }
+
+private:
+    std::map<std::string, std::shared_ptr<std::string>> _files;
+};
+extern FS LittleFS;
+
+#endif // HOST_LITTLEFS_H
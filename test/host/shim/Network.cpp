@@ -0,0 +1,238 @@
+#include <ESP8266WiFi.h>
+#include <ESP8266WebServer.h>
+#include "HostShim.h"
+
+#include <strings.h>
+
+ESP8266WiFiClass WiFi;
+
+// ── WiFiClient ───────────────────────────────────────────────────────────────
+
+size_t WiFiClient::write(const uint8_t* buf, size_t len) {
+    if (!_conn || !_conn->open) return 0;
+    _conn->out.append(reinterpret_cast<const char*>(buf), len);
+    _conn->writes++;
+    _conn->lastByteNs = HostShim::hostNanos();
+    return len;
+}
+
+// ── WiFi ─────────────────────────────────────────────────────────────────────
+
+String ESP8266WiFiClass::macAddress() {
+    return String("5C:CF:7F:C0:FF:EE");
+}
+
+int ESP8266WiFiClass::begin(const char*, const char*) {
+    if (_mode == WIFI_OFF) _mode = WIFI_STA;
+    return WL_CONNECTED;
+}
+
+int8_t ESP8266WiFiClass::scanNetworks(bool async, bool) {
+    _scanState = async ? 1 : 2;
+    return async ? WIFI_SCAN_RUNNING : 3;
+}
+
+int8_t ESP8266WiFiClass::scanComplete() {
+    if (_scanState == 0) return WIFI_SCAN_FAILED;
+    if (_scanState == 1) {
+        _scanState = 2;
+        return WIFI_SCAN_RUNNING;
+    }
+    return 3;
+}
+
+String ESP8266WiFiClass::SSID(uint8_t i) {
+    char ssid[16];
+    snprintf(ssid, sizeof(ssid), "HostNet%u", (unsigned)i);
+    return String(ssid);
+}
+
+uint8_t* ESP8266WiFiClass::BSSID(uint8_t i) {
+    _bssid[5] = i;
+    return _bssid;
+}
+
+WiFiEventHandler ESP8266WiFiClass::onStationModeGotIP(std::function<void(const WiFiEventStationModeGotIP&)>) {
+    return std::make_shared<WiFiEventHandlerOpaque>();
+}
+
+WiFiEventHandler ESP8266WiFiClass::onStationModeDisconnected(std::function<void(const WiFiEventStationModeDisconnected&)>) {
+    return std::make_shared<WiFiEventHandlerOpaque>();
+}
+
+// ── ESP8266WebServer ─────────────────────────────────────────────────────────
+
+namespace {
+const char* reasonPhrase(int code) {
+    switch (code) {
+        case 200: return "OK";
+        case 204: return "No Content";
+        case 400: return "Bad Request";
+        case 401: return "Unauthorized";
+        case 404: return "Not Found";
+        default:  return "";
+    }
+}
+} // namespace
+
+void ESP8266WebServer::on(const char* uri, HTTPMethod method, THandlerFunction fn) {
+    _routes.push_back({ uri, method, fn, nullptr });
+}
+
+void ESP8266WebServer::on(const char* uri, HTTPMethod method, THandlerFunction fn, THandlerFunction ufn) {
+    _routes.push_back({ uri, method, fn, ufn });
+}
+
+void ESP8266WebServer::collectHeaders(const char* keys[], size_t count) {
+    // Slot 0 stays Authorization, as in the core
+    _headerKeys.resize(1);
+    for (size_t i = 0; i < count; i++) _headerKeys.push_back(keys[i]);
+}
+
+std::shared_ptr<HostConnection> ESP8266WebServer::enqueue(HostRequest req) {
+    auto conn = std::make_shared<HostConnection>();
+    conn->remoteIp = req.remoteIp;
+    _queue.push_back({ std::move(req), conn });
+    return conn;
+}
+
+void ESP8266WebServer::handleClient() {
+    if (_queue.empty()) return;
+    Pending p = std::move(_queue.front());
+    _queue.pop_front();
+    dispatch(p);
+}
+
+void ESP8266WebServer::dispatch(Pending& p) {
+    const HostRequest& req = p.req;
+
+    // Path and query
+    size_t q = req.uri.find('?');
+    _uri = String(req.uri.substr(0, q));
+    _args.clear();
+    if (q != std::string::npos) {
+        std::string query = req.uri.substr(q + 1);
+        size_t start = 0;
+        while (start <= query.size()) {
+            size_t amp = query.find('&', start);
+            if (amp == std::string::npos) amp = query.size();
+            std::string kv = query.substr(start, amp - start);
+            size_t eq = kv.find('=');
+            if (!kv.empty()) {
+                _args.push_back({ String(kv.substr(0, eq)),
+                                  String(eq == std::string::npos ? std::string() : kv.substr(eq + 1)) });
+            }
+            start = amp + 1;
+        }
+    }
+
+    _method = req.method;
+    _headerValues.assign(_headerKeys.size(), String());
+    for (size_t i = 0; i < _headerKeys.size(); i++) {
+        for (const auto& h : req.headers) {
+            if (strcasecmp(h.first.c_str(), _headerKeys[i].c_str()) == 0) _headerValues[i] = String(h.second);
+        }
+    }
+
+    _contentLength   = req.body.size();
+    _responseHeaders.clear();
+    _responseLength  = CONTENT_LENGTH_UNKNOWN;
+    _client          = WiFiClient(p.conn);
+    memset(&_raw, 0, sizeof(_raw));
+
+    const Route* route = nullptr;
+    for (const Route& r : _routes) {
+        if (r.uri == _uri.str() && (r.method == HTTP_ANY || r.method == _method)) {
+            route = &r;
+            break;
+        }
+    }
+
+    if (!req.body.empty()) {
+        if (route && route->ufn) {
+            _raw.status = RAW_START;
+            route->ufn();
+            for (size_t off = 0; off < req.body.size(); off += HTTP_RAW_BUFLEN) {
+                size_t n = std::min<size_t>(HTTP_RAW_BUFLEN, req.body.size() - off);
+                memcpy(_raw.buf, req.body.data() + off, n);
+                _raw.currentSize = n;
+                _raw.totalSize  += n;
+                _raw.status      = RAW_WRITE;
+                route->ufn();
+            }
+            _raw.status = RAW_END;
+            route->ufn();
+        } else {
+            _args.push_back({ String("plain"), String(req.body) });
+        }
+    }
+
+    if (route) {
+        route->fn();
+    } else if (_notFound) {
+        _notFound();
+    } else {
+        send(404, "text/plain", String("Not found"));
+    }
+
+    // The server lets go of the client; a handler that kept a copy (IR
+    // capture) keeps the connection open.
+    _client = WiFiClient();
+}
+
+bool ESP8266WebServer::hasArg(const char* name) const {
+    for (const auto& a : _args) {
+        if (a.first == name) return true;
+    }
+    return false;
+}
+
+const String& ESP8266WebServer::arg(const char* name) const {
+    for (const auto& a : _args) {
+        if (a.first == name) return a.second;
+    }
+    return emptyString;
+}
+
+bool ESP8266WebServer::hasHeader(const char* name) const {
+    for (size_t i = 0; i < _headerKeys.size(); i++) {
+        if (strcasecmp(_headerKeys[i].c_str(), name) == 0) return _headerValues[i].length() > 0;
+    }
+    return false;
+}
+
+const String& ESP8266WebServer::header(const char* name) const {
+    for (size_t i = 0; i < _headerKeys.size(); i++) {
+        if (strcasecmp(_headerKeys[i].c_str(), name) == 0) return _headerValues[i];
+    }
+    return emptyString;
+}
+
+const String& ESP8266WebServer::header(int i) const {
+    if (i < 0 || (size_t)i >= _headerValues.size()) return emptyString;
+    return _headerValues[i];
+}
+
+void ESP8266WebServer::sendHeader(const String& name, const String& value, bool first) {
+    std::string line = name.str() + ": " + value.str() + "\r\n";
+    if (first) {
+        _responseHeaders.insert(0, line);
+    } else {
+        _responseHeaders += line;
+    }
+}
+
+void ESP8266WebServer::send(int code, const char* contentType, const String& content) {
+    size_t len = (_responseLength != CONTENT_LENGTH_UNKNOWN) ? _responseLength : content.length();
+    std::string head = "HTTP/1.1 " + std::to_string(code) + " " + reasonPhrase(code) + "\r\n";
+    if (contentType) head += std::string("Content-Type: ") + contentType + "\r\n";
+    head += "Content-Length: " + std::to_string(len) + "\r\n";
+    head += _responseHeaders;
+    head += "Connection: close\r\n\r\n";
+    head += content.str();
+    _client.write(reinterpret_cast<const uint8_t*>(head.data()), head.size());
+}
+
+void ESP8266WebServer::sendContent(const char* content, size_t len) {
+    _client.write(reinterpret_cast<const uint8_t*>(content), len);
+}
@@ -0,0 +1,11 @@
+#ifndef HOST_STACKTHUNK_H
+#define HOST_STACKTHUNK_H
+
+// The host stack is large enough: a thunk just calls through.
+inline void stack_thunk_add_ref() {}
+inline void stack_thunk_del_ref() {}
+
+#define make_stack_thunk(fn) \
+    extern "C" void thunk_##fn() { fn(); }
+
+#endif // HOST_STACKTHUNK_H
@@ -0,0 +1,142 @@
+#include <LittleFS.h>
+#include <ArduinoJson.h>
+#include "HostShim.h"
+
+#include <vector>
+
+FS LittleFS;
+
+namespace {
+long     g_writeBudget  = -1;  // bytes left before writes fail, -1 = unlimited
+uint64_t g_bytesWritten = 0;
+}
+
+// ── File ─────────────────────────────────────────────────────────────────────
+
+bool File::seek(uint32_t pos, SeekMode mode) {
+    if (!_data) return false;
+    size_t base = (mode == SeekCur) ? _pos : (mode == SeekEnd) ? _data->size() : 0;
+    size_t target = base + pos;
+    if (target > _data->size()) return false;
+    _pos = target;
+    return true;
+}
+
+int File::read() {
+    if (!_data || !_readable || _pos >= _data->size()) return -1;
+    return (uint8_t)(*_data)[_pos++];
+}
+
+int File::peek() {
+    if (!_data || !_readable || _pos >= _data->size()) return -1;
+    return (uint8_t)(*_data)[_pos];
+}
+
+size_t File::read(uint8_t* buf, size_t len) {
+    if (!_data || !_readable || _pos >= _data->size()) return 0;
+    size_t n = std::min(len, _data->size() - _pos);
+    memcpy(buf, _data->data() + _pos, n);
+    _pos += n;
+    return n;
+}
+
+size_t File::write(const uint8_t* buf, size_t len) {
+    if (!_data || !_writable) return 0;
+    if (g_writeBudget >= 0) {
+        if ((long)len > g_writeBudget) len = (size_t)g_writeBudget;
+        g_writeBudget -= (long)len;
+    }
+    if (_append) _pos = _data->size();
+    if (_pos + len > _data->size()) _data->resize(_pos + len);
+    memcpy(&(*_data)[_pos], buf, len);
+    _pos += len;
+    g_bytesWritten += len;
+    return len;
+}
+
+bool File::truncate(uint32_t size) {
+    if (!_data || !_writable || size > _data->size()) return false;
+    _data->resize(size);
+    if (_pos > size) _pos = size;
+    return true;
+}
+
+// ── FS ───────────────────────────────────────────────────────────────────────
+
+bool FS::format() {
+    _files.clear();
+    return true;
+}
+
+File FS::open(const char* path, const char* mode) {
+    const bool plus = mode[1] == '+';
+    auto it = _files.find(path);
+
+    switch (mode[0]) {
+        case 'r':
+            if (it == _files.end()) return File();
+            return File(it->second, true, plus, false);
+        case 'w': {
+            auto data = std::make_shared<std::string>();
+            _files[path] = data;
+            return File(data, plus, true, false);
+        }
+        case 'a': {
+            if (it == _files.end()) it = _files.emplace(path, std::make_shared<std::string>()).first;
+            File f(it->second, plus, true, true);
+            f.seek(0, SeekEnd);
+            return f;
+        }
+        default:
+            return File();
+    }
+}
+
+bool FS::rename(const char* from, const char* to) {
+    auto it = _files.find(from);
+    if (it == _files.end() || _files.count(to)) return false;
+    auto data = it->second;
+    _files.erase(it);
+    _files[to] = data;
+    return true;
+}
+
+// ── ArduinoJson stand-in ─────────────────────────────────────────────────────
+
+namespace ArduinoJsonShim {
+    DeserializationError::Code check(const std::string& text) {
+        size_t i = 0;
+        while (i < text.size() && isspace((unsigned char)text[i])) i++;
+        if (i == text.size()) return DeserializationError::EmptyInput;
+        if (text[i] != '{' && text[i] != '[') return DeserializationError::InvalidInput;
+
+        std::vector<char> open;
+        bool inString = false;
+        for (; i < text.size(); i++) {
+            char c = text[i];
+            if (inString) {
+                if (c == '\\') i++;
+                else if (c == '"') inString = false;
+                continue;
+            }
+            if (c == '"') inString = true;
+            else if (c == '{' || c == '[') open.push_back(c);
+            else if (c == '}' || c == ']') {
+                if (open.empty() || open.back() != (c == '}' ? '{' : '[')) return DeserializationError::InvalidInput;
+                open.pop_back();
+                if (open.empty()) { i++; break; }
+            }
+        }
+        if (inString || !open.empty()) return DeserializationError::IncompleteInput;
+        while (i < text.size() && isspace((unsigned char)text[i])) i++;
+        return i == text.size() ? DeserializationError::Ok : DeserializationError::InvalidInput;
+    }
+}
+
+// ── Controls ─────────────────────────────────────────────────────────────────
+
+namespace HostShim {
+    void eraseFlash() { LittleFS.format(); }
+    void failWritesAfter(long bytes) { g_writeBudget = bytes; }
+    uint64_t flashBytesWritten() { return g_bytesWritten; }
+}
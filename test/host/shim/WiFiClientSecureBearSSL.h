@@ -0,0 +1,6 @@
+#ifndef HOST_WIFICLIENTSECUREBEARSSL_H
+#define HOST_WIFICLIENTSECUREBEARSSL_H
+
+#include <ESP8266WiFi.h>
+
+#endif // HOST_WIFICLIENTSECUREBEARSSL_H
@@ -0,0 +1,346 @@
+#include <bearssl/bearssl_hash.h>
+#include <bearssl/bearssl_hmac.h>
+#include <bearssl/bearssl_ec.h>
+#include "src/auth/P256.h"
+
+#include <openssl/bn.h>
+#include <openssl/ec.h>
+#include <openssl/obj_mac.h>
+
+#include <string.h>
+
+// ── SHA-256 (FIPS 180-4) ─────────────────────────────────────────────────────
+
+const br_hash_class br_sha256_vtable = { sizeof(br_sha256_context) };
+
+namespace {
+const uint32_t K[64] = {
+    0x428a2f98, 0x71374491, 0xb5c0fbcf, 0xe9b5dba5, 0x3956c25b, 0x59f111f1, 0x923f82a4, 0xab1c5ed5,
+    0xd807aa98, 0x12835b01, 0x243185be, 0x550c7dc3, 0x72be5d74, 0x80deb1fe, 0x9bdc06a7, 0xc19bf174,
+    0xe49b69c1, 0xefbe4786, 0x0fc19dc6, 0x240ca1cc, 0x2de92c6f, 0x4a7484aa, 0x5cb0a9dc, 0x76f988da,
+    0x983e5152, 0xa831c66d, 0xb00327c8, 0xbf597fc7, 0xc6e00bf3, 0xd5a79147, 0x06ca6351, 0x14292967,
+    0x27b70a85, 0x2e1b2138, 0x4d2c6dfc, 0x53380d13, 0x650a7354, 0x766a0abb, 0x81c2c92e, 0x92722c85,
+    0xa2bfe8a1, 0xa81a664b, 0xc24b8b70, 0xc76c51a3, 0xd192e819, 0xd6990624, 0xf40e3585, 0x106aa070,
+    0x19a4c116, 0x1e376c08, 0x2748774c, 0x34b0bcb5, 0x391c0cb3, 0x4ed8aa4a, 0x5b9cca4f, 0x682e6ff3,
+    0x748f82ee, 0x78a5636f, 0x84c87814, 0x8cc70208, 0x90befffa, 0xa4506ceb, 0xbef9a3f7, 0xc67178f2,
+};
+
+inline uint32_t rotr(uint32_t x, int n) { return (x >> n) | (x << (32 - n)); }
+
+void compress(uint32_t* h, const uint8_t* block) {
+    uint32_t w[64];
+    for (int i = 0; i < 16; i++) {
+        w[i] = ((uint32_t)block[4 * i] << 24) | ((uint32_t)block[4 * i + 1] << 16) |
+               ((uint32_t)block[4 * i + 2] << 8) | block[4 * i + 3];
+    }
+    for (int i = 16; i < 64; i++) {
+        uint32_t s0 = rotr(w[i - 15], 7) ^ rotr(w[i - 15], 18) ^ (w[i - 15] >> 3);
+        uint32_t s1 = rotr(w[i - 2], 17) ^ rotr(w[i - 2], 19) ^ (w[i - 2] >> 10);
+        w[i] = w[i - 16] + s0 + w[i - 7] + s1;
+    }
+    uint32_t a = h[0], b = h[1], c = h[2], d = h[3], e = h[4], f = h[5], g = h[6], hh = h[7];
+    for (int i = 0; i < 64; i++) {
+        uint32_t t1 = hh + (rotr(e, 6) ^ rotr(e, 11) ^ rotr(e, 25)) + ((e & f) ^ (~e & g)) + K[i] + w[i];
+        uint32_t t2 = (rotr(a, 2) ^ rotr(a, 13) ^ rotr(a, 22)) + ((a & b) ^ (a & c) ^ (b & c));
+        hh = g; g = f; f = e; e = d + t1;
+        d = c; c = b; b = a; a = t1 + t2;
+    }
+    h[0] += a; h[1] += b; h[2] += c; h[3] += d;
+    h[4] += e; h[5] += f; h[6] += g; h[7] += hh;
+}
+} // namespace
+
+void br_sha256_init(br_sha256_context* ctx) {
+    static const uint32_t IV[8] = {
+        0x6a09e667, 0xbb67ae85, 0x3c6ef372, 0xa54ff53a, 0x510e527f, 0x9b05688c, 0x1f83d9ab, 0x5be0cd19,
+    };
+    ctx->vtable = &br_sha256_vtable;
+    memcpy(ctx->val, IV, sizeof(IV));
+    ctx->count = 0;
+}
+
+void br_sha256_update(br_sha256_context* ctx, const void* data, size_t len) {
+    const uint8_t* p = static_cast<const uint8_t*>(data);
+    while (len > 0) {
+        size_t used = (size_t)(ctx->count & 63);
+        size_t take = 64 - used;
+        if (take > len) take = len;
+        memcpy(ctx->buf + used, p, take);
+        ctx->count += take;
+        p   += take;
+        len -= take;
+        if ((ctx->count & 63) == 0) compress(ctx->val, ctx->buf);
+    }
+}
+
+void br_sha256_out(const br_sha256_context* ctx, void* out) {
+    br_sha256_context c = *ctx;
+    uint64_t bits = c.count << 3;
+    static const uint8_t pad = 0x80;
+    static const uint8_t zero[64] = {};
+    br_sha256_update(&c, &pad, 1);
+    size_t used = (size_t)(c.count & 63);
+    br_sha256_update(&c, zero, used <= 56 ? 56 - used : 120 - used);
+    uint8_t len[8];
+    for (int i = 0; i < 8; i++) len[i] = (uint8_t)(bits >> (56 - 8 * i));
+    br_sha256_update(&c, len, 8);
+    uint8_t* o = static_cast<uint8_t*>(out);
+    for (int i = 0; i < 8; i++) {
+        o[4 * i]     = (uint8_t)(c.val[i] >> 24);
+        o[4 * i + 1] = (uint8_t)(c.val[i] >> 16);
+        o[4 * i + 2] = (uint8_t)(c.val[i] >> 8);
+        o[4 * i + 3] = (uint8_t)c.val[i];
+    }
+}
+
+// ── HMAC-SHA-256 (RFC 2104) ──────────────────────────────────────────────────
+
+void br_hmac_key_init(br_hmac_key_context* kc, const br_hash_class* digest_vtable,
+                      const void* key, size_t key_len) {
+    uint8_t k[64] = {};
+    if (key_len > sizeof(k)) {
+        br_sha256_context c;
+        br_sha256_init(&c);
+        br_sha256_update(&c, key, key_len);
+        br_sha256_out(&c, k);
+    } else {
+        memcpy(k, key, key_len);
+    }
+
+    uint8_t pad[64];
+    for (int i = 0; i < 64; i++) pad[i] = k[i] ^ 0x36;
+    br_sha256_init(&kc->ksi);
+    br_sha256_update(&kc->ksi, pad, sizeof(pad));
+    for (int i = 0; i < 64; i++) pad[i] = k[i] ^ 0x5C;
+    br_sha256_init(&kc->kso);
+    br_sha256_update(&kc->kso, pad, sizeof(pad));
+    kc->dig_vtable = digest_vtable;
+}
+
+void br_hmac_init(br_hmac_context* ctx, const br_hmac_key_context* kc, size_t out_len) {
+    ctx->inner   = kc->ksi;
+    ctx->outer   = kc->kso;
+    ctx->out_len = (out_len == 0 || out_len > 32) ? 32 : out_len;
+}
+
+void br_hmac_update(br_hmac_context* ctx, const void* data, size_t len) {
+    br_sha256_update(&ctx->inner, data, len);
+}
+
+size_t br_hmac_out(const br_hmac_context* ctx, void* out) {
+    uint8_t inner[32];
+    uint8_t full[32];
+    br_sha256_out(&ctx->inner, inner);
+    br_sha256_context outer = ctx->outer;
+    br_sha256_update(&outer, inner, sizeof(inner));
+    br_sha256_out(&outer, full);
+    memcpy(out, full, ctx->out_len);
+    return ctx->out_len;
+}
+
+// ── P-256 (see bearssl_ec.h) ─────────────────────────────────────────────────
+
+namespace {
+const uint8_t P256_G[65] = {
+    0x04,
+    0x6B, 0x17, 0xD1, 0xF2, 0xE1, 0x2C, 0x42, 0x47, 0xF8, 0xBC, 0xE6, 0xE5, 0x63, 0xA4, 0x40, 0xF2,
+    0x77, 0x03, 0x7D, 0x81, 0x2D, 0xEB, 0x33, 0xA0, 0xF4, 0xA1, 0x39, 0x45, 0xD8, 0x98, 0xC2, 0x96,
+    0x4F, 0xE3, 0x42, 0xE2, 0xFE, 0x1A, 0x7F, 0x9B, 0x8E, 0xE7, 0xEB, 0x4A, 0x7C, 0x0F, 0x9E, 0x16,
+    0x2B, 0xCE, 0x33, 0x57, 0x6B, 0x31, 0x5E, 0xCE, 0xCB, 0xB6, 0x40, 0x68, 0x37, 0xBF, 0x51, 0xF5,
+};
+const uint8_t P256_N[32] = {
+    0xFF, 0xFF, 0xFF, 0xFF, 0x00, 0x00, 0x00, 0x00, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+    0xBC, 0xE6, 0xFA, 0xAD, 0xA7, 0x17, 0x9E, 0x84, 0xF3, 0xB9, 0xCA, 0xC2, 0xFC, 0x63, 0x25, 0x51,
+};
+
+const unsigned char* api_generator(int, size_t* len) {
+    *len = sizeof(P256_G);
+    return P256_G;
+}
+
+const unsigned char* api_order(int, size_t* len) {
+    *len = sizeof(P256_N);
+    return P256_N;
+}
+
+size_t api_xoff(int, size_t* len) {
+    *len = 32;
+    return 1;
+}
+
+/** p256_mul: 2-bit window over the scalar, precomputed P, 2P, 3P. */
+void windowMul(P256::Jacobian& r, const P256::Affine& p, const unsigned char* x, size_t xlen) {
+    P256::Jacobian w[3];
+    P256::toJacobian(w[0], p);
+    P256::dbl(w[1], w[0]);
+    P256::add(w[2], w[1], w[0]);
+
+    P256::Jacobian acc;
+    memset(&acc, 0, sizeof(acc));
+    for (size_t i = 0; i < xlen; i++) {
+        for (int shift = 6; shift >= 0; shift -= 2) {
+            P256::dbl(acc, acc);
+            P256::dbl(acc, acc);
+            unsigned bits = (x[i] >> shift) & 3;
+            if (bits) P256::add(acc, acc, w[bits - 1]);
+        }
+    }
+    r = acc;
+}
+
+/** p256_mulgen: 4-bit window over a fixed 1..15·G table. */
+void generatorMul(P256::Jacobian& r, const unsigned char* x, size_t xlen) {
+    static P256::Affine window[15];
+    static bool ready = false;
+    if (!ready) {
+        P256::Affine g;
+        P256::decode(g, P256_G, sizeof(P256_G));
+        P256::Jacobian k, base;
+        P256::toJacobian(base, g);
+        k = base;
+        for (int i = 0; i < 15; i++) {
+            P256::toAffine(window[i], k);
+            P256::add(k, k, base);
+        }
+        ready = true;
+    }
+
+    P256::Jacobian acc;
+    memset(&acc, 0, sizeof(acc));
+    for (size_t i = 0; i < xlen; i++) {
+        for (int shift = 4; shift >= 0; shift -= 4) {
+            for (int d = 0; d < 4; d++) P256::dbl(acc, acc);
+            unsigned bits = (x[i] >> shift) & 0x0F;
+            if (bits) P256::addMixed(acc, acc, window[bits - 1]);
+        }
+    }
+    r = acc;
+}
+
+uint32_t api_mul(unsigned char* G, size_t Glen, const unsigned char* x, size_t xlen, int curve) {
+    P256::Affine p;
+    if (curve != BR_EC_secp256r1 || !P256::decode(p, G, Glen)) return 0;
+    P256::Jacobian r;
+    windowMul(r, p, x, xlen);
+    return P256::encode(G, r) ? 1 : 0;
+}
+
+size_t api_mulgen(unsigned char* R, const unsigned char* x, size_t xlen, int) {
+    P256::Jacobian r;
+    generatorMul(r, x, xlen);
+    if (!P256::encode(R, r)) memset(R, 0, P256::POINT_LEN);
+    return P256::POINT_LEN;
+}
+
+uint32_t api_muladd(unsigned char* A, const unsigned char* B, size_t len, const unsigned char* x, size_t xlen,
+                    const unsigned char* y, size_t ylen, int curve) {
+    P256::Affine a, b;
+    if (curve != BR_EC_secp256r1 || !P256::decode(a, A, len)) return 0;
+    if (B && !P256::decode(b, B, len)) return 0;
+
+    // Two independent multiplications, as in ec_p256_m15
+    P256::Jacobian p, q;
+    windowMul(p, a, x, xlen);
+    if (B) {
+        windowMul(q, b, y, ylen);
+    } else {
+        generatorMul(q, y, ylen);
+    }
+    P256::add(p, p, q);
+    return P256::encode(A, p) ? 1 : 0;
+}
+
+struct Bn {
+    BIGNUM* v = BN_new();
+    ~Bn() { BN_free(v); }
+    operator BIGNUM*() const { return v; }
+};
+
+const EC_GROUP* group() {
+    static EC_GROUP* g = EC_GROUP_new_by_curve_name(NID_X9_62_prime256v1);
+    return g;
+}
+} // namespace
+
+const br_ec_impl br_ec_p256_m15 = {
+    (uint32_t)1 << BR_EC_secp256r1,
+    &api_generator,
+    &api_order,
+    &api_xoff,
+    &api_mul,
+    &api_mulgen,
+    &api_muladd,
+};
+
+uint32_t br_ecdsa_i15_vrfy_raw(const br_ec_impl* impl, const void* hash, size_t hash_len,
+                               const br_ec_public_key* pk, const void* sig, size_t sig_len) {
+    if (!pk || pk->curve != BR_EC_secp256r1 || pk->qlen != 65 || hash_len != 32 || sig_len != 64) return 0;
+    const uint8_t* rs = static_cast<const uint8_t*>(sig);
+
+    BN_CTX* ctx = BN_CTX_new();
+    Bn n, r, s, e, w, u1, u2, x;
+    BN_bin2bn(P256_N, sizeof(P256_N), n);
+    BN_bin2bn(rs, 32, r);
+    BN_bin2bn(rs + 32, 32, s);
+    BN_bin2bn(static_cast<const uint8_t*>(hash), 32, e);
+
+    uint32_t res = 0;
+    if (!BN_is_zero(r) && !BN_is_zero(s) && BN_cmp(r, n) < 0 && BN_cmp(s, n) < 0 &&
+        BN_mod_inverse(w, s, n, ctx) && BN_mod_mul(u1, e, w, n, ctx) && BN_mod_mul(u2, r, w, n, ctx)) {
+        // eU = u2·Q + u1·G, then compare its x (mod n) with r
+        uint8_t eU[65], k1[32], k2[32];
+        memcpy(eU, pk->q, sizeof(eU));
+        BN_bn2binpad(u1, k1, sizeof(k1));
+        BN_bn2binpad(u2, k2, sizeof(k2));
+        res = impl->muladd(eU, nullptr, sizeof(eU), k2, sizeof(k2), k1, sizeof(k1), pk->curve);
+        BN_bin2bn(eU + 1, 32, x);
+        BN_nnmod(x, x, n, ctx);
+        if (BN_cmp(x, r) != 0) res = 0;
+    }
+    BN_CTX_free(ctx);
+    return res;
+}
+
+void host_ec_public(const uint8_t d[32], uint8_t q[65]) {
+    Bn k;
+    BN_bin2bn(d, 32, k);
+    EC_POINT* p = EC_POINT_new(group());
+    EC_POINT_mul(group(), p, k, nullptr, nullptr, nullptr);
+    EC_POINT_point2oct(group(), p, POINT_CONVERSION_UNCOMPRESSED, q, 65, nullptr);
+    EC_POINT_free(p);
+}
+
+void host_ecdsa_sign(const uint8_t d[32], const uint8_t hash[32], uint8_t sig[64]) {
+    // Nonce k = SHA-256(d || hash) mod n: repeatable, and distinct per message
+    uint8_t seed[32];
+    br_sha256_context c;
+    br_sha256_init(&c);
+    br_sha256_update(&c, d, 32);
+    br_sha256_update(&c, hash, 32);
+    br_sha256_out(&c, seed);
+
+    BN_CTX* ctx = BN_CTX_new();
+    Bn n, k, priv, e, x, r, s;
+    BN_bin2bn(P256_N, sizeof(P256_N), n);
+    BN_bin2bn(seed, sizeof(seed), k);
+    BN_nnmod(k, k, n, ctx);
+    if (BN_is_zero(k)) BN_one(k);
+    BN_bin2bn(d, 32, priv);
+    BN_bin2bn(hash, 32, e);
+
+    EC_POINT* R = EC_POINT_new(group());
+    EC_POINT_mul(group(), R, k, nullptr, nullptr, ctx);
+    EC_POINT_get_affine_coordinates(group(), R, x, nullptr, ctx);
+    EC_POINT_free(R);
+    BN_nnmod(r, x, n, ctx);
+
+    // s = (e + r·d) / k
+    BN_mod_mul(s, r, priv, n, ctx);
+    BN_mod_add(s, s, e, n, ctx);
+    BN_mod_inverse(k, k, n, ctx);
+    BN_mod_mul(s, s, k, n, ctx);
+
+    BN_bn2binpad(r, sig, 32);
+    BN_bn2binpad(s, sig + 32, 32);
+    BN_CTX_free(ctx);
+}
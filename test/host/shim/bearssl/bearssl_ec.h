@@ -0,0 +1,48 @@
+#ifndef HOST_BEARSSL_EC_H
+#define HOST_BEARSSL_EC_H
+
+// ════════════════════════════════════════════════════════════════════════
+// P-256 for the host build
+//
+// br_ec_p256_m15 follows BearSSL's ec_p256_m15 algorithms — a 2-bit window
+// for mul(), a 4-bit window over a 1..15·G table for mulgen(), and muladd()
+// as two separate multiplications — on top of the firmware's own P256 field
+// code, so timings compare algorithms rather than libraries.  The modular
+// arithmetic of br_ecdsa_i15_vrfy_raw() and the host signer use OpenSSL.
+// ════════════════════════════════════════════════════════════════════════
+
+#include <stdint.h>
+#include <stddef.h>
+
+#define BR_EC_secp256r1 23
+
+typedef struct {
+    int            curve;
+    unsigned char* q;
+    size_t         qlen;
+} br_ec_public_key;
+
+typedef struct {
+    uint32_t supported_curves;
+    const unsigned char* (*generator)(int curve, size_t* len);
+    const unsigned char* (*order)(int curve, size_t* len);
+    size_t (*xoff)(int curve, size_t* len);
+    uint32_t (*mul)(unsigned char* G, size_t Glen, const unsigned char* x, size_t xlen, int curve);
+    size_t (*mulgen)(unsigned char* R, const unsigned char* x, size_t xlen, int curve);
+    uint32_t (*muladd)(unsigned char* A, const unsigned char* B, size_t len,
+                       const unsigned char* x, size_t xlen,
+                       const unsigned char* y, size_t ylen, int curve);
+} br_ec_impl;
+
+extern const br_ec_impl br_ec_p256_m15;
+
+uint32_t br_ecdsa_i15_vrfy_raw(const br_ec_impl* impl, const void* hash, size_t hash_len,
+                               const br_ec_public_key* pk, const void* sig, size_t sig_len);
+
+/** Host only: the uncompressed public point of the private scalar @p d. */
+void host_ec_public(const uint8_t d[32], uint8_t q[65]);
+
+/** Host only: raw r || s ECDSA signature of @p hash under @p d (deterministic nonce). */
+void host_ecdsa_sign(const uint8_t d[32], const uint8_t hash[32], uint8_t sig[64]);
+
+#endif // HOST_BEARSSL_EC_H
@@ -0,0 +1,28 @@
+#ifndef HOST_BEARSSL_HASH_H
+#define HOST_BEARSSL_HASH_H
+
+// SHA-256 with BearSSL's API, implemented in bearssl.cpp.
+
+#include <stdint.h>
+#include <stddef.h>
+
+typedef struct br_hash_class_ {
+    size_t context_size;
+} br_hash_class;
+
+typedef struct {
+    const br_hash_class* vtable;
+    uint8_t  buf[64];
+    uint64_t count;
+    uint32_t val[8];
+} br_sha256_context;
+
+extern const br_hash_class br_sha256_vtable;
+
+void br_sha256_init(br_sha256_context* ctx);
+void br_sha256_update(br_sha256_context* ctx, const void* data, size_t len);
+void br_sha256_out(const br_sha256_context* ctx, void* out);
+
+#define br_sha256_SIZE 32
+
+#endif // HOST_BEARSSL_HASH_H
@@ -0,0 +1,26 @@
+#ifndef HOST_BEARSSL_HMAC_H
+#define HOST_BEARSSL_HMAC_H
+
+// HMAC with BearSSL's API (SHA-256 only), implemented in bearssl.cpp.
+
+#include "bearssl_hash.h"
+
+typedef struct {
+    const br_hash_class* dig_vtable;
+    br_sha256_context    ksi;  // state after the inner padded key
+    br_sha256_context    kso;  // state after the outer padded key
+} br_hmac_key_context;
+
+typedef struct {
+    br_sha256_context inner;
+    br_sha256_context outer;
+    size_t            out_len;
+} br_hmac_context;
+
+void   br_hmac_key_init(br_hmac_key_context* kc, const br_hash_class* digest_vtable,
+                        const void* key, size_t key_len);
+void   br_hmac_init(br_hmac_context* ctx, const br_hmac_key_context* kc, size_t out_len);
+void   br_hmac_update(br_hmac_context* ctx, const void* data, size_t len);
+size_t br_hmac_out(const br_hmac_context* ctx, void* out);
+
+#endif // HOST_BEARSSL_HMAC_H
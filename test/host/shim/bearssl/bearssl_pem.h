@@ -0,0 +1,4 @@
+#ifndef HOST_BEARSSL_PEM_H
+#define HOST_BEARSSL_PEM_H
+
+#endif // HOST_BEARSSL_PEM_H
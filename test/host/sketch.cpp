@@ -0,0 +1,7 @@
+// Builds the real sketch for the host.  The Arduino IDE generates forward
+// declarations for every function in the .ino; plain C++ needs them spelled out.
+#include <Arduino.h>
+
+void setupOTA();
+
+#include "../../AetherPulse.ino"